@@ -1,6 +1,8 @@
 {
     "variables": {
-        "packaging": "<!(echo $PACKAGING)"
+        "packaging": "<!(echo $PACKAGING)",
+        "ecmult_window_size": "<!(echo ${ECMULT_WINDOW_SIZE:-15})",
+        "ecmult_gen_prec_bits": "<!(echo ${ECMULT_GEN_PREC_BITS:-4})"
     },
     "conditions": [
         ["packaging!=1", {
@@ -17,9 +19,11 @@
                         "src/native/sha512.c",
                         "src/native/ripemd160.c",
                         "src/native/keccak.c",
+                        "src/native/crc32.c",
                         "src/native/util.c",
                         "src/native/ed25519/collective.c",
                         "src/native/ed25519/fe.c",
+                        "src/native/ed25519/fe51.c",
                         "src/native/ed25519/ge.c",
                         "src/native/ed25519/keypair.c",
                         "src/native/ed25519/memory.c",
@@ -30,19 +34,27 @@
                         "src/native/secp256k1/precomputed_ecmult.c",
                         "src/native/secp256k1/secp256k1.c",
                         "src/native/secp256k1_native.c",
-                        "src/native/krypton_node.cc"
+                        "src/native/krypton_node.cc",
+                        "src/native/crypto_pool.cc",
+                        "src/native/crypto_batch.cc",
+                        "src/native/crypto_ring.cc",
+                        "src/native/block_body.cc",
+                        "src/native/accounts_tree.cc"
                     ],
                     'conditions': [
                         ["target_arch=='x64'", {"sources": ["src/native/opt.c"]}],
                         ["target_arch!='x64'", {"sources": ["src/native/ref.c"]}],
+                        ["target_arch=='x64' or target_arch=='arm64'", {"defines": ["ED25519_FE51"]}],
                         ["OS=='mac' and target_arch=='arm64'", {"xcode_settings": {"OTHER_CFLAGS": ["-march=armv8.5-a"]} }],
                         ["OS=='mac' and target_arch!='arm64'", {"xcode_settings": {"OTHER_CFLAGS": ["-march=native"]} }],
                     ],
                     "defines": [
-                        "ARGON2_NO_THREADS"
+                        "NAPI_VERSION=8",
+                        "ARGON2_NO_THREADS",
+                        "ECMULT_WINDOW_SIZE=<(ecmult_window_size)",
+                        "ECMULT_GEN_PREC_BITS=<(ecmult_gen_prec_bits)"
                     ],
                     "include_dirs": [
-                        "<!(node -e \"require('nan')\")",
                         "src/native"
                     ],
                     "cflags_c": [
@@ -67,9 +79,11 @@
                         "src/native/sha512.c",
                         "src/native/ripemd160.c",
                         "src/native/keccak.c",
+                        "src/native/crc32.c",
                         "src/native/util.c",
                         "src/native/ed25519/collective.c",
                         "src/native/ed25519/fe.c",
+                        "src/native/ed25519/fe51.c",
                         "src/native/ed25519/ge.c",
                         "src/native/ed25519/keypair.c",
                         "src/native/ed25519/memory.c",
@@ -80,13 +94,21 @@
                         "src/native/secp256k1/precomputed_ecmult.c",
                         "src/native/secp256k1/secp256k1.c",
                         "src/native/secp256k1_native.c",
-                        "src/native/krypton_node.cc"
+                        "src/native/krypton_node.cc",
+                        "src/native/crypto_pool.cc",
+                        "src/native/crypto_batch.cc",
+                        "src/native/crypto_ring.cc",
+                        "src/native/block_body.cc",
+                        "src/native/accounts_tree.cc"
                     ],
                     "defines": [
-                        "ARGON2_NO_THREADS"
+                        "NAPI_VERSION=8",
+                        "ARGON2_NO_THREADS",
+                        "ECMULT_WINDOW_SIZE=<(ecmult_window_size)",
+                        "ECMULT_GEN_PREC_BITS=<(ecmult_gen_prec_bits)",
+                        "ED25519_FE51"
                     ],
                     "include_dirs": [
-                        "<!(node -e \"require('nan')\")",
                         "src/native"
                     ],
                     "cflags_c": [
@@ -112,9 +134,11 @@
                         "src/native/sha512.c",
                         "src/native/ripemd160.c",
                         "src/native/keccak.c",
+                        "src/native/crc32.c",
                         "src/native/util.c",
                         "src/native/ed25519/collective.c",
                         "src/native/ed25519/fe.c",
+                        "src/native/ed25519/fe51.c",
                         "src/native/ed25519/ge.c",
                         "src/native/ed25519/keypair.c",
                         "src/native/ed25519/memory.c",
@@ -125,13 +149,21 @@
                         "src/native/secp256k1/precomputed_ecmult.c",
                         "src/native/secp256k1/secp256k1.c",
                         "src/native/secp256k1_native.c",
-                        "src/native/krypton_node.cc"
+                        "src/native/krypton_node.cc",
+                        "src/native/crypto_pool.cc",
+                        "src/native/crypto_batch.cc",
+                        "src/native/crypto_ring.cc",
+                        "src/native/block_body.cc",
+                        "src/native/accounts_tree.cc"
                     ],
                     "defines": [
-                        "ARGON2_NO_THREADS"
+                        "NAPI_VERSION=8",
+                        "ARGON2_NO_THREADS",
+                        "ECMULT_WINDOW_SIZE=<(ecmult_window_size)",
+                        "ECMULT_GEN_PREC_BITS=<(ecmult_gen_prec_bits)",
+                        "ED25519_FE51"
                     ],
                     "include_dirs": [
-                        "<!(node -e \"require('nan')\")",
                         "src/native"
                     ],
                     "cflags_c": [
@@ -159,9 +191,11 @@
                         "src/native/sha512.c",
                         "src/native/ripemd160.c",
                         "src/native/keccak.c",
+                        "src/native/crc32.c",
                         "src/native/util.c",
                         "src/native/ed25519/collective.c",
                         "src/native/ed25519/fe.c",
+                        "src/native/ed25519/fe51.c",
                         "src/native/ed25519/ge.c",
                         "src/native/ed25519/keypair.c",
                         "src/native/ed25519/memory.c",
@@ -172,13 +206,21 @@
                         "src/native/secp256k1/precomputed_ecmult.c",
                         "src/native/secp256k1/secp256k1.c",
                         "src/native/secp256k1_native.c",
-                        "src/native/krypton_node.cc"
+                        "src/native/krypton_node.cc",
+                        "src/native/crypto_pool.cc",
+                        "src/native/crypto_batch.cc",
+                        "src/native/crypto_ring.cc",
+                        "src/native/block_body.cc",
+                        "src/native/accounts_tree.cc"
                     ],
                     "defines": [
-                        "ARGON2_NO_THREADS"
+                        "NAPI_VERSION=8",
+                        "ARGON2_NO_THREADS",
+                        "ECMULT_WINDOW_SIZE=<(ecmult_window_size)",
+                        "ECMULT_GEN_PREC_BITS=<(ecmult_gen_prec_bits)",
+                        "ED25519_FE51"
                     ],
                     "include_dirs": [
-                        "<!(node -e \"require('nan')\")",
                         "src/native"
                     ],
                     "cflags_c": [
@@ -210,9 +252,11 @@
                         "src/native/sha512.c",
                         "src/native/ripemd160.c",
                         "src/native/keccak.c",
+                        "src/native/crc32.c",
                         "src/native/util.c",
                         "src/native/ed25519/collective.c",
                         "src/native/ed25519/fe.c",
+                        "src/native/ed25519/fe51.c",
                         "src/native/ed25519/ge.c",
                         "src/native/ed25519/keypair.c",
                         "src/native/ed25519/memory.c",
@@ -223,13 +267,21 @@
                         "src/native/secp256k1/precomputed_ecmult.c",
                         "src/native/secp256k1/secp256k1.c",
                         "src/native/secp256k1_native.c",
-                        "src/native/krypton_node.cc"
+                        "src/native/krypton_node.cc",
+                        "src/native/crypto_pool.cc",
+                        "src/native/crypto_batch.cc",
+                        "src/native/crypto_ring.cc",
+                        "src/native/block_body.cc",
+                        "src/native/accounts_tree.cc"
                     ],
                     "defines": [
-                        "ARGON2_NO_THREADS"
+                        "NAPI_VERSION=8",
+                        "ARGON2_NO_THREADS",
+                        "ECMULT_WINDOW_SIZE=<(ecmult_window_size)",
+                        "ECMULT_GEN_PREC_BITS=<(ecmult_gen_prec_bits)",
+                        "ED25519_FE51"
                     ],
                     "include_dirs": [
-                        "<!(node -e \"require('nan')\")",
                         "src/native"
                     ],
                     "cflags_c": [
@@ -263,9 +315,11 @@
                         "src/native/sha512.c",
                         "src/native/ripemd160.c",
                         "src/native/keccak.c",
+                        "src/native/crc32.c",
                         "src/native/util.c",
                         "src/native/ed25519/collective.c",
                         "src/native/ed25519/fe.c",
+                        "src/native/ed25519/fe51.c",
                         "src/native/ed25519/ge.c",
                         "src/native/ed25519/keypair.c",
                         "src/native/ed25519/memory.c",
@@ -276,13 +330,21 @@
                         "src/native/secp256k1/precomputed_ecmult.c",
                         "src/native/secp256k1/secp256k1.c",
                         "src/native/secp256k1_native.c",
-                        "src/native/krypton_node.cc"
+                        "src/native/krypton_node.cc",
+                        "src/native/crypto_pool.cc",
+                        "src/native/crypto_batch.cc",
+                        "src/native/crypto_ring.cc",
+                        "src/native/block_body.cc",
+                        "src/native/accounts_tree.cc"
                     ],
                     "defines": [
-                        "ARGON2_NO_THREADS"
+                        "NAPI_VERSION=8",
+                        "ARGON2_NO_THREADS",
+                        "ECMULT_WINDOW_SIZE=<(ecmult_window_size)",
+                        "ECMULT_GEN_PREC_BITS=<(ecmult_gen_prec_bits)",
+                        "ED25519_FE51"
                     ],
                     "include_dirs": [
-                        "<!(node -e \"require('nan')\")",
                         "src/native"
                     ],
                     "cflags_c": [
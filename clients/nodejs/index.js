@@ -45,6 +45,9 @@ if ((config.protocol === 'wss' && !(config.host && config.port && config.tls &&
         '                             level will enable verbose log output.\n' +
         '  --miner[=THREADS]          Activate mining on this node. The miner will be set\n' +
         '                             up to use THREADS parallel threads.\n' +
+        '  --crypto-threads=THREADS   Number of native threads used for asynchronous crypto\n' +
+        '                             jobs like mining and proof-of-work verification\n' +
+        '                             0 uses one thread per core (default).\n' +
         '  --pool=SERVER:PORT         Mine shares for mining pool with address SERVER:PORT\n' +
         '  --device-data=DATA_JSON    Pass information about this device to the pool. Takes a\n' +
         '                             valid JSON string, the format of which is defined by the\n' +
@@ -122,6 +125,10 @@ for (const tag in config.log.tags) {
     Krypton.Log.instance.setLoggable(tag, config.log.tags[tag]);
 }
 
+if (typeof config.cryptoPool.threads === 'number') {
+    Krypton.NativeCryptoPool.configure(config.cryptoPool.threads);
+}
+
 for (const key in config.constantOverrides) {
     Krypton.ConstantHelper.instance.set(key, config.constantOverrides[key]);
 }
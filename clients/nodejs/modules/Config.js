@@ -3,6 +3,7 @@ const JSON5 = require('json5');
 const merge = require('lodash.merge');
 const Log = require('../../../dist/node.js').Log;
 const TAG = 'Config';
+const MAX_CRYPTO_THREADS = 256;
 
 /**
  * @typedef {object} Config
@@ -17,6 +18,7 @@ const TAG = 'Config';
  * @property {boolean} passive
  * @property {number} statistics
  * @property {{enabled: boolean, threads: string|number, throttleAfter: number, throttleWait: number, extraData: string}} miner
+ * @property {{threads: string|number}} cryptoPool
  * @property {{enabled: boolean, host: string, port: number, mode: string, deviceData: object}} poolMining
  * @property {{enabled: boolean, port: number, corsdomain: string|Array.<string>, allowip: string|Array.<string>, methods: Array.<string>, username: string, password: string}} rpcServer
  * @property {{enabled: boolean, port: number}} uiServer
@@ -49,6 +51,9 @@ const DEFAULT_CONFIG = /** @type {Config} */ {
         throttleWait: 100,
         extraData: ''
     },
+    cryptoPool: {
+        threads: 'auto'
+    },
     poolMining: {
         enabled: false,
         host: null,
@@ -118,6 +123,11 @@ const CONFIG_TYPES = {
             extraData: 'string'
         }
     },
+    cryptoPool: {
+        type: 'object', sub: {
+            threads: {type: 'mixed', types: ['number', {type: 'string', values: ['auto']}]}
+        }
+    },
     poolMining: {
         type: 'object', sub: {
             enabled: 'boolean',
@@ -341,6 +351,9 @@ function readFromArgs(argv, config = merge({}, DEFAULT_CONFIG)) {
         if (typeof argv.miner === 'string') config.miner.threads = parseInt(argv.miner);
         if (typeof argv['extra-data'] === 'string') config.miner.extraData = argv['extra-data'];
     }
+    if (argv['crypto-threads'] !== undefined) {
+        config.cryptoPool.threads = typeof argv['crypto-threads'] === 'string' ? Number(argv['crypto-threads']) : argv['crypto-threads'];
+    }
     if (argv.pool) {
         config.poolMining.enabled = true;
         if (typeof argv.pool === 'string') {
@@ -397,6 +410,11 @@ function readFromArgs(argv, config = merge({}, DEFAULT_CONFIG)) {
     if (!validateObjectType(config)) {
         return false;
     }
+    const cryptoThreads = config.cryptoPool.threads;
+    if (cryptoThreads !== 'auto' && !(Number.isInteger(cryptoThreads) && cryptoThreads >= 0 && cryptoThreads <= MAX_CRYPTO_THREADS)) {
+        Log.e(TAG, `Invalid number of crypto threads: ${cryptoThreads}`);
+        return false;
+    }
 
     return config;
 }
@@ -99,6 +99,7 @@ class MetricsServer {
         await this._mempoolMetrics(res);
         await this._networkMetrics(res);
         this._minerMetrics(res);
+        this._cryptoPoolMetrics(res);
     }
 
     async _chainMetrics(res) {
@@ -240,6 +241,18 @@ class MetricsServer {
         MetricsServer._metric(res, 'miner_blocks_mined', this._desc, this._miner.numBlocksMined);
     }
 
+    _cryptoPoolMetrics(res) {
+        const stats = Krypton.NativeCryptoPool.stats;
+        MetricsServer._metric(res, 'crypto_pool_threads', this._desc, stats.threads);
+        MetricsServer._metric(res, 'crypto_pool_running', this._desc, stats.running);
+        MetricsServer._metric(res, 'crypto_pool_utilization', this._desc, Krypton.NativeCryptoPool.utilization);
+        for (const name of Object.keys(Krypton.NativeCryptoPool.Priority)) {
+            const priority = Krypton.NativeCryptoPool.Priority[name];
+            MetricsServer._metric(res, 'crypto_pool_queue_length', this._with({'priority': name.toLowerCase()}), stats.queued[priority]);
+            MetricsServer._metric(res, 'crypto_pool_jobs', this._with({'priority': name.toLowerCase()}), stats.completed[priority]);
+        }
+    }
+
     /**
      * @param res
      * @param {string} key
@@ -445,6 +445,68 @@ export class CryptoLib {
     public static instance: { getRandomValues(buf: Uint8Array): Uint8Array };
 }
 
+export class NativeCryptoPool {
+    public static Priority: {
+        CONSENSUS: 0;
+        MEMPOOL: 1;
+        MINING: 2;
+    };
+    public static configure(threads: number): boolean;
+    public static stats: { threads: number, running: number, queued: number[], completed: number[], busyTime: number, uptime: number };
+    public static utilization: number;
+    public static computeArgon2d(input: Uint8Array, priority?: NativeCryptoPool.Priority): Promise<Uint8Array>;
+    public static computeBlake2b(input: Uint8Array, priority?: NativeCryptoPool.Priority): Promise<Uint8Array>;
+    public static computeSha256(input: Uint8Array, priority?: NativeCryptoPool.Priority): Promise<Uint8Array>;
+    public static verifySchnorr(signature: Uint8Array, message: Uint8Array, publicKey: Uint8Array, priority?: NativeCryptoPool.Priority): Promise<boolean>;
+    public static verifyEcdsa(signature: Uint8Array, message: Uint8Array, publicKey: Uint8Array, priority?: NativeCryptoPool.Priority): Promise<boolean>;
+}
+
+export namespace NativeCryptoPool {
+    type Priority = Priority.CONSENSUS | Priority.MEMPOOL | Priority.MINING;
+    namespace Priority {
+        type CONSENSUS = 0;
+        type MEMPOOL = 1;
+        type MINING = 2;
+    }
+}
+
+export class NativeCryptoRing {
+    public static Header: {
+        SUBMITTED: 0;
+        COMPLETED: 1;
+        SLEEPING: 2;
+    };
+    public static HEADER_WORDS: 4;
+    public static DEFAULT_SLOTS: 4096;
+    public static DEFAULT_DATA_SIZE: number;
+    public pending: number;
+    constructor(slots?: number, dataSize?: number, priority?: NativeCryptoPool.Priority);
+    public verifySchnorr(signature: Uint8Array, message: Uint8Array, publicKey: Uint8Array): Promise<boolean>;
+    public hash(algorithm: Hash.Algorithm, input: Uint8Array): Promise<Uint8Array>;
+    public close(): void;
+}
+
+export class NativeBlockBodyValidator {
+    public static prevalidate(body: BlockBody, networkId?: number, priority?: NativeCryptoPool.Priority): Promise<boolean>;
+    public static reportSize(count: number): number;
+}
+
+export namespace NativeBlockBodyValidator {
+    type Result = Result.OK | Result.MALFORMED | Result.UNORDERED | Result.INVALID_TRANSACTION;
+    namespace Result {
+        type OK = 0;
+        type MALFORMED = 1;
+        type UNORDERED = 2;
+        type INVALID_TRANSACTION = 3;
+    }
+    type TransactionStatus = TransactionStatus.INVALID | TransactionStatus.VALID | TransactionStatus.UNCHECKED;
+    namespace TransactionStatus {
+        type INVALID = 0;
+        type VALID = 1;
+        type UNCHECKED = 2;
+    }
+}
+
 export class WebRtcFactory {
     public static newPeerConnection(configuration?: RTCConfiguration): RTCPeerConnection;
     public static newSessionDescription(rtcSessionDescriptionInit: any): RTCSessionDescription;
@@ -738,6 +800,41 @@ export class CryptoUtils {
     public static otpKdf(message: Uint8Array, key: Uint8Array, salt: Uint8Array, iterations: number): Promise<Uint8Array>;
 }
 
+export class CryptoJobList {
+    public static Type: {
+        BLAKE2B: 1;
+        ARGON2D: 2;
+        SHA256: 3;
+        SHA512: 4;
+        RIPEMD160: 5;
+        KECCAK256: 6;
+        SCHNORR_VERIFY: 16;
+    };
+    public static JOB_WORDS: 6;
+    public length: number;
+    constructor(input: Uint8Array, capacity?: number);
+    public hash(algorithm: Hash.Algorithm, offset: number, length: number): number;
+    public verifySchnorr(messageOffset: number, messageLength: number, signatureOffset: number, publicKeyOffset: number): number;
+    public run(): void;
+    public execute(priority?: NativeCryptoPool.Priority): Promise<void>;
+    public getHash(index: number): Hash;
+    public isValid(index: number): boolean;
+    public allValid(): boolean;
+}
+
+export namespace CryptoJobList {
+    type Type = Type.BLAKE2B | Type.ARGON2D | Type.SHA256 | Type.SHA512 | Type.RIPEMD160 | Type.KECCAK256 | Type.SCHNORR_VERIFY;
+    namespace Type {
+        type BLAKE2B = 1;
+        type ARGON2D = 2;
+        type SHA256 = 3;
+        type SHA512 = 4;
+        type RIPEMD160 = 5;
+        type KECCAK256 = 6;
+        type SCHNORR_VERIFY = 16;
+    }
+}
+
 export class BufferUtils {
     public static BASE64_ALPHABET: string;
     public static BASE32_ALPHABET: {
@@ -853,6 +950,9 @@ export namespace IWorker {
 
 export class WasmHelper {
     public static doImport(): Promise<void>;
+    public static doImportThreadsBrowser(): Promise<boolean>;
+    public static supportsWasmThreads(): boolean;
+    public static supportsWasmSimd(): boolean;
     public static importWasm(wasm: string, module?: string): Promise<boolean>;
     public static importScript(script: string, module?: string): Promise<boolean>;
     public static fireModuleLoaded(module?: string): void;
@@ -886,6 +986,11 @@ export class CRC32 {
     public static compute(buf: Uint8Array): number;
 }
 
+export class WasmScratch {
+    public static call<T>(outSize: number, inputs: Array<Uint8Array | Uint32Array>, fn: (out: number, ...inputs: number[]) => T): T;
+    public static compute(outSize: number, inputs: Array<Uint8Array | Uint32Array>, fn: (out: number, ...inputs: number[]) => any): Uint8Array;
+}
+
 export class BigNumber {
     constructor(n: number | string | BigNumber, b?: number);
     public CloseEvent(configObject: any): BigNumber;
@@ -1098,8 +1203,10 @@ export class PrivateKey extends Secret {
 export class PublicKey extends Serializable {
     public static SIZE: 65;
     public static COMPRESSED_SIZE: 33;
+    public static DERIVE_BATCH_SIZE: 256;
     public static copy(o: PublicKey): PublicKey;
     public static derive(privateKey: PrivateKey): PublicKey;
+    public static deriveBatch(privateKeys: PrivateKey[]): PublicKey[];
     public static sum(publicKeys: PublicKey[]): PublicKey;
     public static unserialize(buf: SerialBuffer): PublicKey;
     public static fromAny(o: PublicKey | Uint8Array | string): PublicKey;
@@ -1189,6 +1296,7 @@ export class ExtendedPrivateKey extends Serializable {
     constructor(key: PrivateKey, chainCode: Uint8Array);
     public derive(index: number): ExtendedPrivateKey;
     public derivePath(path: string): ExtendedPrivateKey;
+    public deriveAddresses(start: number, count: number): Address[];
     public serialize(buf?: SerialBuffer): SerialBuffer;
     public equals(o: any): boolean;
     public toAddress(): Address;
@@ -1254,6 +1362,17 @@ export class PartialSignature extends Serializable {
     public equals(o: any): boolean;
 }
 
+export class MultiSigSession {
+    public aggregatePublicKey: PublicKey;
+    constructor(privateKey: PrivateKey, publicKey: PublicKey, publicKeys: PublicKey[]);
+    public createCommitment(): Commitment;
+    public aggregateCommitments(commitments: Commitment[]): Commitment;
+    public setCommitment(secret: RandomSecret, aggregateCommitment: Commitment): void;
+    public partiallySign(data: Uint8Array): PartialSignature;
+    public combine(signatures: PartialSignature[]): Signature;
+    public destroy(): void;
+}
+
 export class MnemonicUtils {
     public static ENGLISH_WORDLIST: string[];
     public static DEFAULT_WORDLIST: string[];
@@ -1604,6 +1723,7 @@ export class SynchronousAccountsTreeStore extends AccountsTreeStore {
     public getSync(key: string, expectedToBePresent?: boolean): AccountsTreeNode;
     public putSync(node: AccountsTreeNode): string;
     public removeSync(node: AccountsTreeNode): string;
+    public removeKeySync(key: string): void;
     public getRootNodeSync(): AccountsTreeNode;
 }
 
@@ -4297,6 +4417,7 @@ export class MultiSigWallet extends Wallet {
     // @ts-ignore
     public createTransaction(recipientAddr: Address, value: BigNumber | number | string, validityStartHeight: number): ExtendedTransaction;
     public createCommitment(): CommitmentPair;
+    public createSession(publicKeys: PublicKey[]): MultiSigSession;
     public partiallySignTransaction(transaction: Transaction, publicKeys: PublicKey[], aggregatedCommitment: Commitment, secret: RandomSecret): PartialSignature;
     // @ts-ignore
     public signTransaction(transaction: Transaction, aggregatedPublicKey: PublicKey, aggregatedCommitment: Commitment, signatures: PartialSignature[]): SignatureProof;
@@ -4332,17 +4453,20 @@ export class WalletStoreCodec {
 }
 
 export abstract class MinerWorker {
-    public multiMine(blockHeader: Uint8Array, compact: number, minNonce: number, maxNonce: number): Promise<{ hash: Uint8Array, nonce: number } | boolean>;
+    public multiMine(blockHeader: Uint8Array, compact: number, minNonce: number, maxNonce: number, threads?: number): Promise<{ hash: Uint8Array, nonce: number } | boolean>;
+    public maxThreads(): Promise<number>;
 }
 
 export class MinerWorkerImpl extends IWorker.Stub(MinerWorker) {
     constructor();
     public init(name: string): void;
-    public multiMine(input: Uint8Array, compact: number, minNonce: number, maxNonce: number): Promise<{ hash: Uint8Array, nonce: number } | boolean>;
+    public multiMine(input: Uint8Array, compact: number, minNonce: number, maxNonce: number, threads?: number): Promise<{ hash: Uint8Array, nonce: number } | boolean>;
+    public maxThreads(): Promise<number>;
 }
 
 export class MinerWorkerPool extends IWorker.Pool(MinerWorker) {
     public noncesPerRun: number;
+    public readonly hashesPerRun: number;
     public runsPerCycle: number;
     public cycleWait: number;
     constructor(size?: number);
@@ -16,6 +16,8 @@ const sriToolbox = require("sri-toolbox");
 const env = minimist(process.argv.slice(2));
 
 function sri(filename) {
+    // The SIMD and threaded workers are optional, browsers fall back to worker-wasm.js if they are not deployed.
+    if (!fs.existsSync(filename) && (filename === 'dist/worker-wasm-simd.js' || filename === 'dist/worker-wasm-mt.js')) return '';
     const code = fs.readFileSync(filename);
     return sriToolbox.generate({}, code);
 }
@@ -50,6 +52,9 @@ const sources = {
             './src/main/generic/utils/Observable.js',
             './src/main/generic/network/DataChannel.js',
             './src/main/platform/nodejs/crypto/CryptoLib.js',
+            './src/main/platform/nodejs/crypto/NativeCryptoPool.js',
+            './src/main/platform/nodejs/crypto/NativeCryptoRing.js',
+            './src/main/platform/nodejs/crypto/NativeBlockBodyValidator.js',
             './src/main/platform/nodejs/network/webrtc/WebRtcFactory.js',
             './src/main/platform/nodejs/network/websocket/WebSocketServer.js',
             './src/main/platform/nodejs/network/websocket/WebSocketFactory.js',
@@ -90,6 +95,8 @@ const sources = {
         './src/main/generic/utils/crypto/CryptoWorker.js',
         './src/main/generic/utils/crypto/CryptoWorkerImpl.js',
         './src/main/generic/utils/crypto/CryptoUtils.js',
+        './src/main/generic/utils/crypto/WasmScratch.js',
+        './src/main/generic/utils/crypto/CryptoJobList.js',
         './src/main/generic/utils/crc/CRC8.js',
         './src/main/generic/utils/crc/CRC32.js',
         './src/main/generic/utils/number/BigNumber.js',
@@ -113,6 +120,7 @@ const sources = {
         './src/main/generic/consensus/base/primitive/Commitment.js',
         './src/main/generic/consensus/base/primitive/CommitmentPair.js',
         './src/main/generic/consensus/base/primitive/PartialSignature.js',
+        './src/main/generic/consensus/base/primitive/MultiSigSession.js',
         './src/main/generic/consensus/base/account/Address.js',
         './src/main/generic/consensus/base/account/Bech32.js',
         './src/main/generic/consensus/base/account/Account.js',
@@ -270,6 +278,7 @@ const sources = {
         './src/main/generic/utils/string/StringUtils.js',
         './src/main/generic/consensus/Policy.js',
         './src/main/generic/consensus/base/primitive/Serializable.js',
+        './src/main/generic/utils/crypto/WasmScratch.js',
         './src/main/generic/consensus/base/primitive/Hash.js',
         './src/main/generic/consensus/base/primitive/Secret.js',
         './src/main/generic/consensus/base/primitive/PrivateKey.js',
@@ -282,6 +291,7 @@ const sources = {
         './src/main/generic/consensus/base/primitive/Commitment.js',
         './src/main/generic/consensus/base/primitive/CommitmentPair.js',
         './src/main/generic/consensus/base/primitive/PartialSignature.js',
+        './src/main/generic/consensus/base/primitive/MultiSigSession.js',
         './src/main/generic/consensus/base/account/Address.js',
         './src/main/generic/consensus/base/account/Bech32.js',
         './src/main/generic/consensus/base/account/Account.js',
@@ -465,6 +475,8 @@ gulp.task('run-build-web-babel', function () {
             .pipe(buffer()),
         gulp.src(BROWSER_SOURCES, {base: '.'})
             .pipe(replace('{WORKER_WASM_HASH}', sri('dist/worker-wasm.js')))
+            .pipe(replace('{WORKER_WASM_SIMD_HASH}', sri('dist/worker-wasm-simd.js')))
+            .pipe(replace('{WORKER_WASM_MT_HASH}', sri('dist/worker-wasm-mt.js')))
             .pipe(replace('{WORKER_JS_HASH}', sri('dist/worker-js.js')))
             .pipe(sourcemaps.init({loadMaps: true}))
             .pipe(concat('web.js'))
@@ -479,6 +491,8 @@ gulp.task('run-build-web-babel', function () {
 gulp.task('run-build-web', function () {
     return gulp.src(BROWSER_SOURCES, {base: '.'})
         .pipe(replace('{WORKER_WASM_HASH}', sri('dist/worker-wasm.js')))
+        .pipe(replace('{WORKER_WASM_SIMD_HASH}', sri('dist/worker-wasm-simd.js')))
+        .pipe(replace('{WORKER_WASM_MT_HASH}', sri('dist/worker-wasm-mt.js')))
         .pipe(replace('{WORKER_JS_HASH}', sri('dist/worker-js.js')))
         .pipe(sourcemaps.init({loadMaps: true}))
         .pipe(concat('web.js'))
@@ -498,6 +512,8 @@ const BROWSER_MODULE_SOURCES = [
 gulp.task('run-build-web-module', function () {
     return gulp.src(BROWSER_MODULE_SOURCES, {base: '.'})
         .pipe(replace('{WORKER_WASM_HASH}', sri('dist/worker-wasm.js')))
+        .pipe(replace('{WORKER_WASM_SIMD_HASH}', sri('dist/worker-wasm-simd.js')))
+        .pipe(replace('{WORKER_WASM_MT_HASH}', sri('dist/worker-wasm-mt.js')))
         .pipe(replace('{WORKER_JS_HASH}', sri('dist/worker-js.js')))    
         .pipe(sourcemaps.init({loadMaps: true}))
         .pipe(concat('web.esm.js'))
@@ -538,6 +554,8 @@ gulp.task('run-build-offline-babel', function () {
             .pipe(buffer()),
         gulp.src(OFFLINE_SOURCES, {base: '.'})
             .pipe(replace('{WORKER_WASM_HASH}', sri('dist/worker-wasm.js')))
+            .pipe(replace('{WORKER_WASM_SIMD_HASH}', sri('dist/worker-wasm-simd.js')))
+            .pipe(replace('{WORKER_WASM_MT_HASH}', sri('dist/worker-wasm-mt.js')))
             .pipe(replace('{WORKER_JS_HASH}', sri('dist/worker-js.js')))    
             .pipe(sourcemaps.init({loadMaps: true}))
             .pipe(concat('web-offline.js'))
@@ -552,6 +570,8 @@ gulp.task('run-build-offline-babel', function () {
 gulp.task('run-build-offline', function () {
     return gulp.src(OFFLINE_SOURCES, {base: '.'})
         .pipe(replace('{WORKER_WASM_HASH}', sri('dist/worker-wasm.js')))
+        .pipe(replace('{WORKER_WASM_SIMD_HASH}', sri('dist/worker-wasm-simd.js')))
+        .pipe(replace('{WORKER_WASM_MT_HASH}', sri('dist/worker-wasm-mt.js')))
         .pipe(replace('{WORKER_JS_HASH}', sri('dist/worker-js.js')))    
         .pipe(sourcemaps.init({loadMaps: true}))
         .pipe(concat('web-offline.js'))
@@ -563,6 +583,8 @@ gulp.task('run-build-offline', function () {
 gulp.task('run-build-web-istanbul', function () {
     return gulp.src(BROWSER_SOURCES.map(f => f.indexOf('./src/main') === 0 ? `./.istanbul/${f}` : f), {base: '.'})
         .pipe(replace('{WORKER_WASM_HASH}', sri('dist/worker-wasm.js')))
+        .pipe(replace('{WORKER_WASM_SIMD_HASH}', sri('dist/worker-wasm-simd.js')))
+        .pipe(replace('{WORKER_WASM_MT_HASH}', sri('dist/worker-wasm-mt.js')))
         .pipe(replace('{WORKER_JS_HASH}', sri('dist/worker-js.js')))    
         .pipe(sourcemaps.init({loadMaps: true}))
         .pipe(concat('web-istanbul.js'))
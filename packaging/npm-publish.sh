@@ -1,5 +1,7 @@
 #!/bin/bash
 
+set -e
+
 KRYPTON_VERSION=`grep -m 1 version ../package.json`
 
 cat > npm/package.json <<_EOF_
@@ -40,6 +42,8 @@ $KRYPTON_VERSION
     "worker.js.map",
     "worker-wasm.js",
     "worker-wasm.wasm",
+    "worker-wasm-simd.js",
+    "worker-wasm-simd.wasm",
     "types.d.ts",
     "namespace.d.ts"
   ]
@@ -47,6 +51,14 @@ $KRYPTON_VERSION
 _EOF_
 
 cp ../dist/{namespace.d.ts,krypton.js,krypton.js.map,types.d.ts,VERSION,web-babel.js,web-babel.js.map,web.js,web.js.map,web.esm.js,web.esm.js.map,web-offline.js,web-offline.js.map,worker.js,worker-js.js,worker.js.map,worker-wasm.js,worker-wasm.wasm} npm/
+# The SIMD worker is optional (it needs an Emscripten with SIMD support), browsers fall back to
+# worker-wasm.js if it is not shipped.
+if [ -f ../dist/worker-wasm-simd.js ] && [ -f ../dist/worker-wasm-simd.wasm ]; then
+    cp ../dist/{worker-wasm-simd.js,worker-wasm-simd.wasm} npm/
+else
+    echo "Not shipping the SIMD worker: dist/worker-wasm-simd.{js,wasm} were not built."
+    rm -f npm/{worker-wasm-simd.js,worker-wasm-simd.wasm}
+fi
 cd npm
 
 echo "
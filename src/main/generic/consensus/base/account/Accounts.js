@@ -43,7 +43,7 @@ class Accounts extends Observable {
             for (let i = 0; i < count; i++) {
                 const address = Address.unserialize(buf);
                 const account = Account.unserialize(buf);
-                tree.putSync(address, account);
+                tree.putBatch(address, account);
             }
 
             await this._commitBlockBody(tree, genesisBlock.body, genesisBlock.height, new TransactionCache());
@@ -59,13 +59,14 @@ class PrunedAccount {
     }
 
     /**
-     * @param buf
+     * @param {?SerialBuffer} [buf]
+     * @returns {SerialBuffer}
      */
     serialize(buf) {
         buf = buf || new SerialBuffer(this.serializedSize);
         this._address.serialize(buf);
         this._account.serialize(buf);
-        return this;
+        return buf;
     }
 
     /**
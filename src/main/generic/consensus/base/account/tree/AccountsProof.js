@@ -10,6 +10,11 @@ class AccountsProof {
         this._nodes = nodes;
         /** @type {HashMap.<Hash,AccountsTreeNode>} */
         this._index = null;
+        /**
+         * The bytes the proof was unserialized from, if any.
+         * @type {?Uint8Array}
+         */
+        this._serialized = null;
     }
 
     /**
@@ -17,12 +22,15 @@ class AccountsProof {
      * @returns {AccountsProof}
      */
     static unserialize(buf) {
+        const start = buf.readPos;
         const count = buf.readUint16();
         const nodes = [];
         for (let i = 0; i < count; i++) {
             nodes.push(AccountsTreeNode.unserialize(buf));
         }
-        return new AccountsProof(nodes);
+        const proof = new AccountsProof(nodes);
+        proof._serialized = buf.subarray(start, buf.readPos);
+        return proof;
     }
 
     /**
@@ -51,9 +59,15 @@ class AccountsProof {
      * Assumes nodes to be in post order and hashes nodes to check internal consistency of proof.
      * XXX Abuse this method to index the nodes contained in the proof. This forces callers to explicitly verify()
      * the proof before retrieving accounts.
+     * On Node.js, a received proof is verified natively on the bytes it was unserialized from first. Only
+     * if that fails, the proof is verified in JS, which then decides as before.
      * @returns {boolean}
      */
     verify() {
+        if (PlatformUtils.isNodeJs() && this._serialized && this._verifyNative()) {
+            return true;
+        }
+
         /** @type {Array.<AccountsTreeNode>} */
         const children = [];
         this._index = new HashMap();
@@ -84,6 +98,35 @@ class AccountsProof {
         return children.length === 1 && children[0].prefix === '' && children[0].isBranch();
     }
 
+    /**
+     * @returns {boolean}
+     * @private
+     */
+    _verifyNative() {
+        const hashes = new Uint8Array(this._nodes.length * Hash.getSize(Hash.Algorithm.BLAKE2B));
+        if (!NodeNative.node_accounts_proof_verify(this._serialized, hashes)) {
+            return false;
+        }
+        this._indexVerified(hashes);
+        return true;
+    }
+
+    /**
+     * Indexes the nodes of a proof that was verified natively, given the hashes of its nodes.
+     * In a valid proof, every node but the root is the child of a later node.
+     * @param {Uint8Array} hashes
+     */
+    _indexVerified(hashes) {
+        const hashSize = Hash.getSize(Hash.Algorithm.BLAKE2B);
+        this._index = new HashMap();
+        this._nodes.forEach((node, i) => {
+            node._hash = new Hash(hashes.subarray(i * hashSize, (i + 1) * hashSize));
+            if (i < this._nodes.length - 1) {
+                this._index.put(node._hash, node);
+            }
+        });
+    }
+
     /**
      * @param {Address} address
      * @returns {Account}
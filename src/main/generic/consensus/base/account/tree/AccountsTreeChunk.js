@@ -10,6 +10,11 @@ class AccountsTreeChunk {
         /** @type {Array.<AccountsTreeNode>} */
         this._nodes = nodes;
         this._proof = proof;
+        /**
+         * The bytes the chunk was unserialized from, if any.
+         * @type {?Uint8Array}
+         */
+        this._serialized = null;
     }
 
     /**
@@ -17,13 +22,16 @@ class AccountsTreeChunk {
      * @returns {AccountsTreeChunk}
      */
     static unserialize(buf) {
+        const start = buf.readPos;
         const count = buf.readUint16();
         const nodes = [];
         for (let i = 0; i < count; i++) {
             nodes.push(AccountsTreeNode.unserialize(buf));
         }
         const proof = AccountsProof.unserialize(buf);
-        return new AccountsTreeChunk(nodes, proof);
+        const chunk = new AccountsTreeChunk(nodes, proof);
+        chunk._serialized = buf.subarray(start, buf.readPos);
+        return chunk;
     }
 
     /**
@@ -51,9 +59,15 @@ class AccountsTreeChunk {
     }
 
     /**
+     * On Node.js, a received chunk is verified natively on the bytes it was unserialized from first.
+     * Only if that fails, the chunk is verified in JS, which then decides as before.
      * @returns {boolean}
      */
     verify() {
+        if (PlatformUtils.isNodeJs() && this._serialized && this._verifyNative()) {
+            return true;
+        }
+
         if (!this._proof.verify()) {
             return false;
         }
@@ -69,6 +83,20 @@ class AccountsTreeChunk {
         return true;
     }
 
+    /**
+     * @returns {boolean}
+     * @private
+     */
+    _verifyNative() {
+        const hashes = new Uint8Array(this._proof.length * Hash.getSize(Hash.Algorithm.BLAKE2B));
+        if (!NodeNative.node_accounts_tree_chunk_verify(this._serialized, hashes)) {
+            return false;
+        }
+        // The proof still needs to be indexed, with the hashes it does not hash its nodes again.
+        this._proof._indexVerified(hashes);
+        return true;
+    }
+
     /**
      * @returns {string}
      */
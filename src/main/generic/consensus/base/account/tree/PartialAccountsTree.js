@@ -151,6 +151,15 @@ class PartialAccountsTree extends SynchronousAccountsTree {
     _putLight(nodes) {
         Assert.that(nodes.every(node => node.isTerminal()), 'Can only build tree from terminal nodes');
 
+        // On Node.js, the whole chunk is inserted and hashed in one batch of the native accounts tree.
+        if (PlatformUtils.isNodeJs()) {
+            for (const node of nodes) {
+                this.putBatch(Address.fromHex(node.prefix), node.account);
+            }
+            this.finalizeBatch();
+            return;
+        }
+
         // Fetch the root node.
         let rootNode = this._store.getRootNodeSync();
         Assert.that(!!rootNode, 'Corrupted store: Failed to fetch AccountsTree root node');
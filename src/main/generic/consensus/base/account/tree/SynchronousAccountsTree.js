@@ -8,6 +8,12 @@ class SynchronousAccountsTree extends AccountsTree {
         super(store);
         /** @type {SynchronousAccountsTreeStore} */
         this._syncStore = store;
+        /**
+         * On Node.js, the accounts put since the last finalizeBatch() by address hex. They are
+         * applied to the tree natively in a single step when the batch is finalized.
+         * @type {Map.<string, {address: Address, account: Account}>}
+         */
+        this._pendingAccounts = new Map();
     }
 
     /**
@@ -94,6 +100,10 @@ class SynchronousAccountsTree extends AccountsTree {
     }
 
     finalizeBatch() {
+        if (PlatformUtils.isNodeJs()) {
+            this._finalizeBatchNative();
+            return;
+        }
         const rootNode = this._syncStore.getRootNodeSync();
         this._updateHashes(rootNode);
     }
@@ -103,6 +113,11 @@ class SynchronousAccountsTree extends AccountsTree {
      * @param {Account} account
      */
     putBatch(address, account) {
+        if (PlatformUtils.isNodeJs()) {
+            this._pendingAccounts.set(address.toHex(), { address, account });
+            return;
+        }
+
         if (account.isInitial() && !this.getSync(address, false)) {
             return;
         }
@@ -269,12 +284,71 @@ class SynchronousAccountsTree extends AccountsTree {
         return newNode.hash();
     }
 
+    /**
+     * Applies the pending accounts in the native accounts tree (see src/native/accounts_tree.h),
+     * which loads the branch nodes on their paths from the store, and writes back the changed
+     * nodes together with their hashes.
+     * @private
+     */
+    _finalizeBatchNative() {
+        if (this._pendingAccounts.size === 0) return;
+
+        let size = 0;
+        for (const { address, account } of this._pendingAccounts.values()) {
+            size += address.serializedSize + /*length*/ 2 + (account.isInitial() ? 0 : account.serializedSize);
+        }
+        const updates = new SerialBuffer(size);
+        for (const { address, account } of this._pendingAccounts.values()) {
+            address.serialize(updates);
+            // An empty account removes the address, like putting Account.INITIAL does.
+            if (account.isInitial()) {
+                updates.writeUint16(0);
+            } else {
+                updates.writeUint16(account.serializedSize);
+                account.serialize(updates);
+            }
+        }
+
+        const root = new Uint8Array(Hash.getSize(Hash.Algorithm.BLAKE2B));
+        const { puts, removals } = NodeNative.node_accounts_tree_update(prefix => {
+            const node = this._syncStore.getSync(prefix);
+            return node && node.serialize();
+        }, updates, root);
+
+        const removed = new SerialBuffer(removals);
+        while (removed.readPos < removed.byteLength) {
+            this._syncStore.removeKeySync(removed.readVarLengthString());
+        }
+        const changed = new SerialBuffer(puts);
+        while (changed.readPos < changed.byteLength) {
+            const hash = Hash.unserialize(changed);
+            let node;
+            if (changed[changed.readPos] === AccountsTreeNode.TERMINAL) {
+                // Terminal nodes hold the pending accounts, they do not need to be unserialized.
+                changed.readUint8();
+                const prefix = changed.readVarLengthString();
+                const { account } = this._pendingAccounts.get(prefix);
+                changed.readPos += account.serializedSize;
+                node = AccountsTreeNode.terminalNode(prefix, account);
+            } else {
+                node = AccountsTreeNode.unserialize(changed);
+            }
+            node._hash = hash;
+            this._syncStore.putSync(node);
+        }
+        this._pendingAccounts.clear();
+    }
+
     /**
      * @param {Address} address
      * @param {boolean} [expectedToBePresent]
      * @returns {?Account}
      */
     getSync(address, expectedToBePresent = true) {
+        if (this._pendingAccounts.size > 0) {
+            const pending = this._pendingAccounts.get(address.toHex());
+            if (pending) return pending.account.isInitial() ? null : pending.account;
+        }
         const node = this._syncStore.getSync(address.toHex(), expectedToBePresent);
         return node !== undefined ? node.account : null;
     }
@@ -43,6 +43,13 @@ class SynchronousAccountsTreeStore extends AccountsTreeStore {
         return key;
     }
 
+    /**
+     * @param {string} key
+     */
+    removeKeySync(key) {
+        this._syncStore.removeSync(key);
+    }
+
     /**
      * @returns {AccountsTreeNode}
      */
@@ -67,7 +67,10 @@ class Block {
      */
     async verify(time) {
         if (this._valid === undefined) {
-            if (this.isLight() || this.body.transactions.length < 150 || !IWorker.areWorkersAsync) {
+            if (this.isFull() && PlatformUtils.isNodeJs()) {
+                // Hash and verify the transactions natively first, _verify() reuses the results.
+                this._valid = await NativeBlockBodyValidator.prevalidate(this._body) && await this._verify(time.now());
+            } else if (this.isLight() || this.body.transactions.length < 150 || !IWorker.areWorkersAsync) {
                 // worker overhead doesn't pay off for small transaction numbers
                 this._valid = await this._verify(time.now());
             } else {
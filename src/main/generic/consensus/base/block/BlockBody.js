@@ -32,6 +32,11 @@ class BlockBody {
         this._prunedAccounts = prunedAccounts;
         /** @type {Hash} */
         this._hash = null;
+        /**
+         * The bytes the body was unserialized from, if any.
+         * @type {?Uint8Array}
+         */
+        this._serialized = null;
     }
 
     /**
@@ -39,6 +44,7 @@ class BlockBody {
      * @return {BlockBody}
      */
     static unserialize(buf) {
+        const start = buf.readPos;
         const minerAddr = Address.unserialize(buf);
         const extraDataLength = buf.readUint8();
         const extraData = buf.read(extraDataLength);
@@ -52,7 +58,9 @@ class BlockBody {
         for (let i = 0; i < numPrunedAccounts; i++) {
             prunedAccounts.push(PrunedAccount.unserialize(buf));
         }
-        return new BlockBody(minerAddr, transactions, extraData, prunedAccounts);
+        const body = new BlockBody(minerAddr, transactions, extraData, prunedAccounts);
+        body._serialized = buf.subarray(start, buf.readPos);
+        return body;
     }
 
     /**
@@ -40,6 +40,21 @@ class ExtendedPrivateKey extends Serializable {
         return new ExtendedPrivateKey(new PrivateKey(hash.slice(0, 32)), hash.slice(32));
     }
 
+    /**
+     * Derives the addresses of count consecutive child keys starting at index start, e.g. to
+     * discover the used accounts of a wallet. The public keys are derived in batches.
+     * @param {number} start
+     * @param {number} count
+     * @return {Array.<Address>}
+     */
+    deriveAddresses(start, count) {
+        const privateKeys = [];
+        for (let i = 0; i < count; i++) {
+            privateKeys.push(this.derive(start + i).privateKey);
+        }
+        return PublicKey.deriveBatch(privateKeys).map(publicKey => publicKey.toAddress());
+    }
+
     /**
      * @param {string} path
      * @return {boolean}
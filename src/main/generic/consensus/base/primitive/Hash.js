@@ -248,28 +248,19 @@ class Hash extends Serializable {
     static computeBlake2b(input) {
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(Hash.getSize(Hash.Algorithm.BLAKE2B));
-            NodeNative.node_blake2(out, new Uint8Array(input));
+            NodeNative.node_blake2(out, input);
             return out;
         } else {
-            let stackPtr;
             try {
-                stackPtr = Module.stackSave();
-                const hashSize = Hash.getSize(Hash.Algorithm.BLAKE2B);
-                const wasmOut = Module.stackAlloc(hashSize);
-                const wasmIn = Module.stackAlloc(input.length);
-                new Uint8Array(Module.HEAPU8.buffer, wasmIn, input.length).set(input);
-                const res = Module._krypton_blake2(wasmOut, wasmIn, input.length);
-                if (res !== 0) {
-                    throw res;
-                }
-                const hash = new Uint8Array(hashSize);
-                hash.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, hashSize));
-                return hash;
+                return WasmScratch.compute(Hash.getSize(Hash.Algorithm.BLAKE2B), [input], (wasmOut, wasmIn) => {
+                    const res = Module._krypton_blake2(wasmOut, wasmIn, input.length);
+                    if (res !== 0) {
+                        throw res;
+                    }
+                });
             } catch (e) {
                 Log.w(Hash, e);
                 throw e;
-            } finally {
-                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
             }
         }
     }
@@ -281,25 +272,16 @@ class Hash extends Serializable {
     static computeSha256(input) {
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(Hash.getSize(Hash.Algorithm.SHA256));
-            NodeNative.node_sha256(out, new Uint8Array(input));
+            NodeNative.node_sha256(out, input);
             return out;
         } else {
-            let stackPtr;
             try {
-                stackPtr = Module.stackSave();
-                const hashSize = Hash.getSize(Hash.Algorithm.SHA256);
-                const wasmOut = Module.stackAlloc(hashSize);
-                const wasmIn = Module.stackAlloc(input.length);
-                new Uint8Array(Module.HEAPU8.buffer, wasmIn, input.length).set(input);
-                Module._krypton_sha256(wasmOut, wasmIn, input.length);
-                const hash = new Uint8Array(hashSize);
-                hash.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, hashSize));
-                return hash;
+                return WasmScratch.compute(Hash.getSize(Hash.Algorithm.SHA256), [input], (wasmOut, wasmIn) => {
+                    Module._krypton_sha256(wasmOut, wasmIn, input.length);
+                });
             } catch (e) {
                 Log.w(Hash, e);
                 throw e;
-            } finally {
-                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
             }
         }
     }
@@ -311,25 +293,16 @@ class Hash extends Serializable {
     static computeSha512(input) {
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(Hash.getSize(Hash.Algorithm.SHA512));
-            NodeNative.node_sha512(out, new Uint8Array(input));
+            NodeNative.node_sha512(out, input);
             return out;
         } else {
-            let stackPtr;
             try {
-                stackPtr = Module.stackSave();
-                const hashSize = Hash.getSize(Hash.Algorithm.SHA512);
-                const wasmOut = Module.stackAlloc(hashSize);
-                const wasmIn = Module.stackAlloc(input.length);
-                new Uint8Array(Module.HEAPU8.buffer, wasmIn, input.length).set(input);
-                Module._krypton_sha512(wasmOut, wasmIn, input.length);
-                const hash = new Uint8Array(hashSize);
-                hash.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, hashSize));
-                return hash;
+                return WasmScratch.compute(Hash.getSize(Hash.Algorithm.SHA512), [input], (wasmOut, wasmIn) => {
+                    Module._krypton_sha512(wasmOut, wasmIn, input.length);
+                });
             } catch (e) {
                 Log.w(Hash, e);
                 throw e;
-            } finally {
-                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
             }
         }
     }
@@ -341,25 +314,16 @@ class Hash extends Serializable {
     static computeRipemd160(input) {
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(Hash.getSize(Hash.Algorithm.RIPEMD160));
-            NodeNative.node_ripemd160(out, new Uint8Array(input));
+            NodeNative.node_ripemd160(out, input);
             return out;
         } else {
-            let stackPtr;
             try {
-                stackPtr = Module.stackSave();
-                const hashSize = Hash.getSize(Hash.Algorithm.RIPEMD160);
-                const wasmOut = Module.stackAlloc(hashSize);
-                const wasmIn = Module.stackAlloc(input.length);
-                new Uint8Array(Module.HEAPU8.buffer, wasmIn, input.length).set(input);
-                Module._ripemd160(wasmIn, input.length, wasmOut);
-                const hash = new Uint8Array(hashSize);
-                hash.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, hashSize));
-                return hash;
+                return WasmScratch.compute(Hash.getSize(Hash.Algorithm.RIPEMD160), [input], (wasmOut, wasmIn) => {
+                    Module._ripemd160(wasmIn, input.length, wasmOut);
+                });
             } catch (e) {
                 Log.w(Hash, e);
                 throw e;
-            } finally {
-                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
             }
         }
     }
@@ -371,25 +335,16 @@ class Hash extends Serializable {
     static computeKeccak256(input) {
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(Hash.getSize(Hash.Algorithm.KECCAK256));
-            NodeNative.node_keccak256(out, new Uint8Array(input));
+            NodeNative.node_keccak256(out, input);
             return out;
         } else {
-            let stackPtr;
             try {
-                stackPtr = Module.stackSave();
-                const hashSize = Hash.getSize(Hash.Algorithm.KECCAK256);
-                const wasmOut = Module.stackAlloc(hashSize);
-                const wasmIn = Module.stackAlloc(input.length);
-                new Uint8Array(Module.HEAPU8.buffer, wasmIn, input.length).set(input);
-                Module._keccak256(wasmIn, input.length, wasmOut);
-                const hash = new Uint8Array(hashSize);
-                hash.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, hashSize));
-                return hash;
+                return WasmScratch.compute(Hash.getSize(Hash.Algorithm.KECCAK256), [input], (wasmOut, wasmIn) => {
+                    Module._keccak256(wasmIn, input.length, wasmOut);
+                });
             } catch (e) {
                 Log.w(Hash, e);
                 throw e;
-            } finally {
-                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
             }
         }
     }
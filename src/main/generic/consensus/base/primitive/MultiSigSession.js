@@ -0,0 +1,290 @@
+class MultiSigSession {
+    /**
+     * A signing session of one cosigner for a fixed set of cosigners. The public keys hash,
+     * the aggregate public key and the delinearized private key are computed once in native
+     * code and reused for every commitment, partial signature and combined signature created
+     * through the session. Call destroy() to wipe the key material when done; on Node.js the
+     * session is also wiped when it is garbage collected.
+     *
+     * @param {PrivateKey} privateKey
+     * @param {PublicKey} publicKey
+     * @param {Array.<PublicKey>} publicKeys The public keys of all cosigners, in signing order.
+     */
+    constructor(privateKey, publicKey, publicKeys) {
+        if (!(privateKey instanceof PrivateKey)) throw new Error('Primitive: Invalid type');
+        if (!(publicKey instanceof PublicKey)) throw new Error('Primitive: Invalid type');
+        if (!Array.isArray(publicKeys) || publicKeys.length === 0) throw new Error('publicKeys may not be empty');
+
+        const compressedPublicKeys = publicKeys.map(k => k.compress());
+        const concatenatedPublicKeys = new Uint8Array(compressedPublicKeys.length * PublicKey.COMPRESSED_SIZE);
+        for (let i = 0; i < compressedPublicKeys.length; ++i) {
+            concatenatedPublicKeys.set(compressedPublicKeys[i], i * PublicKey.COMPRESSED_SIZE);
+        }
+        /** @type {Secp256k1MultiSigSession|number} */
+        this._session = MultiSigSession._sessionInit(concatenatedPublicKeys, publicKeys.length, publicKey.compress(), privateKey._obj);
+    }
+
+    /**
+     * @type {PublicKey}
+     */
+    get aggregatePublicKey() {
+        if (!this._aggregatePublicKey) {
+            const session = this._checkSession();
+            let out;
+            if (PlatformUtils.isNodeJs()) {
+                out = new Uint8Array(PublicKey.SIZE);
+                session.aggregatePublicKey(out);
+            } else {
+                out = MultiSigSession._wasmCall(PublicKey.SIZE, [],
+                    (wasmOut) => Module._secp256k1_multisig_session_aggregate_pubkey(session, wasmOut, PublicKey.SIZE));
+            }
+            this._aggregatePublicKey = new PublicKey(out);
+        }
+        return this._aggregatePublicKey;
+    }
+
+    /**
+     * Generates the commitment for the next signature. The secret never leaves the session,
+     * it is consumed by the next call to partiallySign().
+     * @return {Commitment}
+     */
+    createCommitment() {
+        const randomness = new Uint8Array(CommitmentPair.RANDOMNESS_SIZE);
+        CryptoWorker.lib.getRandomValues(randomness);
+        return new Commitment(MultiSigSession._sessionCreateCommitment(this._checkSession(), randomness));
+    }
+
+    /**
+     * Aggregates the commitments of all cosigners and loads the result into the session.
+     * @param {Array.<Commitment>} commitments
+     * @return {Commitment}
+     */
+    aggregateCommitments(commitments) {
+        const session = this._checkSession();
+        const concatenatedCommitments = new Uint8Array(commitments.length * Commitment.SIZE);
+        for (let i = 0; i < commitments.length; ++i) {
+            concatenatedCommitments.set(commitments[i].serialize(), i * Commitment.SIZE);
+        }
+        let out, res;
+        if (PlatformUtils.isNodeJs()) {
+            out = new Uint8Array(Commitment.SIZE);
+            res = session.aggregateCommitments(out, concatenatedCommitments, commitments.length);
+        } else {
+            out = MultiSigSession._wasmCall(Commitment.SIZE, [concatenatedCommitments],
+                (wasmOut, wasmIn) => res = Module._secp256k1_multisig_session_aggregate_commitments(session, wasmOut, wasmIn, commitments.length, Commitment.SIZE));
+        }
+        if (res !== 1) throw new Error('Invalid commitments');
+        return new Commitment(out);
+    }
+
+    /**
+     * Loads a commitment secret created outside of this session (e.g. by CommitmentPair.generate())
+     * together with the aggregate commitment of all cosigners.
+     * @param {RandomSecret} secret
+     * @param {Commitment} aggregateCommitment
+     */
+    setCommitment(secret, aggregateCommitment) {
+        const session = this._checkSession();
+        const secretBytes = secret.serialize();
+        const commitmentBytes = aggregateCommitment.serialize();
+        let res;
+        if (PlatformUtils.isNodeJs()) {
+            res = session.setCommitment(secretBytes, commitmentBytes);
+        } else {
+            MultiSigSession._wasmCall(0, [secretBytes, commitmentBytes],
+                (wasmOut, wasmSecret, wasmCommitment) => res = Module._secp256k1_multisig_session_set_commitment(session, wasmSecret, wasmCommitment, commitmentBytes.length));
+        }
+        if (res !== 1) throw new Error('Invalid commitment');
+    }
+
+    /**
+     * Creates this cosigner's partial signature using the current commitment. The commitment
+     * secret is wiped afterwards, a new commitment is required for the next signature.
+     * @param {Uint8Array} data
+     * @return {PartialSignature}
+     */
+    partiallySign(data) {
+        const session = this._checkSession();
+        let out, res;
+        if (PlatformUtils.isNodeJs()) {
+            out = new Uint8Array(PartialSignature.SIZE);
+            res = session.partialSign(out, data);
+        } else {
+            out = MultiSigSession._wasmCall(PartialSignature.SIZE, [data],
+                (wasmOut, wasmIn) => res = Module._secp256k1_multisig_session_partial_sign(session, wasmOut, wasmIn, data.length));
+        }
+        if (res !== 1) throw new Error('No commitment set');
+        return new PartialSignature(out);
+    }
+
+    /**
+     * @param {Array.<PartialSignature>} signatures
+     * @return {Signature}
+     */
+    combine(signatures) {
+        const session = this._checkSession();
+        const concatenatedSignatures = new Uint8Array(signatures.length * PartialSignature.SIZE);
+        for (let i = 0; i < signatures.length; ++i) {
+            concatenatedSignatures.set(signatures[i].serialize(), i * PartialSignature.SIZE);
+        }
+        let out, res;
+        if (PlatformUtils.isNodeJs()) {
+            out = new Uint8Array(Signature.SIZE);
+            res = session.combine(out, concatenatedSignatures, signatures.length);
+        } else {
+            out = MultiSigSession._wasmCall(Signature.SIZE, [concatenatedSignatures],
+                (wasmOut, wasmIn) => res = Module._secp256k1_multisig_session_combine(session, wasmOut, wasmIn, signatures.length));
+        }
+        if (res !== 1) throw new Error('Invalid partial signatures');
+        return new Signature(out);
+    }
+
+    /**
+     * Wipes the cached key material and releases the native session.
+     */
+    destroy() {
+        if (this._session === null) return;
+        if (PlatformUtils.isNodeJs()) {
+            this._session.destroy();
+        } else {
+            Module._secp256k1_multisig_session_clear(this._session);
+            Module._free(this._session);
+        }
+        this._session = null;
+    }
+
+    /**
+     * @returns {Secp256k1MultiSigSession|number}
+     * @private
+     */
+    _checkSession() {
+        if (this._session === null) throw new Error('Session destroyed');
+        return this._session;
+    }
+
+    /**
+     * Copies `inputs` onto the wasm stack, calls `fn(outPtr, ...inPtrs)` and returns a copy of
+     * the `outSize` bytes written to outPtr.
+     * @param {number} outSize
+     * @param {Array.<Uint8Array>} inputs
+     * @param {function(...number)} fn
+     * @returns {Uint8Array}
+     * @private
+     */
+    static _wasmCall(outSize, inputs, fn) {
+        let stackPtr;
+        try {
+            stackPtr = Module.stackSave();
+            const wasmOut = Module.stackAlloc(outSize);
+            const wasmIn = inputs.map(input => {
+                const ptr = Module.stackAlloc(input.length);
+                new Uint8Array(Module.HEAPU8.buffer, ptr, input.length).set(input);
+                return ptr;
+            });
+            fn(wasmOut, ...wasmIn);
+            const out = new Uint8Array(outSize);
+            out.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, outSize));
+            return out;
+        } catch (e) {
+            Log.w(MultiSigSession, e);
+            throw e;
+        } finally {
+            if (stackPtr !== undefined) Module.stackRestore(stackPtr);
+        }
+    }
+
+    /**
+     * @param {Uint8Array} publicKeys
+     * @param {number} numCosigners
+     * @param {Uint8Array} publicKey
+     * @param {Uint8Array} privateKey
+     * @returns {Secp256k1MultiSigSession|number} A native handle on Node.js, which wipes the session
+     *     when it is garbage collected, a pointer into the wasm heap otherwise.
+     * @private
+     */
+    static _sessionInit(publicKeys, numCosigners, publicKey, privateKey) {
+        if (publicKeys.byteLength !== numCosigners * PublicKey.COMPRESSED_SIZE
+            || publicKey.byteLength !== PublicKey.COMPRESSED_SIZE
+            || privateKey.byteLength !== PrivateKey.SIZE) {
+            throw Error('Wrong buffer size.');
+        }
+        if (PlatformUtils.isNodeJs()) {
+            // Throws for invalid keys.
+            return new NodeNative.Secp256k1MultiSigSession(publicKeys, numCosigners, publicKey, privateKey);
+        } else {
+            let stackPtr;
+            const session = Module._malloc(Module._secp256k1_multisig_session_size());
+            try {
+                stackPtr = Module.stackSave();
+                const wasmInPublicKeys = Module.stackAlloc(publicKeys.length);
+                const wasmInPublicKey = Module.stackAlloc(publicKey.length);
+                const wasmInPrivateKey = Module.stackAlloc(privateKey.length);
+                new Uint8Array(Module.HEAPU8.buffer, wasmInPublicKeys, publicKeys.length).set(publicKeys);
+                new Uint8Array(Module.HEAPU8.buffer, wasmInPublicKey, publicKey.length).set(publicKey);
+                const privKeyBuffer = new Uint8Array(Module.HEAPU8.buffer, wasmInPrivateKey, privateKey.length);
+                privKeyBuffer.set(privateKey);
+                const res = Module._secp256k1_multisig_session_init(session, wasmInPublicKeys, numCosigners, wasmInPublicKey, wasmInPrivateKey);
+                privKeyBuffer.fill(0);
+                if (res !== 1) throw new Error('Invalid multisig session keys');
+                return session;
+            } catch (e) {
+                Module._free(session);
+                Log.w(MultiSigSession, e);
+                throw e;
+            } finally {
+                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
+            }
+        }
+    }
+
+    /**
+     * @param {Secp256k1MultiSigSession|number} session
+     * @param {Uint8Array} randomness
+     * @returns {Uint8Array} The commitment
+     * @private
+     */
+    static _sessionCreateCommitment(session, randomness) {
+        const randomize = new Uint8Array(32);
+        CryptoWorker.lib.getRandomValues(randomize);
+        if (PlatformUtils.isNodeJs()) {
+            NodeNative.node_secp256k1_ctx_init(randomize);
+            const commitment = new Uint8Array(Commitment.SIZE);
+            let res;
+            try {
+                res = session.createCommitment(commitment, randomness);
+            } finally {
+                NodeNative.node_secp256k1_ctx_release();
+            }
+            if (res !== 1) throw new Error(`Secret must not be 0 or 1: ${res}`);
+            return commitment;
+        } else {
+            let stackPtr;
+            try {
+                stackPtr = Module.stackSave();
+                const rdm = Module.stackAlloc(32);
+                new Uint8Array(Module.HEAP8.buffer, rdm, 32).set(randomize);
+                Module._secp256k1_ctx_init(rdm);
+
+                const wasmOutCommitment = Module.stackAlloc(Commitment.SIZE);
+                const wasmIn = Module.stackAlloc(randomness.length);
+                new Uint8Array(Module.HEAPU8.buffer, wasmIn, randomness.length).set(randomness);
+                // No secret output, the session keeps it.
+                const res = Module._secp256k1_multisig_session_create_commitment(session, 0, wasmOutCommitment, Commitment.SIZE, wasmIn);
+                if (res !== 1) {
+                    throw new Error(`Secret must not be 0 or 1: ${res}`);
+                }
+                const commitment = new Uint8Array(Commitment.SIZE);
+                commitment.set(new Uint8Array(Module.HEAPU8.buffer, wasmOutCommitment, Commitment.SIZE));
+                return commitment;
+            } catch (e) {
+                Log.w(MultiSigSession, e);
+                throw e;
+            } finally {
+                Module._secp256k1_ctx_release();
+                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
+            }
+        }
+    }
+}
+
+Class.register(MultiSigSession);
@@ -82,7 +82,7 @@ class PartialSignature extends Serializable {
         if (PlatformUtils.isNodeJs()) {
             NodeNative.node_secp256k1_ctx_init(randomize);
             const out = new Uint8Array(PartialSignature.SIZE);
-            NodeNative.node_secp256k1_partial_sign(out, new Uint8Array(message), new Uint8Array(aggregateCommitment), new Uint8Array(secret), new Uint8Array(concatenatedPublicKeys), publicKeys.length, new Uint8Array(publicKey), new Uint8Array(privateKey));
+            NodeNative.node_secp256k1_partial_sign(out, message, aggregateCommitment, secret, concatenatedPublicKeys, publicKeys.length, publicKey, privateKey);
             NodeNative.node_secp256k1_ctx_release();
             return out;
         } else {
@@ -72,7 +72,7 @@ class PrivateKey extends Secret {
         }
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(PublicKey.SIZE);
-            NodeNative.node_secp256k1_derive_delinearized_seckey(out, new Uint8Array(publicKeysHash), new Uint8Array(publicKey), new Uint8Array(privateKey));
+            NodeNative.node_secp256k1_derive_delinearized_seckey(out, publicKeysHash, publicKey, privateKey);
             return out;
         } else {
             let stackPtr;
@@ -27,6 +27,24 @@ class PublicKey extends Serializable {
         return new PublicKey(PublicKey._publicKeyDerive(privateKey._obj));
     }
 
+    /**
+     * Derives the public keys of many private keys in one native call.
+     * @param {Array.<PrivateKey>} privateKeys
+     * @return {Array.<PublicKey>}
+     */
+    static deriveBatch(privateKeys) {
+        const publicKeys = [];
+        // In chunks, the wasm build passes the keys on its stack.
+        for (let start = 0; start < privateKeys.length; start += PublicKey.DERIVE_BATCH_SIZE) {
+            const chunk = privateKeys.slice(start, start + PublicKey.DERIVE_BATCH_SIZE);
+            const raw = PublicKey._publicKeysDeriveBatch(chunk.map(k => k._obj));
+            for (let i = 0; i < chunk.length; ++i) {
+                publicKeys.push(new PublicKey(raw.slice(i * PublicKey.SIZE, (i + 1) * PublicKey.SIZE)));
+            }
+        }
+        return publicKeys;
+    }
+
     /**
      * @return {Uint8Array}
      */
@@ -137,39 +155,19 @@ class PublicKey extends Serializable {
         if (publicKey.byteLength !== PublicKey.SIZE) {
             throw Error('Wrong buffer size.');
         }
-        const randomize = new Uint8Array(32);
-        CryptoWorker.lib.getRandomValues(randomize);
+        // Compression runs on the static secp256k1 context, it needs no randomized context.
         if (PlatformUtils.isNodeJs()) {
-            NodeNative.node_secp256k1_ctx_init(randomize);
             const out = new Uint8Array(PublicKey.COMPRESSED_SIZE);
-            NodeNative.node_secp256k1_pubkey_compress(out, new Uint8Array(publicKey));
-            NodeNative.node_secp256k1_ctx_release();
+            NodeNative.node_secp256k1_pubkey_compress(out, publicKey);
             return out;
         } else {
-            let stackPtr;
             try {
-                stackPtr = Module.stackSave();
-                const rdm = Module.stackAlloc(32);
-                new Uint8Array(Module.HEAP8.buffer, rdm, 32).set(randomize);
-                Module._secp256k1_ctx_init(rdm);
-
-                const wasmOut = Module.stackAlloc(PublicKey.COMPRESSED_SIZE);
-                const pubKeyBufferOut = new Uint8Array(Module.HEAP8.buffer, wasmOut, PublicKey.COMPRESSED_SIZE);
-                
-                const wasmIn = Module.stackAlloc(PublicKey.SIZE);
-                const pubKeyBufferIn = new Uint8Array(Module.HEAP8.buffer, wasmIn, PublicKey.SIZE);
-                pubKeyBufferIn.set(publicKey);
-
-                Module._secp256k1_pubkey_compress(wasmOut, wasmIn);
-                const compressed = new Uint8Array(PublicKey.COMPRESSED_SIZE);
-                compressed.set(pubKeyBufferOut);
-                return compressed;
+                return WasmScratch.compute(PublicKey.COMPRESSED_SIZE, [publicKey], (wasmOut, wasmIn) => {
+                    Module._secp256k1_pubkey_compress(wasmOut, wasmIn);
+                });
             } catch (e) {
                 Log.w(PublicKey, e);
                 throw e;
-            } finally {
-                Module._secp256k1_ctx_release();
-                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
             }
         }
     }
@@ -187,7 +185,7 @@ class PublicKey extends Serializable {
         if (PlatformUtils.isNodeJs()) {
             NodeNative.node_secp256k1_ctx_init(randomize);
             const out = new Uint8Array(PublicKey.SIZE);
-            NodeNative.node_secp256k1_pubkey_create(out, new Uint8Array(privateKey));
+            NodeNative.node_secp256k1_pubkey_create(out, privateKey);
             NodeNative.node_secp256k1_ctx_release();
             return out;
         } else {
@@ -220,6 +218,59 @@ class PublicKey extends Serializable {
         }
     }
 
+    /**
+     * @param {Array.<Uint8Array>} privateKeys
+     * @returns {Uint8Array} The concatenated public keys.
+     */
+    static _publicKeysDeriveBatch(privateKeys) {
+        if (privateKeys.some(privateKey => privateKey.byteLength !== PrivateKey.SIZE)) {
+            throw Error('Wrong buffer size.');
+        }
+        const concatenatedPrivateKeys = new Uint8Array(privateKeys.length * PrivateKey.SIZE);
+        for (let i = 0; i < privateKeys.length; ++i) {
+            concatenatedPrivateKeys.set(privateKeys[i], i * PrivateKey.SIZE);
+        }
+        const randomize = new Uint8Array(32);
+        CryptoWorker.lib.getRandomValues(randomize);
+        if (PlatformUtils.isNodeJs()) {
+            NodeNative.node_secp256k1_ctx_init(randomize);
+            const out = new Uint8Array(privateKeys.length * PublicKey.SIZE);
+            const res = NodeNative.node_secp256k1_pubkey_create_batch(out, concatenatedPrivateKeys, privateKeys.length);
+            NodeNative.node_secp256k1_ctx_release();
+            concatenatedPrivateKeys.fill(0);
+            if (res !== 1) throw new Error('Invalid private key');
+            return out;
+        } else {
+            let stackPtr;
+            try {
+                stackPtr = Module.stackSave();
+                const rdm = Module.stackAlloc(32);
+                new Uint8Array(Module.HEAP8.buffer, rdm, 32).set(randomize);
+                Module._secp256k1_ctx_init(rdm);
+
+                const outSize = privateKeys.length * PublicKey.SIZE;
+                const wasmOut = Module.stackAlloc(outSize);
+                const wasmIn = Module.stackAlloc(concatenatedPrivateKeys.length);
+                const privKeyBuffer = new Uint8Array(Module.HEAP8.buffer, wasmIn, concatenatedPrivateKeys.length);
+                privKeyBuffer.set(concatenatedPrivateKeys);
+                concatenatedPrivateKeys.fill(0);
+
+                const res = Module._secp256k1_pubkey_create_batch(wasmOut, PublicKey.SIZE, wasmIn, privateKeys.length);
+                privKeyBuffer.fill(0);
+                if (res !== 1) throw new Error('Invalid private key');
+                const publicKeys = new Uint8Array(outSize);
+                publicKeys.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, outSize));
+                return publicKeys;
+            } catch (e) {
+                Log.w(PublicKey, e);
+                throw e;
+            } finally {
+                Module._secp256k1_ctx_release();
+                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
+            }
+        }
+    }
+
     /**
      * @param {Array.<Uint8Array>} publicKeys
      * @returns {Uint8Array}
@@ -269,7 +320,7 @@ class PublicKey extends Serializable {
         }
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(PublicKey.SIZE);
-            NodeNative.node_secp256k1_delinearize_pubkey(out, new Uint8Array(publicKeysHash), new Uint8Array(publicKey));
+            NodeNative.node_secp256k1_delinearize_pubkey(out, publicKeysHash, publicKey);
             return out;
         } else {
             let stackPtr;
@@ -309,7 +360,7 @@ class PublicKey extends Serializable {
         }
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(PublicKey.SIZE);
-            NodeNative.node_secp256k1_aggregate_delinearized_publkeys(out, new Uint8Array(publicKeysHash), concatenatedPublicKeys, publicKeys.length, PublicKey.SIZE);
+            NodeNative.node_secp256k1_aggregate_delinearized_publkeys(out, publicKeysHash, concatenatedPublicKeys, publicKeys.length, PublicKey.SIZE);
             return out;
         } else {
             let stackPtr;
@@ -336,5 +387,6 @@ class PublicKey extends Serializable {
 
 PublicKey.COMPRESSED_SIZE = 33;
 PublicKey.SIZE = 65;
+PublicKey.DERIVE_BATCH_SIZE = 256;
 
 Class.register(PublicKey);
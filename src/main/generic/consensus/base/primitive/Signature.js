@@ -130,7 +130,7 @@ class Signature extends Serializable {
         }
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(PartialSignature.HALF_SIZE);
-            NodeNative.node_secp256k1_add_scalars(out, new Uint8Array(a), new Uint8Array(b));
+            NodeNative.node_secp256k1_add_scalars(out, a, b);
             return out;
         } else {
             let stackPtr;
@@ -169,7 +169,7 @@ class Signature extends Serializable {
         if (PlatformUtils.isNodeJs()) {
             NodeNative.node_secp256k1_ctx_init(randomize);
             const out = new Uint8Array(Signature.SIZE);
-            NodeNative.node_secp256k1_schnorr_sign(out, new Uint8Array(message), new Uint8Array(publicKey), new Uint8Array(privateKey));
+            NodeNative.node_secp256k1_schnorr_sign(out, message, publicKey, privateKey);
             NodeNative.node_secp256k1_ctx_release();
             return out;
         } else {
@@ -213,36 +213,16 @@ class Signature extends Serializable {
      * @returns {boolean}
      */
     static _signatureVerify(publicKey, message, signature) {
-        const randomize = new Uint8Array(32);
-        CryptoWorker.lib.getRandomValues(randomize);
+        // Verification runs on the static secp256k1 context, it needs no randomized context.
         if (PlatformUtils.isNodeJs()) {
-            NodeNative.node_secp256k1_ctx_init(randomize);
-            const res = !!NodeNative.node_secp256k1_schnorr_verify(new Uint8Array(signature), new Uint8Array(message), new Uint8Array(publicKey));
-            NodeNative.node_secp256k1_ctx_release();
-            return res;
+            return !!NodeNative.node_secp256k1_schnorr_verify(signature, message, publicKey);
         } else {
-            let stackPtr;
             try {
-                stackPtr = Module.stackSave();
-                const rdm = Module.stackAlloc(32);
-                const rdmBuff = new Uint8Array(Module.HEAP8.buffer, rdm, 32);
-                rdmBuff.set(randomize);
-                Module._secp256k1_ctx_init(rdm);
-                
-                const wasmInPubKey = Module.stackAlloc(publicKey.length);
-                new Uint8Array(Module.HEAP8.buffer, wasmInPubKey, publicKey.length).set(publicKey);
-                const wasmInMessage = Module.stackAlloc(message.length);
-                new Uint8Array(Module.HEAP8.buffer, wasmInMessage, message.length).set(message);
-                const wasmInSignature = Module.stackAlloc(signature.length);
-                new Uint8Array(Module.HEAP8.buffer, wasmInSignature, signature.length).set(signature);
-
-                return !!Module._secp256k1_schnorr_verify(wasmInSignature, wasmInMessage, message.byteLength, wasmInPubKey);
+                return WasmScratch.call(0, [publicKey, message, signature], (wasmOut, wasmInPubKey, wasmInMessage, wasmInSignature) =>
+                    !!Module._secp256k1_schnorr_verify(wasmInSignature, wasmInMessage, message.byteLength, wasmInPubKey));
             } catch (e) {
                 Log.w(Signature, e);
                 throw e;
-            } finally {
-                Module._secp256k1_ctx_release();
-                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
             }
         }
     }
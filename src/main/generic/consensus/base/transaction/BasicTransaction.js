@@ -104,7 +104,7 @@ class BasicTransaction extends Transaction {
      */
     set signature(signature) {
         this._signatureProof.signature = signature;
-        this._proof = this._signatureProof.serialize();
+        this.proof = this._signatureProof.serialize();
     }
 }
 Transaction.FORMAT_MAP.set(Transaction.Format.BASIC, BasicTransaction);
@@ -4,6 +4,9 @@ class SignatureProof {
      * @returns {boolean}
      */
     static verifyTransaction(transaction) {
+        // Set if the proof was already verified natively, see NativeBlockBodyValidator.
+        if (transaction._signatureProofValid) return true;
+
         try {
             const buffer = new SerialBuffer(transaction.proof);
             const proof = SignatureProof.unserialize(buffer);
@@ -379,6 +379,8 @@ class Transaction {
     /** @type {Uint8Array} */
     set proof(proof) {
         this._proof = proof;
+        // A proof that was verified natively has been replaced.
+        this._signatureProofValid = false;
     }
 }
 
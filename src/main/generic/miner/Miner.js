@@ -201,7 +201,7 @@ class Miner extends Observable {
      * @param {{hash: Hash, nonce: number, block: Block}} obj
      */
     async onWorkerShare(obj) {
-        this._hashCount += this._workerPool.noncesPerRun;
+        this._hashCount += this._workerPool.hashesPerRun;
         if (obj.block && obj.block.prevHash.equals(this._blockchain.headHash)) {
             Log.d(Miner, () => `Received share: ${obj.nonce} / ${obj.hash.toHex()}`);
             if (!this._submittingBlock) {
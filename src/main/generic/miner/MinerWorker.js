@@ -8,8 +8,14 @@ class MinerWorker {
      * @param compact
      * @param minNonce
      * @param maxNonce
+     * @param [threads] Number of wasm threads to split the nonces over, up to maxThreads().
      * @returns {Promise.<{hash: Uint8Array, nonce: number}|boolean>}
      */
-    async multiMine(blockHeader, compact, minNonce, maxNonce) {}
+    async multiMine(blockHeader, compact, minNonce, maxNonce, threads) {}
+
+    /**
+     * @returns {Promise.<number>} Number of threads a single multiMine() call can use.
+     */
+    async maxThreads() {}
 }
 Class.register(MinerWorker);
@@ -6,21 +6,37 @@ class MinerWorkerImpl extends IWorker.Stub(MinerWorker) {
         super();
         // FIXME: This is needed for Babel to work correctly. Can be removed as soon as we updated to Babel v7.
         this._superInit = super.init;
+        /** @type {number} */
+        this._maxThreads = 1;
     }
 
     async init(name) {
         await this._superInit.call(this, name);
-        if (PlatformUtils.isBrowser()) await WasmHelper.doImportBrowser();
+        if (PlatformUtils.isBrowser()) {
+            if (await WasmHelper.doImportThreadsBrowser()) {
+                this._maxThreads = PlatformUtils.hardwareConcurrency;
+            } else {
+                await WasmHelper.doImportBrowser();
+            }
+        }
+    }
+
+    async maxThreads() {
+        return this._maxThreads;
     }
 
-    async multiMine(input, compact, minNonce, maxNonce) {
+    async multiMine(input, compact, minNonce, maxNonce, threads = 1) {
         const hash = new Uint8Array(32);
         let wasmOut, wasmIn;
         try {
             wasmOut = Module._malloc(hash.length);
             wasmIn = Module._malloc(input.length);
             Module.HEAPU8.set(input, wasmIn);
-            const nonce = Module._krypton_argon2_target(wasmOut, wasmIn, input.length, compact, minNonce, maxNonce, 512);
+            // The wasm thread pool has one thread per core, more would have to be started asynchronously.
+            threads = Math.min(threads, this._maxThreads);
+            const nonce = threads > 1
+                ? Module._krypton_argon2_target_mt(wasmOut, wasmIn, input.length, compact, minNonce, maxNonce, 512, threads)
+                : Module._krypton_argon2_target(wasmOut, wasmIn, input.length, compact, minNonce, maxNonce, 512);
             if (nonce === maxNonce) return false;
             hash.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, hash.length));
             return {hash, nonce};
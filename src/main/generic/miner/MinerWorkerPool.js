@@ -21,6 +21,15 @@ class MinerWorkerPool extends IWorker.Pool(MinerWorker) {
         /** @type {number} */
         this._cycleWait = 100;
 
+        /**
+         * Worker running the multi-threaded wasm miner. If set, it is the only worker and each run spreads
+         * poolSize * noncesPerRun nonces over poolSize wasm threads.
+         * @type {MinerWorker}
+         */
+        this._threadedWorker = null;
+        /** @type {Promise.<void>} */
+        this._threadedWorkerPromise = null;
+
         // FIXME: This is needed for Babel to work correctly. Can be removed as soon as we updated to Babel v7.
         this._superUpdateToSize = super._updateToSize;
 
@@ -49,7 +58,7 @@ class MinerWorkerPool extends IWorker.Pool(MinerWorker) {
                         } catch (e) {
                             fail(e);
                         }
-                    }, blockHeader, compact, minNonce, maxNonce, 512);
+                    }, blockHeader, compact, minNonce, maxNonce, 512, NativeCryptoPool.Priority.MINING);
                 });
             };
         }
@@ -69,6 +78,14 @@ class MinerWorkerPool extends IWorker.Pool(MinerWorker) {
         this._noncesPerRun = nonces;
     }
 
+    /**
+     * Number of nonces checked by a run of multiMine().
+     * @type {number}
+     */
+    get hashesPerRun() {
+        return this._threadedWorker ? this._noncesPerRun * this.poolSize : this._noncesPerRun;
+    }
+
     /**
      * @type {number}
      */
@@ -121,7 +138,7 @@ class MinerWorkerPool extends IWorker.Pool(MinerWorker) {
             await this._updateToSize();
             this._activeNonces = [];
             this._miningEnabled = true;
-            for (let i = 0; i < this.poolSize; ++i) {
+            for (let i = 0; i < this._minerCount; ++i) {
                 this._startMiner();
             }
         } else {
@@ -133,23 +150,53 @@ class MinerWorkerPool extends IWorker.Pool(MinerWorker) {
         this._miningEnabled = false;
     }
 
+    /**
+     * Number of concurrent multiMine() runs.
+     * @type {number}
+     * @private
+     */
+    get _minerCount() {
+        return this._threadedWorker ? 1 : this.poolSize;
+    }
+
     async _updateToSize() {
-        if (!PlatformUtils.isNodeJs()) {
+        if (PlatformUtils.isBrowser() && WasmHelper.supportsWasmThreads()) {
+            // Only tried once, the worker falls back to the single-threaded builds if it cannot load worker-wasm-mt.
+            this._threadedWorkerPromise = this._threadedWorkerPromise || this._startThreadedWorker();
+            await this._threadedWorkerPromise;
+        }
+        if (!PlatformUtils.isNodeJs() && !this._threadedWorker) {
             await this._superUpdateToSize.call(this);
         }
 
-        while (this._miningEnabled && this._activeNonces.length < this.poolSize) {
+        while (this._miningEnabled && this._activeNonces.length < this._minerCount) {
             this._startMiner();
         }
     }
 
+    /**
+     * @returns {Promise.<void>}
+     * @private
+     */
+    async _startThreadedWorker() {
+        const worker = await IWorker.startWorkerForProxy(MinerWorker, `${this._name}#mt`);
+        if (await worker.maxThreads() <= 1) {
+            worker.destroy();
+            return;
+        }
+        Log.i(MinerWorkerPool, 'Using wasm threads');
+        this._threadedWorker = worker;
+        this.multiMine = (blockHeader, compact, minNonce, maxNonce) =>
+            worker.multiMine(blockHeader, compact, minNonce, maxNonce, this.poolSize);
+    }
+
     _startMiner() {
-        if (this._activeNonces.length >= this.poolSize) {
+        if (this._activeNonces.length >= this._minerCount) {
             return;
         }
 
         const minNonce = this._activeNonces.length === 0 ? 0 : Math.max.apply(null, this._activeNonces.map((a) => a.maxNonce));
-        const maxNonce = minNonce + this._noncesPerRun;
+        const maxNonce = minNonce + this.hashesPerRun;
         const nonceRange = {minNonce, maxNonce};
         this._activeNonces.push(nonceRange);
         this._singleMiner(nonceRange).catch((e) => Log.e(MinerWorkerPool, e));
@@ -178,12 +225,12 @@ class MinerWorkerPool extends IWorker.Pool(MinerWorker) {
                     nonce: nonceRange.maxNonce
                 });
             }
-            if (this._activeNonces.length > this.poolSize) {
+            if (this._activeNonces.length > this._minerCount) {
                 this._activeNonces.splice(this._activeNonces.indexOf(nonceRange), 1);
                 return;
             } else {
                 const newMin = Math.max.apply(null, this._activeNonces.map((a) => a.maxNonce));
-                const newRange = {minNonce: newMin, maxNonce: newMin + this._noncesPerRun};
+                const newRange = {minNonce: newMin, maxNonce: newMin + this.hashesPerRun};
                 this._activeNonces.splice(this._activeNonces.indexOf(nonceRange), 1, newRange);
                 nonceRange = newRange;
             }
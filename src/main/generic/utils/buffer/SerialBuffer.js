@@ -59,6 +59,19 @@ class SerialBuffer extends Uint8Array {
         return new Uint8Array(value);
     }
 
+    /**
+     * Like read(), but returns a view into this buffer instead of a copy. Only for values that are
+     * converted right away, e.g. into a string.
+     * @param {number} length
+     * @return {Uint8Array}
+     * @private
+     */
+    _readView(length) {
+        const value = this.subarray(this._readPos, this._readPos + length);
+        this._readPos += length;
+        return value;
+    }
+
     /**
      * @param {*} array
      */
@@ -139,6 +152,15 @@ class SerialBuffer extends Uint8Array {
      * @return {BigNumber}
      */
     readUint128() {
+        // Values below 2^53, like all balances and fees in practice, are read without BigNumber arithmetic.
+        if (this._view.getUint32(this._readPos) === 0 && this._view.getUint32(this._readPos + 4) === 0) {
+            const high = this._view.getUint32(this._readPos + 8);
+            if (high < SerialBuffer._UINT53_HIGH) {
+                const value = new BigNumber(high * SerialBuffer._UINT32_RANGE + this._view.getUint32(this._readPos + 12));
+                this._readPos += 16;
+                return value;
+            }
+        }
         const op96 = new BigNumber('1000000000000000000000000', 16);
         const op64 = new BigNumber('10000000000000000', 16);
         const op32 = new BigNumber('100000000', 16);
@@ -157,6 +179,15 @@ class SerialBuffer extends Uint8Array {
      */
     writeUint128(value) {
         if (!NumberUtils.isUint128(value)) throw new Error('Malformed value');
+        if (value.lt(Number.MAX_SAFE_INTEGER)) {
+            const number = value.toNumber();
+            this._view.setUint32(this._writePos, 0);
+            this._view.setUint32(this._writePos + 4, 0);
+            this._view.setUint32(this._writePos + 8, Math.floor(number / SerialBuffer._UINT32_RANGE));
+            this._view.setUint32(this._writePos + 12, number % SerialBuffer._UINT32_RANGE);
+            this._writePos += 16;
+            return;
+        }
         const op96 = new BigNumber('1000000000000000000000000', 16);
         const op64 = new BigNumber('10000000000000000', 16);
         const op32 = new BigNumber('100000000', 16);
@@ -245,7 +276,7 @@ class SerialBuffer extends Uint8Array {
      * @return {string}
      */
     readString(length) {
-        const bytes = this.read(length);
+        const bytes = this._readView(length);
         return BufferUtils.toAscii(bytes);
     }
 
@@ -264,7 +295,7 @@ class SerialBuffer extends Uint8Array {
      * @return {string}
      */
     readPaddedString(length) {
-        const bytes = this.read(length);
+        const bytes = this._readView(length);
         let i = 0;
         while (i < length && bytes[i] !== 0x0) i++;
         const view = new Uint8Array(bytes.buffer, bytes.byteOffset, i);
@@ -289,7 +320,7 @@ class SerialBuffer extends Uint8Array {
     readVarLengthString() {
         const length = this.readUint8();
         if (this._readPos + length > this.length) throw new Error('Malformed length');
-        const bytes = this.read(length);
+        const bytes = this._readView(length);
         return BufferUtils.toAscii(bytes);
     }
 
@@ -331,4 +362,8 @@ class SerialBuffer extends Uint8Array {
     }
 }
 SerialBuffer.EMPTY = new SerialBuffer(0);
+/** @type {number} */
+SerialBuffer._UINT32_RANGE = Math.pow(2, 32);
+/** Values whose upper 32 bits of the lower 64 bits are below this are below 2^53. */
+SerialBuffer._UINT53_HIGH = Math.pow(2, 21);
 Class.register(SerialBuffer);
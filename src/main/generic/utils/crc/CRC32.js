@@ -1,7 +1,7 @@
 class CRC32 {
     static _createTable () {
         let b;
-        const table = [];
+        const table = new Uint32Array(256);
 
         for (let j = 0; j < 256; ++j) {
             b = j;
@@ -14,33 +14,53 @@ class CRC32 {
     }
 
     /**
-     * @param {Uint8Array} buf
+     * @param {Uint8Array|Array.<number>} buf
      * @return {number}
      */
     static compute(buf) {
-        if (!CRC32._table) CRC32._table = CRC32._createTable();
-        if (!CRC32._hex_chars) CRC32._hex_chars = '0123456789abcdef'.split('');
-
-        const message = new Uint8Array(buf);
-        const initialValue = -1;
-
-        let crc = initialValue;
-        let hex = '';
+        if (!(buf instanceof Uint8Array)) buf = new Uint8Array(buf);
+        if (PlatformUtils.isNodeJs()) {
+            // Reads the view in place, messages are not copied.
+            return NodeNative.node_crc32(buf);
+        }
+        // Older wasm builds do not have the native CRC32 yet.
+        if (typeof Module !== 'undefined' && Module._krypton_crc32) {
+            return CRC32._computeWasm(buf);
+        }
+        return CRC32._computeJs(buf);
+    }
 
-        for (let i = 0; i < message.length; ++i) {
-            crc = CRC32._table[(crc ^ message[i]) & 0xFF] ^ (crc >>> 8);
+    /**
+     * @param {Uint8Array} buf
+     * @return {number}
+     * @private
+     */
+    static _computeWasm(buf) {
+        // Messages can be several megabytes, more than fits on the wasm stack.
+        const wasmIn = Module._malloc(buf.length);
+        try {
+            new Uint8Array(Module.HEAPU8.buffer, wasmIn, buf.length).set(buf);
+            return Module._krypton_crc32(wasmIn, buf.length) >>> 0;
+        } finally {
+            Module._free(wasmIn);
         }
-        crc ^= initialValue;
+    }
 
-        hex += CRC32._hex_chars[(crc >> 28) & 0x0F] + CRC32._hex_chars[(crc >> 24) & 0x0F] +
-            CRC32._hex_chars[(crc >> 20) & 0x0F] + CRC32._hex_chars[(crc >> 16) & 0x0F] +
-            CRC32._hex_chars[(crc >> 12) & 0x0F] + CRC32._hex_chars[(crc >> 8) & 0x0F] +
-            CRC32._hex_chars[(crc >> 4) & 0x0F] + CRC32._hex_chars[crc & 0x0F];
+    /**
+     * @param {Uint8Array} buf
+     * @return {number}
+     * @private
+     */
+    static _computeJs(buf) {
+        if (!CRC32._table) CRC32._table = CRC32._createTable();
 
-        return parseInt(hex, 16);
+        let crc = -1;
+        for (let i = 0; i < buf.length; ++i) {
+            crc = CRC32._table[(crc ^ buf[i]) & 0xFF] ^ (crc >>> 8);
+        }
+        return (crc ^ -1) >>> 0;
     }
 }
 CRC32._table = null;
-CRC32._hex_chars = null;
 CRC32._POLYNOMIAL = 0xEDB88320;
 Class.register(CRC32);
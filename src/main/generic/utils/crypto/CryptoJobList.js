@@ -0,0 +1,206 @@
+/**
+ * A list of independent hash and signature verification jobs that read their data from one shared
+ * buffer, described by offsets. On Node.js the whole list is handed to the native addon in a single
+ * call, which spreads large lists over the threads of the crypto pool; elsewhere the jobs are run one
+ * by one.
+ */
+class CryptoJobList {
+    /**
+     * @param {Uint8Array} input Buffer holding the data of all jobs, e.g. a serialized block body.
+     * @param {number} [capacity] Expected number of jobs.
+     */
+    constructor(input, capacity = 16) {
+        /** @type {Uint8Array} */
+        this._input = input;
+        /** @type {Uint32Array} */
+        this._jobs = new Uint32Array(Math.max(capacity, 1) * CryptoJobList.JOB_WORDS);
+        /** @type {number} */
+        this._length = 0;
+        /** @type {number} */
+        this._outputSize = 0;
+        /** @type {?Uint8Array} */
+        this._output = null;
+    }
+
+    /**
+     * Adds a job that hashes input[offset, offset + length).
+     * @param {Hash.Algorithm} algorithm
+     * @param {number} offset
+     * @param {number} length
+     * @returns {number} Index of the job.
+     */
+    hash(algorithm, offset, length) {
+        return this._add(algorithm, offset, length, 0, 0, Hash.getSize(algorithm));
+    }
+
+    /**
+     * Adds a job that verifies a Schnorr signature over input[messageOffset, messageOffset + messageLength).
+     * @param {number} messageOffset
+     * @param {number} messageLength
+     * @param {number} signatureOffset
+     * @param {number} publicKeyOffset Offset of the compressed public key.
+     * @returns {number} Index of the job.
+     */
+    verifySchnorr(messageOffset, messageLength, signatureOffset, publicKeyOffset) {
+        return this._add(CryptoJobList.Type.SCHNORR_VERIFY, messageOffset, messageLength, signatureOffset, publicKeyOffset, 1);
+    }
+
+    /**
+     * @param {CryptoJobList.Type|Hash.Algorithm} type
+     * @param {number} offset
+     * @param {number} length
+     * @param {number} signatureOffset
+     * @param {number} publicKeyOffset
+     * @param {number} outputSize
+     * @returns {number}
+     * @private
+     */
+    _add(type, offset, length, signatureOffset, publicKeyOffset, outputSize) {
+        if (this._output) throw new Error('Jobs were already run');
+        if ((this._length + 1) * CryptoJobList.JOB_WORDS > this._jobs.length) {
+            const jobs = new Uint32Array(this._jobs.length * 2);
+            jobs.set(this._jobs);
+            this._jobs = jobs;
+        }
+        this._jobs.set([type, offset, length, signatureOffset, publicKeyOffset, this._outputSize], this._length * CryptoJobList.JOB_WORDS);
+        this._outputSize += outputSize;
+        return this._length++;
+    }
+
+    /**
+     * Runs all jobs and blocks until they are done. On Node.js, large lists are shared with the
+     * threads of the crypto pool.
+     * @returns {void}
+     */
+    run() {
+        this._output = new Uint8Array(this._outputSize);
+        if (PlatformUtils.isNodeJs()) {
+            NodeNative.node_crypto_batch(this._jobs.subarray(0, this._length * CryptoJobList.JOB_WORDS), this._input, this._output);
+        } else {
+            for (let i = 0; i < this._length; ++i) {
+                if (this._type(i) === CryptoJobList.Type.ARGON2D) throw new Error('Argon2d jobs can only be run asynchronously');
+                this._runJob(i, this._execute(i));
+            }
+        }
+    }
+
+    /**
+     * Runs all jobs without blocking the calling thread.
+     * @param {NativeCryptoPool.Priority} [priority] Priority class in the crypto pool (Node.js only).
+     * @returns {Promise}
+     */
+    async execute(priority) {
+        this._output = new Uint8Array(this._outputSize);
+        if (PlatformUtils.isNodeJs()) {
+            const jobs = this._jobs.subarray(0, this._length * CryptoJobList.JOB_WORDS);
+            return new Promise((resolve) => {
+                NodeNative.node_crypto_batch_async(resolve, jobs, this._input, this._output, priority);
+            });
+        }
+        for (let i = 0; i < this._length; ++i) {
+            this._runJob(i, await this._execute(i));
+        }
+    }
+
+    /**
+     * @param {number} index
+     * @returns {Uint8Array|boolean|Promise.<Uint8Array>}
+     * @private
+     */
+    _execute(index) {
+        const job = this._jobs.subarray(index * CryptoJobList.JOB_WORDS, (index + 1) * CryptoJobList.JOB_WORDS);
+        const data = this._input.subarray(job[1], job[1] + job[2]);
+        switch (job[0]) {
+            case CryptoJobList.Type.BLAKE2B: return Hash.computeBlake2b(data);
+            case CryptoJobList.Type.ARGON2D: return CryptoWorker.getInstanceAsync().then(worker => worker.computeArgon2d(data));
+            case CryptoJobList.Type.SHA256: return Hash.computeSha256(data);
+            case CryptoJobList.Type.SHA512: return Hash.computeSha512(data);
+            case CryptoJobList.Type.RIPEMD160: return Hash.computeRipemd160(data);
+            case CryptoJobList.Type.KECCAK256: return Hash.computeKeccak256(data);
+            case CryptoJobList.Type.SCHNORR_VERIFY: {
+                const signature = this._input.subarray(job[3], job[3] + Signature.SIZE);
+                const publicKey = this._input.subarray(job[4], job[4] + PublicKey.COMPRESSED_SIZE);
+                return Signature._signatureVerify(publicKey, data, signature);
+            }
+        }
+        throw new Error('Invalid crypto job type');
+    }
+
+    /**
+     * @param {number} index
+     * @param {Uint8Array|boolean} result
+     * @private
+     */
+    _runJob(index, result) {
+        const offset = this._jobs[index * CryptoJobList.JOB_WORDS + 5];
+        if (typeof result === 'boolean') {
+            this._output[offset] = result ? 1 : 0;
+        } else {
+            this._output.set(result, offset);
+        }
+    }
+
+    /**
+     * @param {number} index
+     * @returns {CryptoJobList.Type}
+     * @private
+     */
+    _type(index) {
+        return this._jobs[index * CryptoJobList.JOB_WORDS];
+    }
+
+    /**
+     * Result of a hash job, once the list was run.
+     * @param {number} index
+     * @returns {Hash}
+     */
+    getHash(index) {
+        if (!this._output) throw new Error('Jobs were not run yet');
+        const algorithm = this._type(index);
+        const offset = this._jobs[index * CryptoJobList.JOB_WORDS + 5];
+        return new Hash(this._output.slice(offset, offset + Hash.getSize(algorithm)), algorithm);
+    }
+
+    /**
+     * Result of a verification job, once the list was run.
+     * @param {number} index
+     * @returns {boolean}
+     */
+    isValid(index) {
+        if (!this._output) throw new Error('Jobs were not run yet');
+        return this._output[this._jobs[index * CryptoJobList.JOB_WORDS + 5]] === 1;
+    }
+
+    /**
+     * Whether all verification jobs succeeded, once the list was run.
+     * @returns {boolean}
+     */
+    allValid() {
+        for (let i = 0; i < this._length; ++i) {
+            if (this._type(i) === CryptoJobList.Type.SCHNORR_VERIFY && !this.isValid(i)) return false;
+        }
+        return true;
+    }
+
+    /** @type {number} */
+    get length() {
+        return this._length;
+    }
+}
+
+/**
+ * Job types, the hash types use the values of Hash.Algorithm. Must match src/native/crypto_batch.h.
+ * @enum {number}
+ */
+CryptoJobList.Type = {
+    BLAKE2B: 1,
+    ARGON2D: 2,
+    SHA256: 3,
+    SHA512: 4,
+    RIPEMD160: 5,
+    KECCAK256: 6,
+    SCHNORR_VERIFY: 16
+};
+/** Number of uint32 words describing a job. */
+CryptoJobList.JOB_WORDS = 6;
+Class.register(CryptoJobList);
@@ -12,83 +12,65 @@ class CryptoWorkerImpl extends IWorker.Stub(CryptoWorker) {
     }
 
     /**
+     * On Node.js the hash is computed on the native crypto pool.
      * @param {Uint8Array} input
-     * @returns {Uint8Array}
+     * @returns {Uint8Array|Promise.<Uint8Array>}
      */
     computeArgon2d(input) {
         if (PlatformUtils.isNodeJs()) {
-            const out = new Uint8Array(Hash.getSize(Hash.Algorithm.ARGON2D));
-            const res = NodeNative.node_argon2(out, new Uint8Array(input), 512);
-            if (res !== 0) {
-                throw res;
-            }
-            return out;
+            return NativeCryptoPool.computeArgon2d(input, NativeCryptoPool.Priority.CONSENSUS);
         } else {
-            let stackPtr;
             try {
-                stackPtr = Module.stackSave();
-                const hashSize = Hash.getSize(Hash.Algorithm.ARGON2D);
-                const wasmOut = Module.stackAlloc(hashSize);
-                const wasmIn = Module.stackAlloc(input.length);
-                new Uint8Array(Module.HEAPU8.buffer, wasmIn, input.length).set(input);
-                const res = Module._krypton_argon2(wasmOut, wasmIn, input.length, 512);
-                if (res !== 0) {
-                    throw res;
-                }
-                const hash = new Uint8Array(hashSize);
-                hash.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, hashSize));
-                return hash;
+                return WasmScratch.compute(Hash.getSize(Hash.Algorithm.ARGON2D), [input], (wasmOut, wasmIn) => {
+                    const res = Module._krypton_argon2(wasmOut, wasmIn, input.length, 512);
+                    if (res !== 0) {
+                        throw res;
+                    }
+                });
             } catch (e) {
                 Log.w(CryptoWorkerImpl, e);
                 throw e;
-            } finally {
-                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
             }
         }
     }
 
     /**
+     * On Node.js the hashes are computed in parallel on the native crypto pool.
      * @param {Array.<Uint8Array>} inputs
-     * @returns {Array.<Uint8Array>}
+     * @returns {Array.<Uint8Array>|Promise.<Array.<Uint8Array>>}
      */
     computeArgon2dBatch(inputs) {
-        const hashes = [];
         if (PlatformUtils.isNodeJs()) {
-            for(const input of inputs) {
-                const out = new Uint8Array(Hash.getSize(Hash.Algorithm.ARGON2D));
-                const res = NodeNative.node_argon2(out, new Uint8Array(input), 512);
+            return Promise.all(inputs.map(input => NativeCryptoPool.computeArgon2d(input, NativeCryptoPool.Priority.CONSENSUS)));
+        }
+        if (inputs.length === 0) return [];
+        // Older wasm builds do not have the batch entry point yet.
+        if (!Module._krypton_argon2_batch) {
+            return inputs.map(input => this.computeArgon2d(input));
+        }
+        try {
+            const hashSize = Hash.getSize(Hash.Algorithm.ARGON2D);
+            const lengths = Uint32Array.from(inputs, input => input.length);
+            const concatenated = new Uint8Array(lengths.reduce((sum, length) => sum + length, 0));
+            let offset = 0;
+            for (const input of inputs) {
+                concatenated.set(input, offset);
+                offset += input.length;
+            }
+            const out = WasmScratch.compute(hashSize * inputs.length, [concatenated, lengths], (wasmOut, wasmIn, wasmInLengths) => {
+                const res = Module._krypton_argon2_batch(wasmOut, wasmIn, wasmInLengths, inputs.length, 512);
                 if (res !== 0) {
                     throw res;
                 }
-                hashes.push(out);
+            });
+            const hashes = [];
+            for (let i = 0; i < inputs.length; ++i) {
+                hashes.push(out.slice(i * hashSize, (i + 1) * hashSize));
             }
             return hashes;
-        } else {
-            let stackPtr;
-            try {
-                stackPtr = Module.stackSave();
-                const hashSize = Hash.getSize(Hash.Algorithm.ARGON2D);
-                const wasmOut = Module.stackAlloc(hashSize);
-                const stackTmp = Module.stackSave();
-                for (const input of inputs) {
-                    Module.stackRestore(stackTmp);
-                    const wasmIn = Module.stackAlloc(input.length);
-                    new Uint8Array(Module.HEAPU8.buffer, wasmIn, input.length).set(input);
-                    const res = Module._krypton_argon2(wasmOut, wasmIn, input.length, 512);
-                    if (res !== 0) {
-                        throw res;
-                    }
-                    const hash = new Uint8Array(hashSize);
-                    hash.set(new Uint8Array(Module.HEAPU8.buffer, wasmOut, hashSize));
-                    hashes.push(hash);
-                }
-                return hashes;
-            } catch (e) {
-                Log.w(CryptoWorkerImpl, e);
-                throw e;
-            } finally {
-                if (stackPtr !== undefined) Module.stackRestore(stackPtr);
-            }
+        } catch (e) {
+            Log.w(CryptoWorkerImpl, e);
+            throw e;
         }
     }
 
@@ -103,7 +85,7 @@ class CryptoWorkerImpl extends IWorker.Stub(CryptoWorker) {
     kdfLegacy(key, salt, iterations, outputSize = Hash.getSize(Hash.Algorithm.ARGON2D)) {
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(outputSize);
-            const res = NodeNative.node_kdf_legacy(out, new Uint8Array(key), new Uint8Array(salt), 512, iterations);
+            const res = NodeNative.node_kdf_legacy(out, key, salt, 512, iterations);
             if (res !== 0) {
                 throw res;
             }
@@ -143,7 +125,7 @@ class CryptoWorkerImpl extends IWorker.Stub(CryptoWorker) {
     kdf(key, salt, iterations, outputSize = Hash.getSize(Hash.Algorithm.ARGON2D)) {
         if (PlatformUtils.isNodeJs()) {
             const out = new Uint8Array(outputSize);
-            const res = NodeNative.node_kdf(out, new Uint8Array(key), new Uint8Array(salt), 512, iterations);
+            const res = NodeNative.node_kdf(out, key, salt, 512, iterations);
             if (res !== 0) {
                 throw res;
             }
@@ -0,0 +1,83 @@
+/**
+ * Passes buffers to the wasm module through its scratch region, a fixed buffer kept in the module
+ * (krypton_scratch_start), instead of allocating them on the wasm stack for every call. The output is
+ * placed first, followed by the inputs. Calls whose buffers do not fit, or that run on older wasm builds
+ * without the scratch exports, use a heap allocation instead.
+ */
+class WasmScratch {
+    /**
+     * Copies the inputs into the wasm heap and calls fn with the address of the output followed by the
+     * addresses of the inputs. The buffers are only valid during the call.
+     * @template T
+     * @param {number} outSize
+     * @param {Array.<Uint8Array|Uint32Array>} inputs
+     * @param {function(number, ...number):T} fn
+     * @returns {T}
+     */
+    static call(outSize, inputs, fn) {
+        const offsets = [];
+        let size = WasmScratch._align(outSize);
+        for (const input of inputs) {
+            offsets.push(size);
+            size += WasmScratch._align(input.byteLength);
+        }
+
+        const scratch = WasmScratch._scratch();
+        const allocated = size > scratch.size ? Module._malloc(size) : 0;
+        const start = allocated || scratch.start;
+        try {
+            // Read HEAPU8 after the allocation, it may have grown the memory.
+            const heap = Module.HEAPU8;
+            const pointers = [start];
+            for (let i = 0; i < inputs.length; ++i) {
+                const input = inputs[i];
+                heap.set(new Uint8Array(input.buffer, input.byteOffset, input.byteLength), start + offsets[i]);
+                pointers.push(start + offsets[i]);
+            }
+            return fn(...pointers);
+        } finally {
+            if (allocated) Module._free(allocated);
+        }
+    }
+
+    /**
+     * Like {@link WasmScratch.call}, but returns a copy of the outSize bytes written to the output.
+     * @param {number} outSize
+     * @param {Array.<Uint8Array|Uint32Array>} inputs
+     * @param {function(number, ...number)} fn
+     * @returns {Uint8Array}
+     */
+    static compute(outSize, inputs, fn) {
+        return WasmScratch.call(outSize, inputs, (out, ...pointers) => {
+            fn(out, ...pointers);
+            return Module.HEAPU8.slice(out, out + outSize);
+        });
+    }
+
+    /**
+     * @param {number} size
+     * @returns {number}
+     * @private
+     */
+    static _align(size) {
+        return (size + 7) & ~7;
+    }
+
+    /**
+     * @returns {{start: number, size: number}}
+     * @private
+     */
+    static _scratch() {
+        // The module is replaced when a worker loads a different build.
+        if (WasmScratch._module !== Module) {
+            WasmScratch._module = Module;
+            WasmScratch._region = Module._krypton_scratch_start
+                ? { start: Module._krypton_scratch_start(), size: Module._krypton_scratch_size() }
+                : { start: 0, size: 0 };
+        }
+        return WasmScratch._region;
+    }
+}
+WasmScratch._module = null;
+WasmScratch._region = null;
+Class.register(WasmScratch);
@@ -156,6 +156,20 @@ class MultiSigWallet extends Wallet {
         return CommitmentPair.generate();
     }
 
+    /**
+     * Creates a signing session for the given set of signers that caches the aggregate key
+     * material across signatures. The caller must destroy() the session when done.
+     * @param {Array.<PublicKey>} publicKeys
+     * @returns {MultiSigSession}
+     */
+    createSession(publicKeys) {
+        // Sort public keys to get the right combined public key.
+        publicKeys = publicKeys.slice();
+        publicKeys.sort((a, b) => a.compare(b));
+
+        return new MultiSigSession(this._keyPair.privateKey, this._keyPair.publicKey, publicKeys);
+    }
+
     /**
      * @param {Transaction} transaction
      * @param {Array.<PublicKey>} publicKeys
@@ -6,11 +6,15 @@ class WasmHelper {
 
     static async doImportBrowser() {
         WasmHelper._importBrowserPromise = WasmHelper._importBrowserPromise || (async () => {
-            if (await WasmHelper.importWasmBrowser('worker-wasm.wasm')) {
-                await WasmHelper.importScriptBrowser('worker-wasm.js', 'Module', '{WORKER_WASM_HASH}');
-            } else {
-                await WasmHelper.importScriptBrowser('worker-js.js', 'Module', '{WORKER_JS_HASH}');
+            if (WasmHelper.supportsWasmSimd() && await WasmHelper.importWasmBrowser('worker-wasm-simd.wasm')
+                && await WasmHelper._importWasmScriptBrowser('worker-wasm-simd.js', '{WORKER_WASM_SIMD_HASH}')) {
+                return;
+            }
+            if (await WasmHelper.importWasmBrowser('worker-wasm.wasm')
+                && await WasmHelper._importWasmScriptBrowser('worker-wasm.js', '{WORKER_WASM_HASH}')) {
+                return;
             }
+            await WasmHelper.importScriptBrowser('worker-js.js', 'Module', '{WORKER_JS_HASH}');
         })();
         try {
             await WasmHelper._importBrowserPromise;
@@ -20,6 +24,71 @@ class WasmHelper {
         }
     }
 
+    /**
+     * Loads the script of a wasm build whose module was imported with importWasmBrowser.
+     * @param {string} script
+     * @param {?string} integrity
+     * @returns {Promise.<boolean>} False if the module could not be instantiated, the next build has to be used then.
+     * @private
+     */
+    static async _importWasmScriptBrowser(script, integrity) {
+        try {
+            await WasmHelper.importScriptBrowser(script, 'Module', integrity);
+            return true;
+        } catch (e) {
+            Log.w(WasmHelper, `Failed to load ${script}: ${e}`);
+            WasmHelper._global.Module = undefined;
+            return false;
+        }
+    }
+
+    /**
+     * Loads the multi-threaded build used by the miner, if the page allows wasm threads.
+     * @returns {Promise.<boolean>} False if the single-threaded builds have to be used.
+     */
+    static async doImportThreadsBrowser() {
+        if (!WasmHelper.supportsWasmThreads() || !(await WasmHelper.importWasmBrowser('worker-wasm-mt.wasm'))) {
+            return false;
+        }
+        // The wasm threads are web workers that load this script again.
+        WasmHelper._global.Module.mainScriptUrlOrBlob = WasmHelper._adjustScriptPath('worker-wasm-mt.js');
+        return WasmHelper._importWasmScriptBrowser('worker-wasm-mt.js', '{WORKER_WASM_MT_HASH}');
+    }
+
+    /**
+     * Whether wasm threads can be used: they need a shared memory, which browsers only allow on cross-origin
+     * isolated pages. worker-wasm-mt.wasm is built with SIMD as well.
+     * @returns {boolean}
+     */
+    static supportsWasmThreads() {
+        const global = WasmHelper._global;
+        if (!global.WebAssembly || typeof SharedArrayBuffer === 'undefined' || global.crossOriginIsolated !== true
+            || !WasmHelper.supportsWasmSimd()) {
+            return false;
+        }
+        try {
+            return new WebAssembly.Memory({initial: 1, maximum: 1, shared: true}).buffer instanceof SharedArrayBuffer;
+        } catch (e) {
+            return false;
+        }
+    }
+
+    /**
+     * Whether the engine implements 128-bit WebAssembly SIMD, which worker-wasm-simd.wasm is built for.
+     * @returns {boolean}
+     */
+    static supportsWasmSimd() {
+        if (typeof WasmHelper._wasmSimd !== 'boolean') {
+            try {
+                WasmHelper._wasmSimd = !!WasmHelper._global.WebAssembly
+                    && WebAssembly.validate(new Uint8Array(WasmHelper.WASM_SIMD_PROBE));
+            } catch (e) {
+                WasmHelper._wasmSimd = false;
+            }
+        }
+        return WasmHelper._wasmSimd;
+    }
+
     /**
      * @param {string} wasm
      * @param {string} module
@@ -41,12 +110,19 @@ class WasmHelper {
             return Promise.resolve(false);
         }
 
+        if (await WasmHelper._compileWasmStreaming(wasm, module)) return true;
+
         return new Promise((resolve) => {
             try {
                 const xhr = new XMLHttpRequest();
                 xhr.open('GET', wasm, true);
                 xhr.responseType = 'arraybuffer';
                 xhr.onload = function () {
+                    if (xhr.status >= 400) {
+                        Log.w(WasmHelper, `Failed to access WebAssembly module ${wasm}: ${xhr.status}`);
+                        resolve(false);
+                        return;
+                    }
                     WasmHelper._global[module] = WasmHelper._global[module] || {};
                     WasmHelper._global[module].wasmBinary = xhr.response;
                     resolve(true);
@@ -63,6 +139,36 @@ class WasmHelper {
         });
     }
 
+    /**
+     * Compiles the module while it is downloaded and hands it to the emscripten runtime through its
+     * instantiateWasm hook. Needs the server to send the module as application/wasm. If the instantiation
+     * fails, the hook calls the module's onInstantiateFailed, which makes importScriptBrowser reject.
+     * @param {string} wasm
+     * @param {string} module
+     * @returns {Promise.<boolean>} False if the module has to be loaded with importWasmBrowser's XHR instead.
+     * @private
+     */
+    static async _compileWasmStreaming(wasm, module) {
+        if (typeof WebAssembly.compileStreaming !== 'function' || typeof fetch !== 'function') return false;
+        try {
+            const compiled = await WebAssembly.compileStreaming(fetch(wasm, {credentials: 'same-origin'}));
+            const settings = WasmHelper._global[module] = WasmHelper._global[module] || {};
+            settings.instantiateWasm = (imports, receiveInstance) => {
+                WebAssembly.instantiate(compiled, imports)
+                    .then((instance) => receiveInstance(instance, compiled))
+                    .catch((e) => {
+                        Log.e(WasmHelper, `Failed to instantiate WebAssembly module ${wasm}: ${e}`);
+                        if (typeof settings.onInstantiateFailed === 'function') settings.onInstantiateFailed(e);
+                    });
+                return {};
+            };
+            return true;
+        } catch (e) {
+            Log.d(WasmHelper, `No streaming compilation for WebAssembly module ${wasm}: ${e}`);
+            return false;
+        }
+    }
+
     static async importScript(script, module = 'Module') {
         return WasmHelper.importScriptBrowser(script, module);
     }
@@ -73,8 +179,9 @@ class WasmHelper {
 
         const moduleSettings = WasmHelper._global[module] || {};
         return new Promise(async (resolve, reject) => {
-            const runtimeInitialized = new Promise((resolve) => {
+            const runtimeInitialized = new Promise((resolve, reject) => {
                 moduleSettings.onRuntimeInitialized = () => resolve(true);
+                moduleSettings.onInstantiateFailed = reject;
             });
             if (typeof importScripts === 'function') {
                 await new Promise((resolve) => {
@@ -94,7 +201,12 @@ class WasmHelper {
                 reject('No way to load scripts.');
                 return;
             }
-            await runtimeInitialized;
+            try {
+                await runtimeInitialized;
+            } catch (e) {
+                reject(e);
+                return;
+            }
             if (moduleSettings.asm && !WasmHelper._global[module].asm) WasmHelper._global[module] = moduleSettings;
             resolve(true);
         });
@@ -112,7 +224,7 @@ class WasmHelper {
         const script = document.createElement('script');
         script.type = 'text/javascript';
         script.src = url;
-        if (integrity != null) {
+        if (integrity) {
             script.integrity = integrity;
             script.crossOrigin = 'anonymous';
         }
@@ -137,5 +249,10 @@ class WasmHelper {
 }
 
 WasmHelper._moduleLoadedCallbacks = {};
+/**
+ * A module with a single function that uses i8x16.splat and i8x16.popcnt; it only validates with SIMD support.
+ * @type {Array.<number>}
+ */
+WasmHelper.WASM_SIMD_PROBE = [0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11];
 
 Class.register(WasmHelper);
@@ -0,0 +1,83 @@
+/**
+ * Runs the parts of block body validation that do not depend on the accounts in the native addon:
+ * the serialized body is parsed once, its transactions are hashed and their basic signature proofs
+ * verified on the threads of the crypto pool, and the order of the transactions and the body hash
+ * are checked. The results are stored in the caches of the body and its transactions, so that
+ * BlockBody.verify() and BlockBody.hash() only do the remaining account type checks.
+ */
+class NativeBlockBodyValidator {
+    /**
+     * @param {BlockBody} body
+     * @param {number} [networkId]
+     * @param {NativeCryptoPool.Priority} [priority]
+     * @returns {Promise.<boolean>} False if the body is invalid. Otherwise it still has to be verified.
+     */
+    static async prevalidate(body, networkId = GenesisConfig.NETWORK_ID, priority = NativeCryptoPool.Priority.CONSENSUS) {
+        const transactions = body.transactions;
+        const report = new Uint8Array(NativeBlockBodyValidator.reportSize(transactions.length));
+        // A received body is parsed in the buffer it arrived in. The serialized fees may differ from
+        // what serialize() writes, but the native code derives them like Transaction.unserialize().
+        const serialized = body._serialized || body.serialize();
+        const result = await new Promise((resolve) => {
+            NodeNative.node_block_body_prevalidate_async(resolve, serialized, networkId, report, priority);
+        });
+
+        switch (result) {
+            case NativeBlockBodyValidator.Result.OK:
+                break;
+            case NativeBlockBodyValidator.Result.UNORDERED:
+                Log.w(BlockBody, 'Invalid block - transactions not ordered.');
+                return false;
+            case NativeBlockBodyValidator.Result.INVALID_TRANSACTION:
+                Log.w(BlockBody, 'Invalid block - invalid transaction');
+                return false;
+            default:
+                Log.w(BlockBody, 'Invalid block - malformed body');
+                return false;
+        }
+
+        const hashSize = Hash.getSize(Hash.Algorithm.BLAKE2B);
+        const statusOffset = hashSize * (transactions.length + 1);
+        for (let i = 0; i < transactions.length; i++) {
+            const offset = hashSize * (i + 1);
+            transactions[i]._hash = new Hash(report.slice(offset, offset + hashSize));
+            if (report[statusOffset + i] === NativeBlockBodyValidator.TransactionStatus.VALID) {
+                transactions[i]._signatureProofValid = true;
+            }
+        }
+        // The leaf hashes of pruned accounts are left to JS.
+        if (body.prunedAccounts.length === 0) {
+            body._hash = new Hash(report.slice(0, hashSize));
+        }
+        return true;
+    }
+
+    /**
+     * @param {number} count Number of transactions.
+     * @returns {number}
+     */
+    static reportSize(count) {
+        // Body hash, transaction hashes and one status byte per transaction, see src/native/block_body.h.
+        return Hash.getSize(Hash.Algorithm.BLAKE2B) * (count + 1) + count;
+    }
+}
+
+/**
+ * Must match src/native/block_body.h.
+ * @enum {number}
+ */
+NativeBlockBodyValidator.Result = {
+    OK: 0,
+    MALFORMED: 1,
+    UNORDERED: 2,
+    INVALID_TRANSACTION: 3
+};
+/**
+ * @enum {number}
+ */
+NativeBlockBodyValidator.TransactionStatus = {
+    INVALID: 0,
+    VALID: 1,
+    UNCHECKED: 2
+};
+Class.register(NativeBlockBodyValidator);
@@ -0,0 +1,111 @@
+/**
+ * Dedicated thread pool of the native addon that runs the asynchronous crypto bindings, so that
+ * mining and batch verification do not compete with file system and DNS requests for the libuv
+ * thread pool. Jobs of a higher priority class are always started before jobs of a lower one.
+ */
+class NativeCryptoPool {
+    /**
+     * Sets the number of pool threads. Must be called before the first asynchronous job is
+     * submitted.
+     * @param {number} threads Number of threads, 0 to use one per core.
+     * @returns {boolean} Whether the pool could still be configured.
+     */
+    static configure(threads) {
+        return NodeNative.node_crypto_pool_configure(threads);
+    }
+
+    /**
+     * @returns {{threads: number, running: number, queued: Array.<number>, completed: Array.<number>, busyTime: number, uptime: number}}
+     * Queue lengths and completed jobs are indexed by NativeCryptoPool.Priority, times are in seconds.
+     */
+    static get stats() {
+        return NodeNative.node_crypto_pool_stats();
+    }
+
+    /**
+     * Fraction of the pool's thread time spent running jobs since it was started.
+     * @returns {number}
+     */
+    static get utilization() {
+        const stats = NativeCryptoPool.stats;
+        return stats.uptime > 0 ? stats.busyTime / (stats.uptime * stats.threads) : 0;
+    }
+
+    /**
+     * @param {Uint8Array} input
+     * @param {NativeCryptoPool.Priority} [priority]
+     * @returns {Promise.<Uint8Array>}
+     */
+    static computeArgon2d(input, priority = NativeCryptoPool.Priority.CONSENSUS) {
+        return new Promise((resolve, reject) => {
+            const out = new Uint8Array(Hash.getSize(Hash.Algorithm.ARGON2D));
+            NodeNative.node_argon2_async((res) => {
+                if (res !== 0) {
+                    reject(res);
+                } else {
+                    resolve(out);
+                }
+            }, out, input, 512, priority);
+        });
+    }
+
+    /**
+     * @param {Uint8Array} input
+     * @param {NativeCryptoPool.Priority} [priority]
+     * @returns {Promise.<Uint8Array>}
+     */
+    static computeBlake2b(input, priority = NativeCryptoPool.Priority.CONSENSUS) {
+        return new Promise((resolve) => {
+            const out = new Uint8Array(Hash.getSize(Hash.Algorithm.BLAKE2B));
+            NodeNative.node_blake2_async(() => resolve(out), out, input, priority);
+        });
+    }
+
+    /**
+     * @param {Uint8Array} input
+     * @param {NativeCryptoPool.Priority} [priority]
+     * @returns {Promise.<Uint8Array>}
+     */
+    static computeSha256(input, priority = NativeCryptoPool.Priority.CONSENSUS) {
+        return new Promise((resolve) => {
+            const out = new Uint8Array(Hash.getSize(Hash.Algorithm.SHA256));
+            NodeNative.node_sha256_async(() => resolve(out), out, input, priority);
+        });
+    }
+
+    /**
+     * @param {Uint8Array} signature
+     * @param {Uint8Array} message
+     * @param {Uint8Array} publicKey
+     * @param {NativeCryptoPool.Priority} [priority]
+     * @returns {Promise.<boolean>}
+     */
+    static verifySchnorr(signature, message, publicKey, priority = NativeCryptoPool.Priority.CONSENSUS) {
+        return new Promise((resolve) => {
+            NodeNative.node_secp256k1_schnorr_verify_async((res) => resolve(!!res), signature, message, publicKey, priority);
+        });
+    }
+
+    /**
+     * @param {Uint8Array} signature DER encoded ECDSA signature
+     * @param {Uint8Array} message Message, hashed with SHA-256 before verification
+     * @param {Uint8Array} publicKey
+     * @param {NativeCryptoPool.Priority} [priority]
+     * @returns {Promise.<boolean>}
+     */
+    static verifyEcdsa(signature, message, publicKey, priority = NativeCryptoPool.Priority.CONSENSUS) {
+        return new Promise((resolve) => {
+            NodeNative.node_secp256k1_verify_async((res) => resolve(!!res), signature, message, publicKey, priority);
+        });
+    }
+}
+
+/**
+ * @enum {number}
+ */
+NativeCryptoPool.Priority = {
+    CONSENSUS: 0,
+    MEMPOOL: 1,
+    MINING: 2
+};
+Class.register(NativeCryptoPool);
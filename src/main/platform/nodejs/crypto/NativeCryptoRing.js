@@ -0,0 +1,236 @@
+/**
+ * Request ring in a SharedArrayBuffer that is drained by a native consumer thread, for callers that
+ * submit many small requests (e.g. mempool signature checks). Requests are written into the shared
+ * memory and published with an atomic store; there is no native call per request, only one to wake
+ * the consumer when it went to sleep and one completion callback per batch the consumer ran.
+ *
+ * Requests complete in submission order. The ring should be closed to release its thread; a ring that
+ * is garbage collected without being closed stops its thread as well.
+ */
+class NativeCryptoRing {
+    /**
+     * @param {number} [slots] Maximum number of requests in flight.
+     * @param {number} [dataSize] Size in bytes of the area holding request data and results.
+     * @param {NativeCryptoPool.Priority} [priority] Priority of the pool threads helping with large batches.
+     */
+    constructor(slots = NativeCryptoRing.DEFAULT_SLOTS, dataSize = NativeCryptoRing.DEFAULT_DATA_SIZE, priority = NativeCryptoPool.Priority.MEMPOOL) {
+        const headerSize = NativeCryptoRing.HEADER_WORDS * Uint32Array.BYTES_PER_ELEMENT;
+        const slotsSize = slots * CryptoJobList.JOB_WORDS * Uint32Array.BYTES_PER_ELEMENT;
+        const buffer = new SharedArrayBuffer(headerSize + slotsSize + dataSize);
+
+        /** @type {Uint32Array} */
+        this._header = new Uint32Array(buffer, 0, NativeCryptoRing.HEADER_WORDS);
+        /** @type {Uint32Array} */
+        this._slots = new Uint32Array(buffer, headerSize, slots * CryptoJobList.JOB_WORDS);
+        /** @type {Uint8Array} */
+        this._data = new Uint8Array(buffer, headerSize + slotsSize, dataSize);
+        /** @type {number} */
+        this._slotCount = slots;
+
+        // Sequence numbers wrap around at 2^32 like the native counters, so that both map a request
+        // to the same slot.
+        /** @type {number} */
+        this._submitted = 0;
+        /** @type {number} */
+        this._completed = 0;
+        /**
+         * Requests in flight, indexed by their sequence number modulo the number of slots.
+         * @type {Array.<{resolve: function(*), type: number, outputOffset: number, dataEnd: number}>}
+         */
+        this._inFlight = new Array(slots);
+        /**
+         * Requests waiting for a free slot or data space.
+         * @type {LinkedList.<{type: number, parts: Array.<Uint8Array>, size: number, resolve: function(*), reject: function(*)}>}
+         */
+        this._backlog = new LinkedList();
+
+        // Positions in the data area, counted in bytes written since the ring was created.
+        /** @type {number} */
+        this._dataHead = 0;
+        /** @type {number} */
+        this._dataTail = 0;
+
+        // The native callback must not keep the ring alive, otherwise it would never be collected.
+        const ring = new WeakRef(this);
+        this._handle = NodeNative.node_crypto_ring_create(() => {
+            const self = ring.deref();
+            if (self) self._onComplete();
+        }, this._header, this._slots, this._data, priority);
+    }
+
+    /**
+     * @param {Uint8Array} signature
+     * @param {Uint8Array} message
+     * @param {Uint8Array} publicKey Compressed public key.
+     * @returns {Promise.<boolean>}
+     */
+    verifySchnorr(signature, message, publicKey) {
+        return this._request(CryptoJobList.Type.SCHNORR_VERIFY, [message, signature, publicKey]);
+    }
+
+    /**
+     * @param {Hash.Algorithm} algorithm
+     * @param {Uint8Array} input
+     * @returns {Promise.<Uint8Array>}
+     */
+    hash(algorithm, input) {
+        return this._request(algorithm, [input]);
+    }
+
+    /**
+     * Stops the consumer thread. Requests that did not complete yet are rejected. Does not block:
+     * the thread finishes the batch it is running in the background and is joined afterwards.
+     * @returns {void}
+     */
+    close() {
+        if (!this._handle) return;
+        NodeNative.node_crypto_ring_close(this._handle);
+        this._handle = null;
+        this._resolveCompleted();
+
+        const error = new Error('Crypto ring closed');
+        for (; this._completed !== this._submitted; this._completed = (this._completed + 1) >>> 0) {
+            this._inFlight[this._completed % this._slotCount].reject(error);
+            this._inFlight[this._completed % this._slotCount] = undefined;
+        }
+        for (const request of this._backlog) {
+            request.reject(error);
+        }
+        this._backlog.clear();
+    }
+
+    /** @type {number} */
+    get pending() {
+        return this._inFlightCount() + this._backlog.length;
+    }
+
+    /**
+     * @param {number} type
+     * @param {Array.<Uint8Array>} parts Message, signature and public key, or the hash input.
+     * @returns {Promise.<boolean|Uint8Array>}
+     * @private
+     */
+    _request(type, parts) {
+        if (!this._handle) return Promise.reject(new Error('Crypto ring closed'));
+        let size = type === CryptoJobList.Type.SCHNORR_VERIFY ? 1 : Hash.getSize(type);
+        for (const part of parts) size += part.length;
+        if (size > this._data.length) return Promise.reject(new Error('Request exceeds the crypto ring data size'));
+
+        return new Promise((resolve, reject) => {
+            const request = {type, parts, size, resolve, reject};
+            if (this._backlog.length > 0 || !this._submit(request)) {
+                this._backlog.push(request);
+            }
+        });
+    }
+
+    /**
+     * Writes a request into the ring, fails if there is no free slot or data space.
+     * @param {{type: number, parts: Array.<Uint8Array>, size: number, resolve: function(*), reject: function(*)}} request
+     * @returns {boolean}
+     * @private
+     */
+    _submit(request) {
+        if (this._inFlightCount() >= this._slotCount) return false;
+        const offset = this._allocate(request.size);
+        if (offset < 0) return false;
+
+        const job = [request.type, offset, request.parts[0].length, 0, 0, 0];
+        let position = offset;
+        for (let i = 0; i < request.parts.length; ++i) {
+            this._data.set(request.parts[i], position);
+            // Signature and public key offsets of verification jobs.
+            if (i > 0) job[2 + i] = position;
+            position += request.parts[i].length;
+        }
+        job[5] = position;
+
+        const index = this._submitted % this._slotCount;
+        this._slots.set(job, index * CryptoJobList.JOB_WORDS);
+        this._inFlight[index] = {resolve: request.resolve, reject: request.reject, type: request.type, outputOffset: position, dataEnd: this._dataHead};
+
+        if (this._submitted === this._completed) {
+            NodeNative.node_crypto_ring_ref(this._handle, true);
+        }
+        this._submitted = (this._submitted + 1) >>> 0;
+        Atomics.store(this._header, NativeCryptoRing.Header.SUBMITTED, this._submitted);
+        if (Atomics.load(this._header, NativeCryptoRing.Header.SLEEPING) !== 0) {
+            NodeNative.node_crypto_ring_notify(this._handle);
+        }
+        return true;
+    }
+
+    /**
+     * @returns {number}
+     * @private
+     */
+    _inFlightCount() {
+        return (this._submitted - this._completed) >>> 0;
+    }
+
+    /**
+     * Reserves a contiguous range of the data area.
+     * @param {number} size
+     * @returns {number} Offset of the range, -1 if there is not enough free space.
+     * @private
+     */
+    _allocate(size) {
+        const position = this._dataHead % this._data.length;
+        // Ranges do not wrap around, the rest of the area is skipped instead.
+        const padding = position + size > this._data.length ? this._data.length - position : 0;
+        if (this._dataHead + padding + size - this._dataTail > this._data.length) return -1;
+        this._dataHead += padding + size;
+        return padding > 0 ? 0 : position;
+    }
+
+    /**
+     * @private
+     */
+    _onComplete() {
+        // A completion may still be delivered after close() settled all requests.
+        if (!this._handle) return;
+        this._resolveCompleted();
+
+        while (this._backlog.length > 0 && this._submit(this._backlog.first)) {
+            this._backlog.shift();
+        }
+        if (this._submitted === this._completed) {
+            NodeNative.node_crypto_ring_ref(this._handle, false);
+        }
+    }
+
+    /**
+     * Resolves the requests the consumer completed since the last call.
+     * @private
+     */
+    _resolveCompleted() {
+        const completed = Atomics.load(this._header, NativeCryptoRing.Header.COMPLETED);
+        while (this._completed !== completed && this._completed !== this._submitted) {
+            const index = this._completed % this._slotCount;
+            const request = this._inFlight[index];
+            this._inFlight[index] = undefined;
+            this._completed = (this._completed + 1) >>> 0;
+            this._dataTail = request.dataEnd;
+
+            if (request.type === CryptoJobList.Type.SCHNORR_VERIFY) {
+                request.resolve(this._data[request.outputOffset] === 1);
+            } else {
+                request.resolve(this._data.slice(request.outputOffset, request.outputOffset + Hash.getSize(request.type)));
+            }
+        }
+    }
+}
+
+/**
+ * Words of the ring header, must match src/native/crypto_ring.h.
+ * @enum {number}
+ */
+NativeCryptoRing.Header = {
+    SUBMITTED: 0,
+    COMPLETED: 1,
+    SLEEPING: 2
+};
+NativeCryptoRing.HEADER_WORDS = 4;
+NativeCryptoRing.DEFAULT_SLOTS = 4096;
+NativeCryptoRing.DEFAULT_DATA_SIZE = 1024 * 1024; // 1 MB
+Class.register(NativeCryptoRing);
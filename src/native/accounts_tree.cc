@@ -0,0 +1,434 @@
+#include "accounts_tree.h"
+
+#include <string.h>
+
+extern "C" {
+#include "krypton_native.h"
+}
+
+#define ADDRESS_NIBBLES (2 * ACCOUNTS_TREE_ADDRESS_SIZE)
+
+static const char HEX[] = "0123456789abcdef";
+
+static int from_hex(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+static std::string to_hex(const uint8_t* nibbles, size_t length) {
+    std::string hex(length, '0');
+    for (size_t i = 0; i < length; ++i) hex[i] = HEX[nibbles[i]];
+    return hex;
+}
+
+// Writes nibbles as a var length string, see SerialBuffer.writeVarLengthString().
+static void write_nibbles(std::vector<uint8_t>& out, const uint8_t* nibbles, size_t length) {
+    out.push_back((uint8_t) length);
+    for (size_t i = 0; i < length; ++i) out.push_back((uint8_t) HEX[nibbles[i]]);
+}
+
+// Reads a var length string of hex digits, appending them to nibbles.
+static bool read_nibbles(const std::vector<uint8_t>& data, size_t& pos, AccountsTrie::Nibbles& nibbles) {
+    if (pos >= data.size()) return false;
+    size_t length = data[pos++];
+    if (pos + length > data.size()) return false;
+    for (size_t i = 0; i < length; ++i) {
+        int nibble = from_hex(data[pos++]);
+        if (nibble < 0) return false;
+        nibbles.push_back((uint8_t) nibble);
+    }
+    return true;
+}
+
+static size_t common_prefix(const AccountsTrie::Nibbles& a, const AccountsTrie::Nibbles& b) {
+    size_t i = 0;
+    while (i < a.size() && i < b.size() && a[i] == b[i]) ++i;
+    return i;
+}
+
+AccountsTrie::AccountsTrie(Loader loader) : loader(loader) {}
+
+bool AccountsTrie::Init() {
+    root = Load(Nibbles());
+    return root != NULL;
+}
+
+std::unique_ptr<AccountsTrie::Node> AccountsTrie::Load(const Nibbles& prefix) {
+    std::vector<uint8_t> data;
+    if (!loader(to_hex(prefix.data(), prefix.size()), data)) return NULL;
+    std::unique_ptr<Node> node(new Node());
+    // Only branch nodes are descended into, terminal nodes are replaced without loading them.
+    if (!Parse(data, *node) || node->type != ACCOUNTS_TREE_BRANCH || node->prefix != prefix) return NULL;
+    return node;
+}
+
+// Parses a branch node, see AccountsTreeNode.unserialize().
+bool AccountsTrie::Parse(const std::vector<uint8_t>& data, Node& node) {
+    size_t pos = 0;
+    if (data.empty()) return false;
+    node.type = data[pos++];
+    if (!read_nibbles(data, pos, node.prefix)) return false;
+    if (node.type != ACCOUNTS_TREE_BRANCH) return true;
+
+    if (pos >= data.size()) return false;
+    size_t count = data[pos++];
+    for (size_t i = 0; i < count; ++i) {
+        Nibbles prefix = node.prefix;
+        if (!read_nibbles(data, pos, prefix) || prefix.size() == node.prefix.size()) return false;
+        if (prefix.size() > ADDRESS_NIBBLES || pos + ACCOUNTS_TREE_HASH_SIZE > data.size()) return false;
+        Child& child = node.children[prefix[node.prefix.size()]];
+        child.present = true;
+        child.prefix.swap(prefix);
+        memcpy(child.hash, &data[pos], ACCOUNTS_TREE_HASH_SIZE);
+        pos += ACCOUNTS_TREE_HASH_SIZE;
+    }
+    return pos == data.size();
+}
+
+// Follows AccountsTree._insert(): descends along the matching children, splits a child whose
+// prefix only partly matches the address, and replaces or removes the terminal node.
+bool AccountsTrie::Put(const uint8_t* address, const uint8_t* account, size_t account_length) {
+    Nibbles key(ADDRESS_NIBBLES);
+    for (size_t i = 0; i < ACCOUNTS_TREE_ADDRESS_SIZE; ++i) {
+        key[2 * i] = address[i] >> 4;
+        key[2 * i + 1] = address[i] & 0x0f;
+    }
+    const bool remove = account_length == 0;
+    auto terminal = [&]() {
+        std::unique_ptr<Node> node(new Node());
+        node->type = ACCOUNTS_TREE_TERMINAL;
+        node->prefix = key;
+        node->account.assign(account, account + account_length);
+        node->dirty = true;
+        return node;
+    };
+
+    std::vector<Node*> path;
+    Node* node = root.get();
+    while (true) {
+        path.push_back(node);
+        const uint8_t index = key[node->prefix.size()];
+        Child& child = node->children[index];
+
+        // No matching child: add the account as a new child of this node.
+        if (!child.present) {
+            if (remove) return true;
+            child.present = true;
+            child.prefix = key;
+            child.node = terminal();
+            break;
+        }
+
+        // The child prefix only partly matches: insert a new branch node above it.
+        const size_t common = common_prefix(child.prefix, key);
+        if (common < child.prefix.size()) {
+            if (remove) return true;
+            std::unique_ptr<Node> branch(new Node());
+            branch->type = ACCOUNTS_TREE_BRANCH;
+            branch->prefix.assign(key.begin(), key.begin() + common);
+            branch->dirty = true;
+            branch->children[child.prefix[common]] = std::move(child);
+            Child& added = branch->children[key[common]];
+            added.present = true;
+            added.prefix = key;
+            added.node = terminal();
+
+            child = Child();
+            child.present = true;
+            child.prefix = branch->prefix;
+            child.node = std::move(branch);
+            break;
+        }
+
+        // The child is the account's terminal node.
+        if (child.prefix.size() == ADDRESS_NIBBLES) {
+            if (remove) {
+                removed.insert(child.prefix);
+                child = Child();
+                Prune(path);
+                return true;
+            }
+            child.node = terminal();
+            break;
+        }
+
+        // Descend into the child branch node.
+        if (!child.node) {
+            child.node = Load(child.prefix);
+            if (!child.node) return false;
+        }
+        node = child.node.get();
+    }
+
+    for (Node* n : path) n->dirty = true;
+    return true;
+}
+
+// Follows AccountsTree._prune() after a child of the last node in path was removed: a branch
+// node left with a single child is replaced by that child in its parent.
+void AccountsTrie::Prune(std::vector<Node*>& path) {
+    for (size_t i = path.size(); i-- > 0; ) {
+        Node* node = path[i];
+        size_t count = 0;
+        uint8_t last = 0;
+        for (uint8_t j = 0; j < 16; ++j) {
+            if (node->children[j].present) {
+                ++count;
+                last = j;
+            }
+        }
+
+        // The root node is kept even if it has no children left.
+        if (i == 0 || count > 1) {
+            for (size_t j = 0; j <= i; ++j) path[j]->dirty = true;
+            return;
+        }
+
+        // Moving the remaining child into the parent destroys the node, so take what is still
+        // needed first.
+        removed.insert(node->prefix);
+        Node* parent = path[i - 1];
+        Child& slot = parent->children[node->prefix[parent->prefix.size()]];
+        if (count == 1) {
+            Child remaining = std::move(node->children[last]);
+            slot = std::move(remaining);
+            for (size_t j = 0; j < i; ++j) path[j]->dirty = true;
+            return;
+        }
+        // No children left, remove the node from its parent as well.
+        slot = Child();
+    }
+}
+
+void AccountsTrie::Serialize(const Node& node, std::vector<uint8_t>& out) {
+    out.push_back(node.type);
+    write_nibbles(out, node.prefix.data(), node.prefix.size());
+    if (node.type == ACCOUNTS_TREE_TERMINAL) {
+        out.insert(out.end(), node.account.begin(), node.account.end());
+        return;
+    }
+    size_t count_pos = out.size();
+    out.push_back(0);
+    uint8_t count = 0;
+    for (const Child& child : node.children) {
+        if (!child.present) continue;
+        write_nibbles(out, child.prefix.data() + node.prefix.size(), child.prefix.size() - node.prefix.size());
+        out.insert(out.end(), child.hash, child.hash + ACCOUNTS_TREE_HASH_SIZE);
+        ++count;
+    }
+    out[count_pos] = count;
+}
+
+// Hashes the dirty children first, then the node itself, and appends it to puts.
+void AccountsTrie::Hash(Node& node, uint8_t* out, std::vector<uint8_t>& puts) {
+    for (Child& child : node.children) {
+        if (child.present && child.node && child.node->dirty) {
+            Hash(*child.node, child.hash, puts);
+        }
+    }
+
+    size_t offset = puts.size();
+    puts.resize(offset + ACCOUNTS_TREE_HASH_SIZE);
+    Serialize(node, puts);
+    krypton_blake2(&puts[offset], &puts[offset + ACCOUNTS_TREE_HASH_SIZE], puts.size() - offset - ACCOUNTS_TREE_HASH_SIZE);
+    memcpy(out, &puts[offset], ACCOUNTS_TREE_HASH_SIZE);
+    node.dirty = false;
+    written.insert(node.prefix);
+}
+
+void AccountsTrie::Finish(uint8_t* root_hash, std::vector<uint8_t>& puts, std::vector<uint8_t>& removals) {
+    if (root->dirty) {
+        Hash(*root, root_hash, puts);
+    } else {
+        std::vector<uint8_t> data;
+        Serialize(*root, data);
+        krypton_blake2(root_hash, data.data(), data.size());
+    }
+
+    // A prefix that was removed and taken again by another node in the same batch is only put.
+    for (const Nibbles& prefix : removed) {
+        if (written.count(prefix)) continue;
+        write_nibbles(removals, prefix.data(), prefix.size());
+    }
+}
+
+// Size of a hash algorithm, 0 if it is unknown. See Hash.SIZE.
+static size_t hash_size(uint8_t algorithm) {
+    switch (algorithm) {
+        case 1: case 2: case 3: case 6:
+            return 32;
+        case 4:
+            return 64;
+        case 5:
+            return 20;
+        default:
+            return 0;
+    }
+}
+
+// Size of the serialized account at data, 0 if it is malformed. See Account.unserialize().
+static size_t account_size(const uint8_t* data, size_t length) {
+    size_t size = 0;
+    if (length < 1) return 0;
+    switch (data[0]) {
+        case 0: // BasicAccount: type, balance
+            size = 17;
+            break;
+        case 1: // VestingContract: type, balance, owner, start, step blocks, step amount, total amount
+            size = 77;
+            break;
+        case 2: // HashedTimeLockedContract: type, balance, sender, recipient, algorithm, hash root,
+                // hash count, timeout, total amount
+            if (length < 58 || !hash_size(data[57])) return 0;
+            size = 79 + hash_size(data[57]);
+            break;
+        default:
+            return 0;
+    }
+    return size <= length ? size : 0;
+}
+
+// A serialized node of a chunk or proof, parsed in place.
+struct ChunkNode {
+    uint8_t type;
+    const uint8_t* prefix;
+    size_t prefix_length;
+    // The children of a branch node by index, like AccountsTreeNode._childrenSuffixes.
+    const uint8_t* suffix[16];
+    size_t suffix_length[16];
+    const uint8_t* child_hash[16];
+    uint8_t hash[ACCOUNTS_TREE_HASH_SIZE];
+};
+
+static bool read_string(const uint8_t* data, size_t length, size_t& pos, const uint8_t*& string, size_t& string_length) {
+    if (pos >= length) return false;
+    string_length = data[pos++];
+    if (string_length > length - pos) return false;
+    string = data + pos;
+    pos += string_length;
+    return true;
+}
+
+// Parses the node at pos, see AccountsTreeNode.unserialize().
+static bool parse_chunk_node(const uint8_t* data, size_t length, size_t& pos, ChunkNode& node) {
+    if (pos >= length) return false;
+    node.type = data[pos++];
+    if (!read_string(data, length, pos, node.prefix, node.prefix_length)) return false;
+    memset(node.suffix, 0, sizeof(node.suffix));
+
+    if (node.type == ACCOUNTS_TREE_TERMINAL) {
+        size_t size = account_size(data + pos, length - pos);
+        if (!size) return false;
+        pos += size;
+    } else if (node.type == ACCOUNTS_TREE_BRANCH) {
+        if (pos >= length) return false;
+        size_t count = data[pos++];
+        int last = -1;
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t* suffix;
+            size_t suffix_length;
+            if (!read_string(data, length, pos, suffix, suffix_length) || suffix_length == 0) return false;
+            // The nodes are hashed as they are, so only the order AccountsTreeNode.serialize()
+            // writes the children in is accepted.
+            int index = from_hex(suffix[0]);
+            if (index <= last || ACCOUNTS_TREE_HASH_SIZE > length - pos) return false;
+            last = index;
+            node.suffix[index] = suffix;
+            node.suffix_length[index] = suffix_length;
+            node.child_hash[index] = data + pos;
+            pos += ACCOUNTS_TREE_HASH_SIZE;
+        }
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+// Like lastPrefix >= prefix in AccountsTreeChunk.verify(); an empty last prefix is not compared.
+static bool is_ascending(const uint8_t* last, size_t last_length, const uint8_t* prefix, size_t prefix_length) {
+    if (last_length == 0) return true;
+    int cmp = memcmp(last, prefix, last_length < prefix_length ? last_length : prefix_length);
+    return cmp < 0 || (cmp == 0 && last_length < prefix_length);
+}
+
+// Index of child among the children of parent, -1 if it is none of them. See AccountsTreeNode.isChildOf().
+static int child_index(const ChunkNode& child, const ChunkNode& parent) {
+    for (int i = 0; i < 16; ++i) {
+        if (!parent.suffix[i] || child.prefix_length != parent.prefix_length + parent.suffix_length[i]) continue;
+        if (memcmp(child.prefix, parent.prefix, parent.prefix_length) == 0
+                && memcmp(child.prefix + parent.prefix_length, parent.suffix[i], parent.suffix_length[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Verifies the serialized AccountsProof at pos like AccountsProof.verify(): every node must be
+// referenced with its hash by the branch node it is a child of, up to the root. The nodes are
+// parsed first and then hashed in one go, the tree structure is checked last. Writes the hashes of
+// the count nodes and keeps the parsed nodes, the root last.
+static bool verify_proof(const uint8_t* data, size_t length, size_t& pos, uint8_t* hashes, size_t count, std::vector<ChunkNode>& nodes) {
+    if (length - pos < 2 || (size_t) ((data[pos] << 8) | data[pos + 1]) != count) return false;
+    pos += 2;
+
+    std::vector<size_t> offsets(count + 1);
+    nodes.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        offsets[i] = pos;
+        if (!parse_chunk_node(data, length, pos, nodes[i])) return false;
+    }
+    offsets[count] = pos;
+    for (size_t i = 0; i < count; ++i) {
+        krypton_blake2(nodes[i].hash, data + offsets[i], offsets[i + 1] - offsets[i]);
+        memcpy(hashes + i * ACCOUNTS_TREE_HASH_SIZE, nodes[i].hash, ACCOUNTS_TREE_HASH_SIZE);
+    }
+
+    // The proof is in post order: a branch node takes its children off the stack of the nodes
+    // that precede it.
+    std::vector<const ChunkNode*> children;
+    for (const ChunkNode& node : nodes) {
+        if (node.type == ACCOUNTS_TREE_BRANCH) {
+            while (!children.empty()) {
+                const ChunkNode& child = *children.back();
+                int index = child_index(child, node);
+                if (index < 0) break;
+                if (memcmp(node.child_hash[index], child.hash, ACCOUNTS_TREE_HASH_SIZE) != 0) return false;
+                children.pop_back();
+            }
+        }
+        children.push_back(&node);
+    }
+
+    // The last node must be the root node.
+    return children.size() == 1 && children[0]->prefix_length == 0 && children[0]->type == ACCOUNTS_TREE_BRANCH;
+}
+
+bool accounts_tree_proof_verify(const uint8_t* proof, size_t length, uint8_t* hashes, size_t count) {
+    size_t pos = 0;
+    std::vector<ChunkNode> nodes;
+    return verify_proof(proof, length, pos, hashes, count, nodes) && pos == length;
+}
+
+bool accounts_tree_chunk_verify(const uint8_t* chunk, size_t length, uint8_t* proof_hashes, size_t proof_count) {
+    size_t pos = 0;
+    if (length < 2) return false;
+    size_t count = (chunk[0] << 8) | chunk[1];
+    pos += 2;
+
+    const uint8_t* last = NULL;
+    size_t last_length = 0;
+    ChunkNode node;
+    for (size_t i = 0; i < count; ++i) {
+        if (!parse_chunk_node(chunk, length, pos, node) || node.type != ACCOUNTS_TREE_TERMINAL) return false;
+        if (!is_ascending(last, last_length, node.prefix, node.prefix_length)) return false;
+        last = node.prefix;
+        last_length = node.prefix_length;
+    }
+
+    std::vector<ChunkNode> proof;
+    if (!verify_proof(chunk, length, pos, proof_hashes, proof_count, proof) || pos != length) return false;
+    // The first node of the proof is the tail of the chunk.
+    return is_ascending(last, last_length, proof[0].prefix, proof[0].prefix_length);
+}
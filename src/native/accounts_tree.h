@@ -0,0 +1,94 @@
+#ifndef ACCOUNTS_TREE_H
+#define ACCOUNTS_TREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#define ACCOUNTS_TREE_ADDRESS_SIZE 20
+#define ACCOUNTS_TREE_HASH_SIZE 32
+// Node types, see AccountsTreeNode.BRANCH and AccountsTreeNode.TERMINAL.
+#define ACCOUNTS_TREE_BRANCH 0x00
+#define ACCOUNTS_TREE_TERMINAL 0xff
+
+// Applies a batch of account updates to the Patricia trie of AccountsTree.js and reports the
+// nodes to put into and remove from its store. Prefixes are kept as nibble arrays and are only
+// written as hex strings when a node is serialized, in the layout of AccountsTreeNode.serialize().
+//
+// The trie only lives for one batch. Branch nodes are loaded from the store when an update
+// descends into them; every other subtree is only known by the prefix and hash its parent holds.
+// Updates mark the nodes on their path dirty, and Finish() hashes each dirty node once, children
+// first, so a node shared by many updates of the batch is serialized and hashed a single time.
+class AccountsTrie {
+    public:
+        typedef std::vector<uint8_t> Nibbles;
+
+        // Loads the serialized node with the given hex prefix from the store. Returns false if the
+        // node is missing or could not be loaded.
+        typedef std::function<bool(const std::string& prefix, std::vector<uint8_t>& node)> Loader;
+
+        explicit AccountsTrie(Loader loader);
+
+        // Loads the root node, returns false if it is missing or malformed.
+        bool Init();
+
+        // Sets the serialized account stored at the address. An empty account removes the address
+        // from the tree, like Account.INITIAL does. Returns false if a node on the path is missing
+        // or malformed.
+        bool Put(const uint8_t* address, const uint8_t* account, size_t account_length);
+
+        // Hashes the dirty nodes and writes the new root hash. puts receives the changed nodes as
+        // hash (32 bytes) followed by the serialized node, removals the prefixes of the nodes that
+        // are no longer part of the tree, each as a var length string.
+        void Finish(uint8_t* root_hash, std::vector<uint8_t>& puts, std::vector<uint8_t>& removals);
+
+    private:
+        struct Node;
+
+        // A child of a branch node. The node is only set once it was loaded or changed.
+        struct Child {
+            bool present = false;
+            Nibbles prefix;
+            uint8_t hash[ACCOUNTS_TREE_HASH_SIZE];
+            std::unique_ptr<Node> node;
+        };
+
+        struct Node {
+            uint8_t type;
+            Nibbles prefix;
+            std::vector<uint8_t> account;
+            Child children[16];
+            bool dirty = false;
+        };
+
+        std::unique_ptr<Node> Load(const Nibbles& prefix);
+        bool Parse(const std::vector<uint8_t>& data, Node& node);
+        void Prune(std::vector<Node*>& path);
+        void Hash(Node& node, uint8_t* out, std::vector<uint8_t>& puts);
+        void Serialize(const Node& node, std::vector<uint8_t>& out);
+
+        Loader loader;
+        std::unique_ptr<Node> root;
+        std::set<Nibbles> removed;
+        std::set<Nibbles> written;
+};
+
+// Verifies a serialized AccountsProof like AccountsProof.verify(), reading the nodes in place:
+// every node must be referenced with its hash by the branch node it is a child of, up to the
+// root. Writes the hashes of the count nodes, the root last. Returns false if the proof is
+// malformed, does not verify or does not have count nodes.
+bool accounts_tree_proof_verify(const uint8_t* proof, size_t length, uint8_t* hashes, size_t count);
+
+// Verifies a serialized AccountsTreeChunk like AccountsTreeChunk.verify(), reading the nodes in
+// place: the terminal nodes and the tail of the proof must be in strictly ascending prefix order,
+// and every node of the proof must be referenced with its hash by the branch node it is a child
+// of, up to the root. Writes the hashes of the proof_count proof nodes, the root last. Returns
+// false if the chunk is malformed, does not verify or does not have proof_count proof nodes.
+bool accounts_tree_chunk_verify(const uint8_t* chunk, size_t length, uint8_t* proof_hashes, size_t proof_count);
+
+#endif
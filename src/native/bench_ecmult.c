@@ -0,0 +1,120 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include "secp256k1_native.h"
+#include "secp256k1/ecmult.h"
+#include "secp256k1/ecmult_gen.h"
+
+#define SIGN_COUNT 20000
+#define VERIFY_COUNT 20000
+#define BATCH_COUNT 100
+
+// Reports the size of the precomputed secp256k1 tables linked into this build
+// together with the throughput of the operations that use them: ecmult_gen
+// (ECMULT_GEN_PREC_BITS) for key derivation and signing, ecmult (ECMULT_WINDOW_SIZE)
+// for verification. Run `make bench-ecmult` to compare several window sizes.
+
+static long now_ms() {
+    struct timeval timecheck;
+    gettimeofday(&timecheck, NULL);
+    return (long)timecheck.tv_sec * 1000 + (long)timecheck.tv_usec / 1000;
+}
+
+static void report(const char *name, long start, long end, int count) {
+    if (end == start) end++;
+    printf("%-20s %6ldms => %ld op/s\n", name, end-start, (count*1000L)/(end-start));
+}
+
+int main() {
+    unsigned char randomize[32] = {0};
+    unsigned char seckey[32];
+    unsigned char pubkey[PUBKEY_COMPRESSED_SIZE];
+    unsigned char msghash32[32];
+    unsigned char sig[SIGNATURE_SIZE];
+    unsigned char sig64[64];
+    unsigned char batch_seckeys[BATCH_COUNT * 32];
+    unsigned char batch_pubkeys[BATCH_COUNT * PUBKEY_COMPRESSED_SIZE];
+    int siglen = 0, valid = 0;
+    long start, end;
+
+    size_t ecmult_size = 2 * ECMULT_TABLE_SIZE(ECMULT_WINDOW_SIZE) * sizeof(secp256k1_ge_storage);
+    size_t ecmult_gen_size = ECMULT_GEN_PREC_N(ECMULT_GEN_PREC_BITS) * ECMULT_GEN_PREC_G(ECMULT_GEN_PREC_BITS) * sizeof(secp256k1_ge_storage);
+    printf("ECMULT_WINDOW_SIZE=%d table: %zu bytes\n", ECMULT_WINDOW_SIZE, ecmult_size);
+    printf("ECMULT_GEN_PREC_BITS=%d table: %zu bytes\n", ECMULT_GEN_PREC_BITS, ecmult_gen_size);
+
+    secp256k1_ctx_init(randomize);
+    memset(seckey, 0x42, sizeof(seckey));
+    for (int i = 0; i < BATCH_COUNT * 32; ++i) batch_seckeys[i] = (unsigned char)(i * 7 + 1);
+    memset(msghash32, 0x17, sizeof(msghash32));
+
+    start = now_ms();
+    for (int i = 0; i < SIGN_COUNT; ++i) {
+        secp256k1_pubkey_create(pubkey, PUBKEY_COMPRESSED_SIZE, seckey);
+    }
+    end = now_ms();
+    report("pubkey_create", start, end, SIGN_COUNT);
+
+    start = end;
+    for (int i = 0; i < SIGN_COUNT; i += BATCH_COUNT) {
+        batch_seckeys[0] = i;
+        valid += secp256k1_pubkey_create_batch(batch_pubkeys, PUBKEY_COMPRESSED_SIZE, batch_seckeys, BATCH_COUNT);
+    }
+    end = now_ms();
+    report("pubkey_create_batch", start, end, SIGN_COUNT);
+    for (int i = 0; i < BATCH_COUNT; ++i) {
+        secp256k1_pubkey_create(pubkey, PUBKEY_COMPRESSED_SIZE, &batch_seckeys[i * 32]);
+        if (memcmp(pubkey, &batch_pubkeys[i * PUBKEY_COMPRESSED_SIZE], PUBKEY_COMPRESSED_SIZE) != 0) {
+            printf("pubkey_create_batch mismatch\n");
+            return 1;
+        }
+    }
+    if (valid != SIGN_COUNT / BATCH_COUNT) {
+        printf("pubkey_create_batch failed\n");
+        return 1;
+    }
+    valid = 0;
+    secp256k1_pubkey_create(pubkey, PUBKEY_COMPRESSED_SIZE, seckey);
+
+    start = end;
+    for (int i = 0; i < SIGN_COUNT; ++i) {
+        msghash32[0] = i;
+        siglen = secp256k1_sign(sig, msghash32, seckey);
+    }
+    end = now_ms();
+    report("ecdsa_sign", start, end, SIGN_COUNT);
+
+    start = end;
+    for (int i = 0; i < VERIFY_COUNT; ++i) {
+        valid += secp256k1_verify(msghash32, pubkey, sig, siglen);
+    }
+    end = now_ms();
+    report("ecdsa_verify", start, end, VERIFY_COUNT);
+    if (valid != VERIFY_COUNT) {
+        printf("ecdsa_verify failed\n");
+        return 1;
+    }
+
+    start = end;
+    for (int i = 0; i < SIGN_COUNT; ++i) {
+        msghash32[0] = i;
+        secp256k1_schnorr_sign(sig64, msghash32, 32, pubkey, seckey);
+    }
+    end = now_ms();
+    report("schnorr_sign", start, end, SIGN_COUNT);
+
+    valid = 0;
+    start = end;
+    for (int i = 0; i < VERIFY_COUNT; ++i) {
+        valid += secp256k1_schnorr_verify(sig64, msghash32, 32, pubkey);
+    }
+    end = now_ms();
+    report("schnorr_verify", start, end, VERIFY_COUNT);
+    if (valid != VERIFY_COUNT) {
+        printf("schnorr_verify failed\n");
+        return 1;
+    }
+
+    secp256k1_ctx_release();
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include "ed25519/ed25519.h"
+
+#define VERIFY_COUNT 2000
+#define SIGN_COUNT 10000
+#define MESSAGE_SIZE 64
+
+// Reports ed25519 signing and commitment throughput, which depend on the base point
+// table (see `make bench-ed25519-base`), and verification throughput.
+
+static long now_ms() {
+    struct timeval timecheck;
+    gettimeofday(&timecheck, NULL);
+    return (long)timecheck.tv_sec * 1000 + (long)timecheck.tv_usec / 1000;
+}
+
+static void report(const char *name, long start, long end, int count) {
+    if (end == start) end++;
+    printf("%-26s %6ldms => %ld op/s\n", name, end-start, (count*1000L)/(end-start));
+}
+
+int main() {
+    static unsigned char private_keys[VERIFY_COUNT * 32];
+    static unsigned char public_keys[VERIFY_COUNT * 32];
+    static unsigned char signatures[VERIFY_COUNT * 64];
+    static unsigned char messages[VERIFY_COUNT * MESSAGE_SIZE];
+    static uint32_t message_lens[VERIFY_COUNT];
+    unsigned char randomness[32];
+    unsigned char *message = messages;
+    unsigned char secret[32], commitment[32];
+    ed25519_signing_key *key;
+    int valid = 0;
+    long start, end;
+
+    srand(42);
+    for (int i = 0; i < VERIFY_COUNT * 32; ++i) private_keys[i] = rand();
+    for (int i = 0; i < (int) sizeof(randomness); ++i) randomness[i] = rand();
+    for (int i = 0; i < VERIFY_COUNT; ++i) {
+        message_lens[i] = i % (MESSAGE_SIZE + 1);
+        for (uint32_t j = 0; j < message_lens[i]; ++j) message[j] = rand();
+        ed25519_public_key_derive(public_keys + 32 * i, private_keys + 32 * i);
+        ed25519_sign(signatures + 64 * i, message, message_lens[i], public_keys + 32 * i, private_keys + 32 * i);
+        message += message_lens[i];
+    }
+
+#ifdef ED25519_BASE_WIDE
+    printf("base point table: wide comb (ED25519_BASE_WIDE)\n");
+#else
+    printf("base point table: radix 2^4 (precomp_data.h)\n");
+#endif
+
+    start = now_ms();
+    for (int i = 0; i < SIGN_COUNT; ++i) {
+        ed25519_sign(signatures, messages, MESSAGE_SIZE, public_keys, private_keys + 32 * (i % VERIFY_COUNT));
+    }
+    end = now_ms();
+    report("ed25519_sign", start, end, SIGN_COUNT);
+
+    key = ed25519_signing_key_create(private_keys);
+    start = end;
+    for (int i = 0; i < SIGN_COUNT; ++i) {
+        ed25519_signing_key_sign(signatures, messages, MESSAGE_SIZE, key);
+    }
+    end = now_ms();
+    report("ed25519_signing_key_sign", start, end, SIGN_COUNT);
+    ed25519_signing_key_destroy(key);
+
+    start = end;
+    for (int i = 0; i < SIGN_COUNT; ++i) {
+        randomness[i % 32] ^= (unsigned char) i;
+        valid += ed25519_create_commitment(secret, commitment, randomness);
+    }
+    end = now_ms();
+    report("ed25519_create_commitment", start, end, SIGN_COUNT);
+    valid -= SIGN_COUNT;
+
+    // Restore the signature overwritten above.
+    ed25519_sign(signatures, messages, message_lens[0], public_keys, private_keys);
+
+    start = now_ms();
+    message = messages;
+    for (int i = 0; i < VERIFY_COUNT; ++i) {
+        valid += ed25519_verify(signatures + 64 * i, message, message_lens[i], public_keys + 32 * i);
+        message += message_lens[i];
+    }
+    end = now_ms();
+    report("ed25519_verify", start, end, VERIFY_COUNT);
+
+    if (valid != VERIFY_COUNT) {
+        printf("ed25519_verify failed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -21,6 +21,9 @@
 
 #include "blake2.h"
 #include "blake2-impl.h"
+#if defined(__wasm_simd128__)
+#include "blamka-round-simd128.h"
+#endif
 
 static const uint64_t blake2b_IV[8] = {
     UINT64_C(0x6a09e667f3bcc908), UINT64_C(0xbb67ae8584caa73b),
@@ -163,6 +166,74 @@ int blake2b_init_key(blake2b_state *S, size_t outlen, const void *key,
     return 0;
 }
 
+#if defined(__wasm_simd128__)
+/* Same round as below on rows of four words held in two v128_t, diagonalized
+   like the BlaMka rounds of Argon2. The message words are gathered per lane. */
+#define G1_SIMD128(A0, B0, C0, D0, A1, B1, C1, D1, M0, M1)                     \
+    do {                                                                       \
+        A0 = wasm_i64x2_add(wasm_i64x2_add(A0, B0), M0);                       \
+        A1 = wasm_i64x2_add(wasm_i64x2_add(A1, B1), M1);                       \
+        D0 = wasm_rotr32_64(wasm_v128_xor(D0, A0));                            \
+        D1 = wasm_rotr32_64(wasm_v128_xor(D1, A1));                            \
+        C0 = wasm_i64x2_add(C0, D0);                                           \
+        C1 = wasm_i64x2_add(C1, D1);                                           \
+        B0 = wasm_rotr24_64(wasm_v128_xor(B0, C0));                            \
+        B1 = wasm_rotr24_64(wasm_v128_xor(B1, C1));                            \
+    } while ((void)0, 0)
+
+#define G2_SIMD128(A0, B0, C0, D0, A1, B1, C1, D1, M0, M1)                     \
+    do {                                                                       \
+        A0 = wasm_i64x2_add(wasm_i64x2_add(A0, B0), M0);                       \
+        A1 = wasm_i64x2_add(wasm_i64x2_add(A1, B1), M1);                       \
+        D0 = wasm_rotr16_64(wasm_v128_xor(D0, A0));                            \
+        D1 = wasm_rotr16_64(wasm_v128_xor(D1, A1));                            \
+        C0 = wasm_i64x2_add(C0, D0);                                           \
+        C1 = wasm_i64x2_add(C1, D1);                                           \
+        B0 = wasm_rotr63_64(wasm_v128_xor(B0, C0));                            \
+        B1 = wasm_rotr63_64(wasm_v128_xor(B1, C1));                            \
+    } while ((void)0, 0)
+
+#define M_SIMD128(s, i, j) wasm_i64x2_make((int64_t)m[(s)[i]], (int64_t)m[(s)[j]])
+
+static void blake2b_compress(blake2b_state *S, const uint8_t *block) {
+    uint64_t m[16];
+    v128_t a0, a1, b0, b1, c0, c1, d0, d1;
+    unsigned int i, r;
+
+    for (i = 0; i < 16; ++i) {
+        m[i] = load64(block + i * sizeof(m[i]));
+    }
+
+    a0 = wasm_v128_load(&S->h[0]);
+    a1 = wasm_v128_load(&S->h[2]);
+    b0 = wasm_v128_load(&S->h[4]);
+    b1 = wasm_v128_load(&S->h[6]);
+    c0 = wasm_v128_load(&blake2b_IV[0]);
+    c1 = wasm_v128_load(&blake2b_IV[2]);
+    d0 = wasm_v128_xor(wasm_v128_load(&blake2b_IV[4]), wasm_v128_load(&S->t[0]));
+    d1 = wasm_v128_xor(wasm_v128_load(&blake2b_IV[6]), wasm_v128_load(&S->f[0]));
+
+    for (r = 0; r < 12; ++r) {
+        const unsigned int *s = blake2b_sigma[r];
+
+        G1_SIMD128(a0, b0, c0, d0, a1, b1, c1, d1, M_SIMD128(s, 0, 2), M_SIMD128(s, 4, 6));
+        G2_SIMD128(a0, b0, c0, d0, a1, b1, c1, d1, M_SIMD128(s, 1, 3), M_SIMD128(s, 5, 7));
+        DIAGONALIZE(a0, b0, c0, d0, a1, b1, c1, d1);
+        G1_SIMD128(a0, b0, c0, d0, a1, b1, c1, d1, M_SIMD128(s, 8, 10), M_SIMD128(s, 12, 14));
+        G2_SIMD128(a0, b0, c0, d0, a1, b1, c1, d1, M_SIMD128(s, 9, 11), M_SIMD128(s, 13, 15));
+        UNDIAGONALIZE(a0, b0, c0, d0, a1, b1, c1, d1);
+    }
+
+    wasm_v128_store(&S->h[0], wasm_v128_xor(wasm_v128_load(&S->h[0]), wasm_v128_xor(a0, c0)));
+    wasm_v128_store(&S->h[2], wasm_v128_xor(wasm_v128_load(&S->h[2]), wasm_v128_xor(a1, c1)));
+    wasm_v128_store(&S->h[4], wasm_v128_xor(wasm_v128_load(&S->h[4]), wasm_v128_xor(b0, d0)));
+    wasm_v128_store(&S->h[6], wasm_v128_xor(wasm_v128_load(&S->h[6]), wasm_v128_xor(b1, d1)));
+}
+
+#undef G1_SIMD128
+#undef G2_SIMD128
+#undef M_SIMD128
+#else
 static void blake2b_compress(blake2b_state *S, const uint8_t *block) {
     uint64_t m[16];
     uint64_t v[16];
@@ -220,6 +291,7 @@ static void blake2b_compress(blake2b_state *S, const uint8_t *block) {
 #undef G
 #undef ROUND
 }
+#endif
 
 int blake2b_update(blake2b_state *S, const void *in, size_t inlen) {
     const uint8_t *pin = (const uint8_t *)in;
@@ -0,0 +1,121 @@
+/*
+ * BlaMka round for the WebAssembly SIMD (-msimd128) build, the counterpart of the
+ * SSSE3 path in blamka-round-opt.h written against wasm_simd128.h. A block row is
+ * held in two v128_t of two 64-bit words each, like the __m128i version.
+ */
+
+#ifndef BLAKE_ROUND_MKA_SIMD128_H
+#define BLAKE_ROUND_MKA_SIMD128_H
+
+#include "blake2-impl.h"
+
+#include <wasm_simd128.h>
+
+#define wasm_rotr32_64(x) wasm_i32x4_shuffle((x), (x), 1, 0, 3, 2)
+#define wasm_rotr24_64(x)                                                      \
+    wasm_i8x16_shuffle((x), (x), 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10)
+#define wasm_rotr16_64(x)                                                      \
+    wasm_i8x16_shuffle((x), (x), 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9)
+#define wasm_rotr63_64(x)                                                      \
+    wasm_v128_xor(wasm_u64x2_shr((x), 63), wasm_i64x2_add((x), (x)))
+
+static BLAKE2_INLINE v128_t fBlaMka(v128_t x, v128_t y) {
+    /* Gather the low halves of both words and multiply them to 64 bits, as
+       _mm_mul_epu32 does; it avoids the emulated 64x64 bit i64x2.mul. */
+    const v128_t xl = wasm_i32x4_shuffle(x, x, 0, 2, 0, 2);
+    const v128_t yl = wasm_i32x4_shuffle(y, y, 0, 2, 0, 2);
+    const v128_t z = wasm_u64x2_extmul_low_u32x4(xl, yl);
+    return wasm_i64x2_add(wasm_i64x2_add(x, y), wasm_i64x2_add(z, z));
+}
+
+#define G1(A0, B0, C0, D0, A1, B1, C1, D1)                                     \
+    do {                                                                       \
+        A0 = fBlaMka(A0, B0);                                                  \
+        A1 = fBlaMka(A1, B1);                                                  \
+                                                                               \
+        D0 = wasm_v128_xor(D0, A0);                                            \
+        D1 = wasm_v128_xor(D1, A1);                                            \
+                                                                               \
+        D0 = wasm_rotr32_64(D0);                                               \
+        D1 = wasm_rotr32_64(D1);                                               \
+                                                                               \
+        C0 = fBlaMka(C0, D0);                                                  \
+        C1 = fBlaMka(C1, D1);                                                  \
+                                                                               \
+        B0 = wasm_v128_xor(B0, C0);                                            \
+        B1 = wasm_v128_xor(B1, C1);                                            \
+                                                                               \
+        B0 = wasm_rotr24_64(B0);                                               \
+        B1 = wasm_rotr24_64(B1);                                               \
+    } while ((void)0, 0)
+
+#define G2(A0, B0, C0, D0, A1, B1, C1, D1)                                     \
+    do {                                                                       \
+        A0 = fBlaMka(A0, B0);                                                  \
+        A1 = fBlaMka(A1, B1);                                                  \
+                                                                               \
+        D0 = wasm_v128_xor(D0, A0);                                            \
+        D1 = wasm_v128_xor(D1, A1);                                            \
+                                                                               \
+        D0 = wasm_rotr16_64(D0);                                               \
+        D1 = wasm_rotr16_64(D1);                                               \
+                                                                               \
+        C0 = fBlaMka(C0, D0);                                                  \
+        C1 = fBlaMka(C1, D1);                                                  \
+                                                                               \
+        B0 = wasm_v128_xor(B0, C0);                                            \
+        B1 = wasm_v128_xor(B1, C1);                                            \
+                                                                               \
+        B0 = wasm_rotr63_64(B0);                                               \
+        B1 = wasm_rotr63_64(B1);                                               \
+    } while ((void)0, 0)
+
+/* wasm_i64x2_shuffle(X0, X1, 1, 2) is _mm_alignr_epi8(X1, X0, 8). */
+#define DIAGONALIZE(A0, B0, C0, D0, A1, B1, C1, D1)                            \
+    do {                                                                       \
+        v128_t t0 = wasm_i64x2_shuffle(B0, B1, 1, 2);                          \
+        v128_t t1 = wasm_i64x2_shuffle(B1, B0, 1, 2);                          \
+        B0 = t0;                                                               \
+        B1 = t1;                                                               \
+                                                                               \
+        t0 = C0;                                                               \
+        C0 = C1;                                                               \
+        C1 = t0;                                                               \
+                                                                               \
+        t0 = wasm_i64x2_shuffle(D0, D1, 1, 2);                                 \
+        t1 = wasm_i64x2_shuffle(D1, D0, 1, 2);                                 \
+        D0 = t1;                                                               \
+        D1 = t0;                                                               \
+    } while ((void)0, 0)
+
+#define UNDIAGONALIZE(A0, B0, C0, D0, A1, B1, C1, D1)                          \
+    do {                                                                       \
+        v128_t t0 = wasm_i64x2_shuffle(B1, B0, 1, 2);                          \
+        v128_t t1 = wasm_i64x2_shuffle(B0, B1, 1, 2);                          \
+        B0 = t0;                                                               \
+        B1 = t1;                                                               \
+                                                                               \
+        t0 = C0;                                                               \
+        C0 = C1;                                                               \
+        C1 = t0;                                                               \
+                                                                               \
+        t0 = wasm_i64x2_shuffle(D1, D0, 1, 2);                                 \
+        t1 = wasm_i64x2_shuffle(D0, D1, 1, 2);                                 \
+        D0 = t1;                                                               \
+        D1 = t0;                                                               \
+    } while ((void)0, 0)
+
+#define BLAKE2_ROUND(A0, A1, B0, B1, C0, C1, D0, D1)                           \
+    do {                                                                       \
+        G1(A0, B0, C0, D0, A1, B1, C1, D1);                                    \
+        G2(A0, B0, C0, D0, A1, B1, C1, D1);                                    \
+                                                                               \
+        DIAGONALIZE(A0, B0, C0, D0, A1, B1, C1, D1);                           \
+                                                                               \
+        G1(A0, B0, C0, D0, A1, B1, C1, D1);                                    \
+        G2(A0, B0, C0, D0, A1, B1, C1, D1);                                    \
+                                                                               \
+        UNDIAGONALIZE(A0, B0, C0, D0, A1, B1, C1, D1);                         \
+    } while ((void)0, 0)
+
+#endif /* BLAKE_ROUND_MKA_SIMD128_H */
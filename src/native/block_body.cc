@@ -0,0 +1,384 @@
+#include "block_body.h"
+
+#include <string.h>
+
+extern "C" {
+#include "krypton_native.h"
+#include "secp256k1_native.h"
+#include "keccak.h"
+}
+
+// Minimum estimated cost (in microseconds) of the work handed to each pool helper, as for
+// crypto batches.
+#define BLOCK_BODY_HELPER_COST 200
+// Rough cost of a transaction with a signature proof to verify.
+#define BLOCK_BODY_TX_COST 60
+
+#define ADDRESS_SIZE 20
+#define PUBLIC_KEY_SIZE 65
+#define SIGNATURE_SIZE 64
+#define HASH_SIZE 32
+
+#define FORMAT_BASIC 0
+#define FORMAT_EXTENDED 1
+#define ACCOUNT_TYPE_BASIC 0
+
+// Size of the content of a transaction after its data, see Transaction.serializedContentSize.
+#define CONTENT_SIZE 80
+// Offsets within the content, after the data.
+#define CONTENT_SENDER 0
+#define CONTENT_SENDER_TYPE 20
+#define CONTENT_RECIPIENT 21
+#define CONTENT_RECIPIENT_TYPE 41
+#define CONTENT_VALUE 42
+#define CONTENT_FEE 58
+#define CONTENT_VALIDITY_START_HEIGHT 74
+#define CONTENT_NETWORK_ID 78
+#define CONTENT_FLAGS 79
+
+// Must match Policy.txFee().
+#define INITIAL_TX_FEE 1000000
+#define TX_FEE_CHANGING_INTERVAL 6300000
+#define TX_FEE_CHANGING_TOTAL_NUMBER 6
+
+static uint16_t read_uint16(const uint8_t* p) {
+    return (uint16_t) ((p[0] << 8) | p[1]);
+}
+
+static uint32_t read_uint32(const uint8_t* p) {
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+static bool is_zero(const uint8_t* p, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (p[i]) return false;
+    }
+    return true;
+}
+
+// Writes the fee of a transaction as a big endian uint128. Transaction.unserialize() ignores the
+// serialized fee and derives it from the validity start height, so the content does too.
+static void write_tx_fee(uint8_t* out, uint32_t validity_start_height) {
+    uint64_t fee = 0;
+    if (validity_start_height > 1) {
+        uint32_t changing = (validity_start_height - 1) / TX_FEE_CHANGING_INTERVAL;
+        fee = 1;
+        if (changing < TX_FEE_CHANGING_TOTAL_NUMBER) {
+            fee = INITIAL_TX_FEE;
+            for (uint32_t i = 0; i < changing; ++i) fee /= 10;
+        }
+    }
+    memset(out, 0, 8);
+    for (int i = 0; i < 8; ++i) {
+        out[15 - i] = (uint8_t) (fee >> (8 * i));
+    }
+}
+
+// Size of a hash algorithm in a merkle path, 0 if it is unknown. See Hash.SIZE.
+static size_t hash_size(uint8_t algorithm) {
+    switch (algorithm) {
+        case 1: case 2: case 3: case 6:
+            return 32;
+        case 4:
+            return 64;
+        case 5:
+            return 20;
+        default:
+            return 0;
+    }
+}
+
+static int compare(const uint8_t* a, const uint8_t* b, size_t length) {
+    return memcmp(a, b, length);
+}
+
+// Same order as Transaction.compareBlockOrder(), on transaction contents.
+static int compare_block_order(const uint8_t* a, const uint8_t* b) {
+    size_t a_data_length = read_uint16(a), b_data_length = read_uint16(b);
+    const uint8_t* a_data = a + 2;
+    const uint8_t* b_data = b + 2;
+    const uint8_t* x = a_data + a_data_length;
+    const uint8_t* y = b_data + b_data_length;
+    int c;
+    if ((c = compare(x + CONTENT_RECIPIENT, y + CONTENT_RECIPIENT, ADDRESS_SIZE))) return c;
+    // Big endian integers compare like byte strings.
+    if ((c = compare(x + CONTENT_VALIDITY_START_HEIGHT, y + CONTENT_VALIDITY_START_HEIGHT, 4))) return c;
+    // Higher fees and values come first.
+    if ((c = compare(y + CONTENT_FEE, x + CONTENT_FEE, 16))) return c;
+    if ((c = compare(y + CONTENT_VALUE, x + CONTENT_VALUE, 16))) return c;
+    if ((c = compare(x + CONTENT_SENDER, y + CONTENT_SENDER, ADDRESS_SIZE))) return c;
+    if ((c = (int) x[CONTENT_RECIPIENT_TYPE] - (int) y[CONTENT_RECIPIENT_TYPE])) return c;
+    if ((c = (int) x[CONTENT_SENDER_TYPE] - (int) y[CONTENT_SENDER_TYPE])) return c;
+    if ((c = (int) x[CONTENT_FLAGS] - (int) y[CONTENT_FLAGS])) return c;
+    // Like BufferUtils.compare(), shorter data comes first.
+    if (a_data_length != b_data_length) return a_data_length < b_data_length ? -1 : 1;
+    return compare(a_data, b_data, a_data_length);
+}
+
+BlockBodyValidator::BlockBodyValidator(const uint8_t* body, size_t body_length, uint8_t network_id, uint8_t* report, size_t report_length)
+    : body(body), body_length(body_length), network_id(network_id), report(report), report_length(report_length),
+      miner_address(NULL), extra_data(NULL), extra_data_length(0), has_pruned_accounts(false), next(0), done(0) {}
+
+bool BlockBodyValidator::Parse() {
+    size_t pos = 0;
+    if (body_length < ADDRESS_SIZE + 1) return false;
+    miner_address = body;
+    extra_data_length = body[ADDRESS_SIZE];
+    extra_data = body + ADDRESS_SIZE + 1;
+    pos = ADDRESS_SIZE + 1 + extra_data_length;
+
+    if (pos + 2 > body_length) return false;
+    size_t count = read_uint16(body + pos);
+    pos += 2;
+    if (report_length != BLOCK_BODY_REPORT_SIZE(count)) return false;
+
+    transactions.reserve(count);
+    contents.reserve(count * (CONTENT_SIZE + 2));
+    for (size_t i = 0; i < count; ++i) {
+        if (!ParseTransaction(pos)) return false;
+    }
+
+    // The pruned accounts are left to JS.
+    if (pos + 2 > body_length) return false;
+    has_pruned_accounts = read_uint16(body + pos) > 0;
+    return true;
+}
+
+bool BlockBodyValidator::ParseTransaction(size_t& pos) {
+    if (pos >= body_length) return false;
+    const uint8_t* p = body + pos;
+    size_t remaining = body_length - pos;
+
+    Transaction tx = {};
+    tx.content_offset = contents.size();
+
+    if (p[0] == FORMAT_BASIC) {
+        const size_t size = 1 + PUBLIC_KEY_SIZE + ADDRESS_SIZE + 16 + 16 + 4 + 1 + SIGNATURE_SIZE;
+        if (remaining < size) return false;
+        const uint8_t* recipient = p + 1 + PUBLIC_KEY_SIZE;
+        const uint8_t* value = recipient + ADDRESS_SIZE;
+        const uint8_t* validity_start_height = value + 32;
+
+        tx.content_length = 2 + CONTENT_SIZE;
+        contents.resize(tx.content_offset + tx.content_length);
+        uint8_t* content = &contents[tx.content_offset];
+        uint8_t* x = content + 2;
+        content[0] = content[1] = 0;
+        x[CONTENT_SENDER_TYPE] = ACCOUNT_TYPE_BASIC;
+        memcpy(x + CONTENT_RECIPIENT, recipient, ADDRESS_SIZE);
+        x[CONTENT_RECIPIENT_TYPE] = ACCOUNT_TYPE_BASIC;
+        memcpy(x + CONTENT_VALUE, value, 16);
+        write_tx_fee(x + CONTENT_FEE, read_uint32(validity_start_height));
+        memcpy(x + CONTENT_VALIDITY_START_HEIGHT, validity_start_height, 4);
+        x[CONTENT_NETWORK_ID] = validity_start_height[4];
+        x[CONTENT_FLAGS] = 0;
+
+        tx.public_key = p + 1;
+        tx.merkle_path = NULL;
+        tx.merkle_path_length = 0;
+        tx.signature = validity_start_height + 5;
+        tx.check_proof = true;
+        tx.derive_sender = true;
+        pos += size;
+    } else if (p[0] == FORMAT_EXTENDED) {
+        if (remaining < 3) return false;
+        size_t data_length = read_uint16(p + 1);
+        // Data, the fields up to the flags including the serialized fee, and the proof size.
+        if (remaining < 3 + data_length + CONTENT_SIZE + 2) return false;
+        const uint8_t* x = p + 3 + data_length;
+        size_t proof_length = read_uint16(x + CONTENT_SIZE);
+        const uint8_t* proof = x + CONTENT_SIZE + 2;
+        size_t size = 3 + data_length + CONTENT_SIZE + 2 + proof_length;
+        if (remaining < size) return false;
+
+        // The serialized content only differs in the fee.
+        tx.content_length = 2 + data_length + CONTENT_SIZE;
+        contents.resize(tx.content_offset + tx.content_length);
+        uint8_t* content = &contents[tx.content_offset];
+        memcpy(content, p + 1, tx.content_length);
+        write_tx_fee(content + 2 + data_length + CONTENT_FEE, read_uint32(x + CONTENT_VALIDITY_START_HEIGHT));
+
+        if (x[CONTENT_SENDER_TYPE] == ACCOUNT_TYPE_BASIC) {
+            tx.invalid_proof = !ParseProof(tx, proof, proof_length);
+        }
+        pos += size;
+    } else {
+        return false;
+    }
+
+    // Transaction.unserialize() throws for a zero value.
+    const uint8_t* content = &contents[tx.content_offset];
+    if (is_zero(content + 2 + read_uint16(content) + CONTENT_VALUE, 16)) return false;
+
+    transactions.push_back(tx);
+    return true;
+}
+
+// Parses a SignatureProof like SignatureProof.verifyTransaction() does.
+bool BlockBodyValidator::ParseProof(Transaction& tx, const uint8_t* proof, size_t length) {
+    if (length < PUBLIC_KEY_SIZE + 1) return false;
+    tx.public_key = proof;
+    tx.merkle_path = proof + PUBLIC_KEY_SIZE;
+
+    size_t count = tx.merkle_path[0];
+    size_t pos = PUBLIC_KEY_SIZE + 1 + (count + 7) / 8;
+    bool combinable = true;
+    for (size_t i = 0; i < count; ++i) {
+        if (pos >= length) return false;
+        size_t size = hash_size(proof[pos]);
+        if (!size) return false;
+        // MerklePath.computeRoot() concatenates hashes of different sizes into a buffer sized
+        // for the node's hash, leave those paths to JS.
+        if (size != HASH_SIZE) combinable = false;
+        pos += 1 + size;
+    }
+    tx.merkle_path_length = pos - PUBLIC_KEY_SIZE;
+
+    // Overlong proofs are rejected as well.
+    if (pos + SIGNATURE_SIZE != length) return false;
+    tx.signature = proof + pos;
+    tx.check_proof = combinable;
+    return true;
+}
+
+uint8_t BlockBodyValidator::VerifyProof(const Transaction& tx, const uint8_t* content) {
+    // The signer address is the root of the merkle path over the public key hash.
+    uint8_t root[HASH_SIZE];
+    keccak256(tx.public_key + 1, PUBLIC_KEY_SIZE - 1, root);
+    if (tx.merkle_path_length) {
+        size_t count = tx.merkle_path[0];
+        const uint8_t* left_bits = tx.merkle_path + 1;
+        const uint8_t* node = left_bits + (count + 7) / 8;
+        uint8_t concat[2 * HASH_SIZE];
+        for (size_t i = 0; i < count; ++i, node += 1 + HASH_SIZE) {
+            bool left = (left_bits[i / 8] & (0x80 >> (i % 8))) != 0;
+            memcpy(concat + (left ? 0 : HASH_SIZE), node + 1, HASH_SIZE);
+            memcpy(concat + (left ? HASH_SIZE : 0), root, HASH_SIZE);
+            krypton_blake2(root, concat, sizeof(concat));
+        }
+    }
+
+    const uint8_t* sender = content + 2 + read_uint16(content) + CONTENT_SENDER;
+    if (memcmp(root + HASH_SIZE - ADDRESS_SIZE, sender, ADDRESS_SIZE) != 0) {
+        return BLOCK_BODY_TX_INVALID;
+    }
+
+    uint8_t public_key[PUBKEY_COMPRESSED_SIZE];
+    if (!secp256k1_pubkey_compress(public_key, tx.public_key)) {
+        return BLOCK_BODY_TX_INVALID;
+    }
+    return secp256k1_schnorr_verify(tx.signature, content, tx.content_length, public_key) ? BLOCK_BODY_TX_VALID : BLOCK_BODY_TX_INVALID;
+}
+
+void BlockBodyValidator::Execute(size_t index) {
+    Transaction& tx = transactions[index];
+    uint8_t* content = &contents[tx.content_offset];
+    const uint8_t* x = content + 2 + read_uint16(content);
+
+    if (tx.derive_sender) {
+        // PublicKey.toAddress()
+        uint8_t hash[HASH_SIZE];
+        keccak256(tx.public_key + 1, PUBLIC_KEY_SIZE - 1, hash);
+        memcpy(content + 2 + CONTENT_SENDER, hash + HASH_SIZE - ADDRESS_SIZE, ADDRESS_SIZE);
+    }
+    krypton_blake2(report + BLOCK_BODY_HASH_SIZE + index * BLOCK_BODY_HASH_SIZE, content, tx.content_length);
+
+    uint8_t status;
+    if (x[CONTENT_NETWORK_ID] != network_id || memcmp(x + CONTENT_SENDER, x + CONTENT_RECIPIENT, ADDRESS_SIZE) == 0 || tx.invalid_proof) {
+        status = BLOCK_BODY_TX_INVALID;
+    } else if (tx.check_proof) {
+        status = VerifyProof(tx, content);
+    } else {
+        status = BLOCK_BODY_TX_UNCHECKED;
+    }
+    report[BLOCK_BODY_HASH_SIZE + transactions.size() * BLOCK_BODY_HASH_SIZE + index] = status;
+}
+
+void BlockBodyValidator::Work() {
+    size_t count = transactions.size();
+    size_t finished = 0;
+    for (size_t i = next++; i < count; i = next++) {
+        Execute(i);
+        finished++;
+    }
+    if (finished) {
+        std::lock_guard<std::mutex> lock(done_mutex);
+        done += finished;
+        if (done == count) done_cv.notify_all();
+    }
+}
+
+void BlockBodyValidator::Wait() {
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done_cv.wait(lock, [this] { return done == transactions.size(); });
+}
+
+// Leaves are the miner address, the extra data and the transactions, see BlockBody.getMerkleLeafs().
+void BlockBodyValidator::MerkleRoot(uint8_t* out, size_t first, size_t count) {
+    if (count == 1) {
+        if (first == 0) {
+            krypton_blake2(out, miner_address, ADDRESS_SIZE);
+        } else if (first == 1) {
+            krypton_blake2(out, extra_data, extra_data_length);
+        } else {
+            memcpy(out, report + BLOCK_BODY_HASH_SIZE + (first - 2) * BLOCK_BODY_HASH_SIZE, HASH_SIZE);
+        }
+        return;
+    }
+
+    // Like MerkleTree.computeRoot(), the left half gets the middle leaf.
+    size_t mid = (count + 1) / 2;
+    uint8_t concat[2 * HASH_SIZE];
+    MerkleRoot(concat, first, mid);
+    MerkleRoot(concat + HASH_SIZE, first + mid, count - mid);
+    krypton_blake2(out, concat, sizeof(concat));
+}
+
+BlockBodyResult BlockBodyValidator::Finish() {
+    size_t count = transactions.size();
+    const uint8_t* status = report + BLOCK_BODY_HASH_SIZE + count * BLOCK_BODY_HASH_SIZE;
+    for (size_t i = 0; i < count; ++i) {
+        if (status[i] == BLOCK_BODY_TX_INVALID) return BLOCK_BODY_INVALID_TRANSACTION;
+    }
+
+    for (size_t i = 1; i < count; ++i) {
+        if (compare_block_order(&contents[transactions[i - 1].content_offset], &contents[transactions[i].content_offset]) >= 0) {
+            return BLOCK_BODY_UNORDERED;
+        }
+    }
+
+    if (!has_pruned_accounts) {
+        MerkleRoot(report, 0, count + 2);
+    }
+    return BLOCK_BODY_OK;
+}
+
+// Pool task that works on the transactions alongside the thread that owns the validator.
+class BlockBodyHelper : public CryptoPoolTask {
+    public:
+        explicit BlockBodyHelper(std::shared_ptr<BlockBodyValidator> validator) : validator(validator) {}
+
+        void Run() {
+            validator->Work();
+        }
+
+        void Done() {
+            delete this;
+        }
+
+    private:
+        std::shared_ptr<BlockBodyValidator> validator;
+};
+
+void BlockBodyValidator::Share(std::shared_ptr<BlockBodyValidator> validator, CryptoPoolPriority priority) {
+    CryptoPool& pool = CryptoPool::Instance();
+    size_t count = validator->transactions.size();
+    uint64_t helpers = (uint64_t) count * BLOCK_BODY_TX_COST / BLOCK_BODY_HELPER_COST;
+    uint32_t threads = pool.Threads();
+    if (helpers > threads - 1) helpers = threads - 1;
+    if (count > 0 && helpers > count - 1) helpers = count - 1;
+
+    for (uint64_t i = 0; i < helpers; ++i) {
+        pool.Submit(new BlockBodyHelper(validator), priority);
+    }
+}
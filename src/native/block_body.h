@@ -0,0 +1,114 @@
+#ifndef BLOCK_BODY_H
+#define BLOCK_BODY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "crypto_pool.h"
+
+// Outcome of a block body pre-validation, shared with NativeBlockBodyValidator.js.
+enum BlockBodyResult {
+    // All checks done natively passed; the report holds the transaction hashes and the body
+    // hash (unless the body has pruned accounts).
+    BLOCK_BODY_OK = 0,
+    // The body could not be parsed, or does not have the expected number of transactions.
+    BLOCK_BODY_MALFORMED = 1,
+    // The transactions are not in block order or not unique.
+    BLOCK_BODY_UNORDERED = 2,
+    // A transaction is invalid, see its status in the report.
+    BLOCK_BODY_INVALID_TRANSACTION = 3
+};
+
+// Status of a single transaction in the report.
+enum BlockBodyTransactionStatus {
+    BLOCK_BODY_TX_INVALID = 0,
+    // The network id and sender/recipient checks passed and the signature proof of the basic
+    // sender was verified.
+    BLOCK_BODY_TX_VALID = 1,
+    // The network id and sender/recipient checks passed, but the sender proof was not checked:
+    // the sender is not a basic account, or its merkle path uses a hash that JS would combine
+    // differently. JS verifies the transaction as usual.
+    BLOCK_BODY_TX_UNCHECKED = 2
+};
+
+// The report has the layout
+//   body hash (32 bytes), transaction hashes (32 bytes each), transaction status (1 byte each).
+#define BLOCK_BODY_HASH_SIZE 32
+#define BLOCK_BODY_REPORT_SIZE(count) (BLOCK_BODY_HASH_SIZE + (count) * (BLOCK_BODY_HASH_SIZE + 1))
+
+// Checks the parts of a serialized BlockBody (see BlockBody.unserialize) that do not depend on
+// the accounts: transaction hashes, basic signature proofs, network ids, the block order of the
+// transactions and the body hash. Parse() runs on the calling thread and only records where the
+// transactions are; the expensive per transaction work is claimed by any number of threads at
+// once like a CryptoBatch, and Finish() runs on the thread that waited for it.
+class BlockBodyValidator {
+    public:
+        // The body and report must stay alive and unchanged until Finish() returned.
+        BlockBodyValidator(const uint8_t* body, size_t body_length, uint8_t network_id, uint8_t* report, size_t report_length);
+
+        // Returns false if the body is malformed or the report does not fit its transactions.
+        bool Parse();
+
+        // Submits tasks that help with the transactions to the crypto pool, if there are enough
+        // of them to be worth it. The caller works on them itself as well.
+        static void Share(std::shared_ptr<BlockBodyValidator> validator, CryptoPoolPriority priority);
+
+        // Runs transactions until none is left to claim.
+        void Work();
+
+        // Blocks until every transaction has finished, including those claimed by other threads.
+        void Wait();
+
+        // Checks the order of the transactions and computes the body hash.
+        BlockBodyResult Finish();
+
+    private:
+        struct Transaction {
+            // Content as hashed and signed, see Transaction.serializeContent().
+            size_t content_offset;
+            size_t content_length;
+            // Proof parts, all pointing into the body. The public key is uncompressed.
+            const uint8_t* public_key;
+            const uint8_t* merkle_path;
+            size_t merkle_path_length;
+            const uint8_t* signature;
+            // Set if the sender is a basic account and the proof is well formed.
+            bool check_proof;
+            // Set if the proof is malformed, which makes the transaction invalid.
+            bool invalid_proof;
+            // The sender address of basic transactions is derived from the public key in Execute().
+            bool derive_sender;
+        };
+
+        bool ParseTransaction(size_t& pos);
+        bool ParseProof(Transaction& tx, const uint8_t* proof, size_t length);
+        void Execute(size_t index);
+        uint8_t VerifyProof(const Transaction& tx, const uint8_t* content);
+        void MerkleRoot(uint8_t* out, size_t first, size_t count);
+
+        const uint8_t* body;
+        size_t body_length;
+        uint8_t network_id;
+        uint8_t* report;
+        size_t report_length;
+
+        const uint8_t* miner_address;
+        const uint8_t* extra_data;
+        size_t extra_data_length;
+        bool has_pruned_accounts;
+        std::vector<Transaction> transactions;
+        std::vector<uint8_t> contents;
+
+        std::atomic<size_t> next;
+        size_t done;
+        std::mutex done_mutex;
+        std::condition_variable done_cv;
+};
+
+#endif
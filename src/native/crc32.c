@@ -0,0 +1,151 @@
+#include "crc32.h"
+
+/* Reflected IEEE polynomial. */
+#define CRC32_POLYNOMIAL 0xedb88320
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CRC32_PCLMUL
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+/* Slicing-by-8 tables: crc32_table[0] is the byte-wise table, crc32_table[k] advances a byte
+   by k more zero bytes. They are built on first use; threads racing on that write the same values. */
+static uint32_t crc32_table[8][256];
+static volatile int crc32_table_ready = 0;
+
+static void crc32_init_table(void) {
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = c & 1 ? CRC32_POLYNOMIAL ^ (c >> 1) : c >> 1;
+        }
+        crc32_table[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (int k = 1; k < 8; ++k) {
+            uint32_t c = crc32_table[k - 1][i];
+            crc32_table[k][i] = (c >> 8) ^ crc32_table[0][c & 0xff];
+        }
+    }
+    crc32_table_ready = 1;
+}
+
+static uint32_t crc32_slice8(uint32_t crc, const uint8_t *p, size_t len) {
+    while (len >= 8) {
+        /* Assembled byte by byte, so it does not depend on the host byte order or alignment. */
+        uint32_t lo = crc ^ ((uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24);
+        uint32_t hi = (uint32_t) p[4] | (uint32_t) p[5] << 8 | (uint32_t) p[6] << 16 | (uint32_t) p[7] << 24;
+        crc = crc32_table[7][lo & 0xff] ^ crc32_table[6][(lo >> 8) & 0xff]
+            ^ crc32_table[5][(lo >> 16) & 0xff] ^ crc32_table[4][lo >> 24]
+            ^ crc32_table[3][hi & 0xff] ^ crc32_table[2][(hi >> 8) & 0xff]
+            ^ crc32_table[1][(hi >> 16) & 0xff] ^ crc32_table[0][hi >> 24];
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = crc32_table[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#ifdef CRC32_PCLMUL
+/* Folding constants for the reflected polynomial, from Intel's "Fast CRC Computation for Generic
+   Polynomials Using PCLMULQDQ Instruction": x^(4*128+32), x^(4*128-32) mod P for the 4-way fold,
+   x^(128+32), x^(128-32) mod P for the single fold, x^64 mod P, and P' and P for the Barrett
+   reduction, all bit reflected. */
+static const uint64_t crc32_k1k2[2] __attribute__((aligned(16))) = {0x0154442bd4, 0x01c6e41596};
+static const uint64_t crc32_k3k4[2] __attribute__((aligned(16))) = {0x01751997d0, 0x00ccaa009e};
+static const uint64_t crc32_k5[2] __attribute__((aligned(16))) = {0x0163cd6124, 0};
+static const uint64_t crc32_poly[2] __attribute__((aligned(16))) = {0x01db710641, 0x01f7011641};
+
+/* Folds four 128 bit lanes over the input with carry-less multiplications and reduces them to
+   the CRC. len must be a multiple of 16 and at least 64. */
+__attribute__((target("sse2,pclmul")))
+static uint32_t crc32_pclmul(uint32_t crc, const uint8_t *p, size_t len) {
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    x1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) p), _mm_cvtsi32_si128((int) crc));
+    x2 = _mm_loadu_si128((const __m128i *) (p + 16));
+    x3 = _mm_loadu_si128((const __m128i *) (p + 32));
+    x4 = _mm_loadu_si128((const __m128i *) (p + 48));
+    p += 64;
+    len -= 64;
+
+    x0 = _mm_load_si128((const __m128i *) crc32_k1k2);
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *) p));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *) (p + 16)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *) (p + 32)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *) (p + 48)));
+        p += 64;
+        len -= 64;
+    }
+
+    /* Fold the four lanes into one, then the remaining 16 byte blocks into it. */
+    x0 = _mm_load_si128((const __m128i *) crc32_k3k4);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x4), x5);
+    while (len >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), _mm_loadu_si128((const __m128i *) p)), x5);
+        p += 16;
+        len -= 16;
+    }
+
+    /* 128 to 64 bits. */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0 = _mm_loadl_epi64((const __m128i *) crc32_k5);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x00), x2);
+
+    /* Barrett reduction to 32 bits. */
+    x0 = _mm_load_si128((const __m128i *) crc32_poly);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+
+static int crc32_has_pclmul(void) {
+    static int has_pclmul = -1;
+    if (has_pclmul < 0) {
+        __builtin_cpu_init();
+        has_pclmul = __builtin_cpu_supports("pclmul") ? 1 : 0;
+    }
+    return has_pclmul;
+}
+#endif
+
+uint32_t krypton_crc32(const void *in, const size_t inlen) {
+    const uint8_t *p = (const uint8_t *) in;
+    size_t len = inlen;
+    uint32_t crc = 0xffffffff;
+
+    if (!crc32_table_ready) crc32_init_table();
+
+#ifdef CRC32_PCLMUL
+    if (len >= 64 && crc32_has_pclmul()) {
+        size_t folded = len & ~(size_t) 15;
+        crc = crc32_pclmul(crc, p, folded);
+        p += folded;
+        len -= folded;
+    }
+#endif
+
+    return ~crc32_slice8(crc, p, len);
+}
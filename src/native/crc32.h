@@ -0,0 +1,10 @@
+#ifndef _KRYPTON_CRC32_H_
+#define _KRYPTON_CRC32_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CRC-32 with the IEEE polynomial (as in zlib and Ethernet), the checksum of P2P messages.
+uint32_t krypton_crc32(const void *in, const size_t inlen);
+
+#endif // _KRYPTON_CRC32_H_
@@ -0,0 +1,161 @@
+#include "crypto_batch.h"
+
+extern "C" {
+#include "krypton_native.h"
+#include "ed25519/ed25519.h"
+#include "secp256k1_native.h"
+#include "ripemd160.h"
+#include "keccak.h"
+}
+
+// Minimum estimated cost (in microseconds) of the work handed to each pool helper. Smaller
+// batches finish before a helper would have been woken up.
+#define CRYPTO_BATCH_HELPER_COST 200
+
+#define SCHNORR_SIGNATURE_SIZE 64
+#define SCHNORR_PUBLIC_KEY_SIZE 33
+#define ED25519_SIGNATURE_SIZE 64
+#define ED25519_PUBLIC_KEY_SIZE 32
+
+// Output size of a job type, 0 if the type is unknown.
+static size_t output_size(uint32_t type) {
+    switch (type) {
+        case CRYPTO_JOB_BLAKE2B:
+        case CRYPTO_JOB_ARGON2D:
+        case CRYPTO_JOB_SHA256:
+        case CRYPTO_JOB_KECCAK256:
+            return 32;
+        case CRYPTO_JOB_SHA512:
+            return 64;
+        case CRYPTO_JOB_RIPEMD160:
+            return RIPEMD160_DIGEST_SIZE;
+        case CRYPTO_JOB_SCHNORR_VERIFY:
+        case CRYPTO_JOB_ED25519_VERIFY:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static bool in_bounds(uint64_t offset, uint64_t length, size_t buffer_length) {
+    return offset + length <= buffer_length;
+}
+
+static bool is_valid(const uint32_t* job, size_t input_length, size_t output_length) {
+    uint32_t type = job[0];
+    size_t out_size = output_size(type);
+    if (!out_size || !in_bounds(job[1], job[2], input_length) || !in_bounds(job[5], out_size, output_length)) {
+        return false;
+    }
+    if (type == CRYPTO_JOB_SCHNORR_VERIFY || type == CRYPTO_JOB_ED25519_VERIFY) {
+        size_t signature_size = type == CRYPTO_JOB_SCHNORR_VERIFY ? SCHNORR_SIGNATURE_SIZE : ED25519_SIGNATURE_SIZE;
+        size_t public_key_size = type == CRYPTO_JOB_SCHNORR_VERIFY ? SCHNORR_PUBLIC_KEY_SIZE : ED25519_PUBLIC_KEY_SIZE;
+        return in_bounds(job[3], signature_size, input_length) && in_bounds(job[4], public_key_size, input_length);
+    }
+    return true;
+}
+
+long CryptoBatch::Validate(size_t input_length, size_t output_length, bool skip_invalid) {
+    long first_invalid = -1;
+    cost = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t* job = &jobs[i * CRYPTO_JOB_WORDS];
+        if (!is_valid(job, input_length, output_length)) {
+            if (!skip_invalid) return (long) i;
+            if (first_invalid < 0) first_invalid = (long) i;
+            // Execute() ignores unknown types.
+            job[0] = 0;
+            continue;
+        }
+
+        if (job[0] == CRYPTO_JOB_SCHNORR_VERIFY || job[0] == CRYPTO_JOB_ED25519_VERIFY) {
+            cost += 50;
+        } else if (job[0] == CRYPTO_JOB_ARGON2D) {
+            cost += 500;
+        } else {
+            cost += 1 + job[2] / 256;
+        }
+    }
+    return first_invalid;
+}
+
+void CryptoBatch::Execute(const uint32_t* job) {
+    const uint8_t* data = input + job[1];
+    size_t length = job[2];
+    uint8_t* out = output + job[5];
+
+    switch (job[0]) {
+        case CRYPTO_JOB_BLAKE2B:
+            krypton_blake2(out, data, length);
+            break;
+        case CRYPTO_JOB_ARGON2D:
+            krypton_argon2(out, data, length, KRYPTON_DEFAULT_ARGON2_COST);
+            break;
+        case CRYPTO_JOB_SHA256:
+            krypton_sha256(out, data, length);
+            break;
+        case CRYPTO_JOB_SHA512:
+            krypton_sha512(out, data, length);
+            break;
+        case CRYPTO_JOB_RIPEMD160:
+            ripemd160(data, length, out);
+            break;
+        case CRYPTO_JOB_KECCAK256:
+            keccak256(data, length, out);
+            break;
+        case CRYPTO_JOB_SCHNORR_VERIFY:
+            *out = secp256k1_schnorr_verify(input + job[3], (unsigned char*) data, length, input + job[4]) ? 1 : 0;
+            break;
+        case CRYPTO_JOB_ED25519_VERIFY:
+            *out = ed25519_verify(input + job[3], data, length, input + job[4]) ? 1 : 0;
+            break;
+    }
+}
+
+void CryptoBatch::Work() {
+    size_t finished = 0;
+    for (size_t i = next++; i < count; i = next++) {
+        Execute(&jobs[i * CRYPTO_JOB_WORDS]);
+        finished++;
+    }
+    if (finished) {
+        std::lock_guard<std::mutex> lock(done_mutex);
+        done += finished;
+        if (done == count) done_cv.notify_all();
+    }
+}
+
+void CryptoBatch::Wait() {
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done_cv.wait(lock, [this] { return done == count; });
+}
+
+// Pool task that works on a batch alongside the thread that owns it. It keeps the batch alive
+// since it may only be started after all jobs are done.
+class CryptoBatchHelper : public CryptoPoolTask {
+    public:
+        explicit CryptoBatchHelper(std::shared_ptr<CryptoBatch> batch) : batch(batch) {}
+
+        void Run() {
+            batch->Work();
+        }
+
+        void Done() {
+            delete this;
+        }
+
+    private:
+        std::shared_ptr<CryptoBatch> batch;
+};
+
+void CryptoBatch::Share(std::shared_ptr<CryptoBatch> batch, CryptoPoolPriority priority) {
+    CryptoPool& pool = CryptoPool::Instance();
+    uint64_t helpers = batch->cost / CRYPTO_BATCH_HELPER_COST;
+    uint32_t threads = pool.Threads();
+    if (helpers > threads - 1) helpers = threads - 1;
+    if (batch->count > 0 && helpers > batch->count - 1) helpers = batch->count - 1;
+
+    for (uint64_t i = 0; i < helpers; ++i) {
+        pool.Submit(new CryptoBatchHelper(batch), priority);
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef CRYPTO_BATCH_H
+#define CRYPTO_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "crypto_pool.h"
+
+// Job types of a crypto batch. The hash types use the values of Hash.Algorithm.
+enum CryptoJobType {
+    CRYPTO_JOB_BLAKE2B = 1,
+    CRYPTO_JOB_ARGON2D = 2,
+    CRYPTO_JOB_SHA256 = 3,
+    CRYPTO_JOB_SHA512 = 4,
+    CRYPTO_JOB_RIPEMD160 = 5,
+    CRYPTO_JOB_KECCAK256 = 6,
+    CRYPTO_JOB_SCHNORR_VERIFY = 16,
+    CRYPTO_JOB_ED25519_VERIFY = 17
+};
+
+// Every job is described by CRYPTO_JOB_WORDS uint32 words:
+//   type, data offset, data length, signature offset, public key offset, output offset.
+// Offsets are byte offsets into the shared input and output buffers. Hashes write their digest
+// to the output offset, verifications a single byte that is 1 if the signature is valid.
+#define CRYPTO_JOB_WORDS 6
+
+// A list of independent crypto jobs that is worked off by any number of threads at once: every
+// thread claims the next unstarted job until none is left, so a batch never waits for a helper
+// that the pool has not started yet.
+class CryptoBatch {
+    public:
+        // The job descriptions are copied, so that they cannot be changed after validation
+        // while the batch is running.
+        CryptoBatch(const uint32_t* jobs, size_t count, const uint8_t* input, uint8_t* output)
+            : jobs(jobs, jobs + count * CRYPTO_JOB_WORDS), count(count), input(input), output(output), cost(0), next(0), done(0) {}
+
+        CryptoBatch(std::vector<uint32_t>&& jobs, const uint8_t* input, uint8_t* output)
+            : jobs(std::move(jobs)), count(this->jobs.size() / CRYPTO_JOB_WORDS), input(input), output(output), cost(0), next(0), done(0) {}
+
+        // Checks that every job has a known type and stays within the buffers. Returns the index
+        // of the first invalid job, or -1 if the batch can be run. With skip_invalid, invalid jobs
+        // are turned into no-ops instead and the rest of the batch can still be run.
+        long Validate(size_t input_length, size_t output_length, bool skip_invalid = false);
+
+        // Submits tasks that help with the batch to the crypto pool, as many as its estimated
+        // cost is worth. The caller works on the batch itself as well.
+        static void Share(std::shared_ptr<CryptoBatch> batch, CryptoPoolPriority priority);
+
+        // Runs jobs until none is left to claim.
+        void Work();
+
+        // Blocks until every job has finished, including those claimed by other threads.
+        void Wait();
+
+    private:
+        void Execute(const uint32_t* job);
+
+        std::vector<uint32_t> jobs;
+        size_t count;
+        const uint8_t* input;
+        uint8_t* output;
+        // Rough cost of the batch in microseconds, see Validate().
+        uint64_t cost;
+
+        std::atomic<size_t> next;
+        size_t done;
+        std::mutex done_mutex;
+        std::condition_variable done_cv;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include "crypto_pool.h"
+
+CryptoPool& CryptoPool::Instance() {
+    // Never destroyed: the threads may still be running a task when the process exits.
+    static CryptoPool* pool = new CryptoPool();
+    return *pool;
+}
+
+bool CryptoPool::Configure(uint32_t threads) {
+    std::lock_guard<std::mutex> lock(start_mutex);
+    if (started) return false;
+    num_threads = threads;
+    return true;
+}
+
+void CryptoPool::Start() {
+    std::lock_guard<std::mutex> lock(start_mutex);
+    if (started) return;
+
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+        if (num_threads == 0) num_threads = 1;
+    }
+    for (int p = 0; p < CRYPTO_POOL_PRIORITIES; ++p) {
+        queued[p] = 0;
+        completed[p] = 0;
+    }
+    start_time = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        workers.push_back(new Worker());
+    }
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        std::thread(&CryptoPool::Loop, this, i).detach();
+    }
+    started = true;
+}
+
+void CryptoPool::Submit(CryptoPoolTask* task, CryptoPoolPriority priority) {
+    if (!started) Start();
+
+    Worker* worker = workers[next_worker++ % workers.size()];
+    {
+        // The counters are updated while the deque is locked so that Take() cannot see the task
+        // before it is counted, and queued_total under sleep_mutex so that a thread about to wait
+        // cannot miss it.
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->queues[priority].push_back(task);
+        queued[priority]++;
+        std::lock_guard<std::mutex> sleep_lock(sleep_mutex);
+        queued_total++;
+    }
+    sleep_cv.notify_one();
+}
+
+CryptoPoolTask* CryptoPool::Take(size_t index, int* priority) {
+    size_t n = workers.size();
+    for (int p = 0; p < CRYPTO_POOL_PRIORITIES; ++p) {
+        if (queued[p] == 0) continue;
+        for (size_t i = 0; i < n; ++i) {
+            Worker* worker = workers[(index + i) % n];
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            std::deque<CryptoPoolTask*>& queue = worker->queues[p];
+            if (queue.empty()) continue;
+
+            CryptoPoolTask* task;
+            if (i == 0) {
+                task = queue.front();
+                queue.pop_front();
+            } else {
+                task = queue.back();
+                queue.pop_back();
+            }
+            queued[p]--;
+            queued_total--;
+            *priority = p;
+            return task;
+        }
+    }
+    return NULL;
+}
+
+void CryptoPool::Loop(size_t index) {
+    for (;;) {
+        int priority;
+        CryptoPoolTask* task = Take(index, &priority);
+        if (!task) {
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleep_cv.wait(lock, [this] { return queued_total > 0; });
+            continue;
+        }
+
+        running++;
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        task->Run();
+        busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+        running--;
+        completed[priority]++;
+        task->Done();
+    }
+}
+
+uint32_t CryptoPool::Threads() {
+    std::lock_guard<std::mutex> lock(start_mutex);
+    if (num_threads) return num_threads;
+    uint32_t threads = std::thread::hardware_concurrency();
+    return threads ? threads : 1;
+}
+
+CryptoPoolStats CryptoPool::Stats() {
+    CryptoPoolStats stats = {};
+    std::lock_guard<std::mutex> lock(start_mutex);
+    if (!started) {
+        stats.threads = num_threads ? num_threads : std::thread::hardware_concurrency();
+        return stats;
+    }
+    stats.threads = num_threads;
+    stats.running = running;
+    for (int p = 0; p < CRYPTO_POOL_PRIORITIES; ++p) {
+        stats.queued[p] = queued[p];
+        stats.completed[p] = completed[p];
+    }
+    stats.busy_seconds = busy_ns / 1e9;
+    stats.uptime_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    return stats;
+}
@@ -0,0 +1,95 @@
+#ifndef CRYPTO_POOL_H
+#define CRYPTO_POOL_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Priority classes of the crypto pool, highest first. A worker only runs a task of a lower
+// class when no task of a higher class is queued anywhere in the pool.
+enum CryptoPoolPriority {
+    CRYPTO_POOL_CONSENSUS = 0,
+    CRYPTO_POOL_MEMPOOL = 1,
+    CRYPTO_POOL_MINING = 2,
+    CRYPTO_POOL_PRIORITIES = 3
+};
+
+class CryptoPoolTask {
+    public:
+        virtual ~CryptoPoolTask() {}
+
+        // Runs on a pool thread.
+        virtual void Run() = 0;
+
+        // Runs on the same pool thread after Run(). The pool does not touch the task afterwards,
+        // so Done() may hand it over to another thread.
+        virtual void Done() = 0;
+};
+
+struct CryptoPoolStats {
+    uint32_t threads;
+    uint32_t running;
+    uint64_t queued[CRYPTO_POOL_PRIORITIES];
+    uint64_t completed[CRYPTO_POOL_PRIORITIES];
+    // Time spent running tasks, summed over all threads.
+    double busy_seconds;
+    // Time since the pool threads were started.
+    double uptime_seconds;
+};
+
+// Process wide pool of crypto threads, separate from the libuv thread pool so that long running
+// jobs (mining, batch verification) do not starve file system and DNS requests.
+//
+// Every thread owns one deque per priority class. Tasks are submitted round robin to the threads,
+// which take from the front of their own deques and steal from the back of the others'.
+class CryptoPool {
+    public:
+        static CryptoPool& Instance();
+
+        // Sets the number of threads (0 picks one per core). Only possible before the first task
+        // is submitted, returns false afterwards.
+        bool Configure(uint32_t threads);
+
+        void Submit(CryptoPoolTask* task, CryptoPoolPriority priority);
+
+        // Number of threads the pool runs (or will run once started).
+        uint32_t Threads();
+
+        CryptoPoolStats Stats();
+
+    private:
+        struct Worker {
+            std::mutex mutex;
+            std::deque<CryptoPoolTask*> queues[CRYPTO_POOL_PRIORITIES];
+        };
+
+        CryptoPool() : num_threads(0), started(false), next_worker(0), queued_total(0), running(0), busy_ns(0) {}
+
+        void Start();
+        void Loop(size_t index);
+        CryptoPoolTask* Take(size_t index, int* priority);
+
+        std::mutex start_mutex;
+        uint32_t num_threads;
+        std::atomic<bool> started;
+        std::vector<Worker*> workers;
+        std::atomic<size_t> next_worker;
+
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
+        std::atomic<uint64_t> queued_total;
+
+        std::atomic<uint64_t> queued[CRYPTO_POOL_PRIORITIES];
+        std::atomic<uint64_t> completed[CRYPTO_POOL_PRIORITIES];
+        std::atomic<uint32_t> running;
+        std::atomic<uint64_t> busy_ns;
+        std::chrono::steady_clock::time_point start_time;
+};
+
+#endif
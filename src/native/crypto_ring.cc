@@ -0,0 +1,86 @@
+#include "crypto_ring.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "crypto_batch.h"
+
+// The header is accessed with sequentially consistent atomics like JS's Atomics, so that a
+// request published while the consumer goes to sleep is seen by one side or the other.
+static uint32_t load(uint32_t* word) {
+    return __atomic_load_n(word, __ATOMIC_SEQ_CST);
+}
+
+static void store(uint32_t* word, uint32_t value) {
+    __atomic_store_n(word, value, __ATOMIC_SEQ_CST);
+}
+
+CryptoRing::CryptoRing(uint32_t* header, uint32_t* slots, size_t slot_count, uint8_t* data, size_t data_length, CryptoPoolPriority priority)
+    : header(header), slots(slots), slot_count(slot_count), data(data), data_length(data_length), priority(priority), woken(false), stopped(false) {}
+
+void CryptoRing::Start() {
+    consumer = std::thread(&CryptoRing::Loop, this);
+}
+
+void CryptoRing::Notify() {
+    std::lock_guard<std::mutex> lock(mutex);
+    woken = true;
+    wake_cv.notify_one();
+}
+
+void CryptoRing::RequestStop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopped = true;
+    wake_cv.notify_one();
+}
+
+void CryptoRing::Stop() {
+    RequestStop();
+    if (consumer.joinable()) consumer.join();
+}
+
+void CryptoRing::Loop() {
+    uint32_t completed = load(&header[CRYPTO_RING_COMPLETED]);
+    for (;;) {
+        uint32_t submitted = load(&header[CRYPTO_RING_SUBMITTED]);
+        if (submitted == completed) {
+            store(&header[CRYPTO_RING_SLEEPING], 1);
+            std::unique_lock<std::mutex> lock(mutex);
+            if (load(&header[CRYPTO_RING_SUBMITTED]) == completed && !stopped) {
+                wake_cv.wait(lock, [this] { return woken || stopped; });
+            }
+            woken = false;
+            store(&header[CRYPTO_RING_SLEEPING], 0);
+            if (stopped) break;
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopped) break;
+        }
+
+        // The counters wrap around, JS never has more than slot_count requests in flight.
+        size_t count = (uint32_t) (submitted - completed);
+        if (count > slot_count) count = slot_count;
+        std::vector<uint32_t> jobs(count * CRYPTO_JOB_WORDS);
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t* slot = &slots[((completed + i) % slot_count) * CRYPTO_JOB_WORDS];
+            std::copy(slot, slot + CRYPTO_JOB_WORDS, &jobs[i * CRYPTO_JOB_WORDS]);
+        }
+
+        // Inputs and outputs both live in the data area. Invalid jobs are skipped rather than
+        // failing the whole batch, JS does not get an error back per request.
+        std::shared_ptr<CryptoBatch> batch = std::make_shared<CryptoBatch>(std::move(jobs), data, data);
+        batch->Validate(data_length, data_length, true);
+        CryptoBatch::Share(batch, priority);
+        batch->Work();
+        batch->Wait();
+
+        completed += (uint32_t) count;
+        store(&header[CRYPTO_RING_COMPLETED], completed);
+        Completed();
+    }
+    Stopped();
+}
@@ -0,0 +1,71 @@
+#ifndef CRYPTO_RING_H
+#define CRYPTO_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "crypto_pool.h"
+
+// Words of the ring header, shared with NativeCryptoRing.js.
+enum CryptoRingHeader {
+    // Number of requests published by JS (written by JS only).
+    CRYPTO_RING_SUBMITTED = 0,
+    // Number of requests completed, in order (written by the consumer only).
+    CRYPTO_RING_COMPLETED = 1,
+    // Set while the consumer is about to sleep; JS has to wake it with Notify().
+    CRYPTO_RING_SLEEPING = 2,
+    CRYPTO_RING_HEADER_WORDS = 4
+};
+
+// Single producer, single consumer request ring in memory shared with JS (a SharedArrayBuffer).
+// JS writes crypto jobs (see crypto_batch.h) into the slots and publishes them by advancing the
+// submitted counter; a consumer thread drains all published jobs at once as a CryptoBatch and
+// publishes the completed counter. Requests complete in order, so the completed counter doubles
+// as the completion ring, and neither side has to call into the other per request: JS only wakes
+// the consumer if it went to sleep, and the consumer only signals Completed() once per batch.
+class CryptoRing {
+    public:
+        CryptoRing(uint32_t* header, uint32_t* slots, size_t slot_count, uint8_t* data, size_t data_length, CryptoPoolPriority priority);
+        // Subclasses have to Stop() the consumer in their destructor, it calls their hooks.
+        virtual ~CryptoRing() {}
+
+        void Start();
+
+        // Wakes the consumer, called by JS after publishing requests while it was sleeping.
+        void Notify();
+
+        // Asks the consumer to stop after its current batch, without waiting for it.
+        void RequestStop();
+
+        // Stops the consumer after its current batch and joins it.
+        void Stop();
+
+    protected:
+        // Runs on the consumer thread after the completed counter was advanced.
+        virtual void Completed() = 0;
+
+        // Runs on the consumer thread right before it exits.
+        virtual void Stopped() {}
+
+    private:
+        void Loop();
+
+        uint32_t* header;
+        uint32_t* slots;
+        size_t slot_count;
+        uint8_t* data;
+        size_t data_length;
+        CryptoPoolPriority priority;
+
+        std::thread consumer;
+        std::mutex mutex;
+        std::condition_variable wake_cv;
+        bool woken;
+        bool stopped;
+};
+
+#endif
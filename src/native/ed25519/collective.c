@@ -1,3 +1,4 @@
+#include <string.h>
 #include "ed25519.h"
 #include "../sha512.h"
 #include "ge.h"
@@ -21,29 +22,56 @@ void ed25519_hash_public_keys(unsigned char *hash, const unsigned char *public_k
     sha512(public_keys, num_public_keys*32, hash);
 }
 
+/*
+ * Starts the hash H(C || ...) shared by the delinearization factors of all public keys.
+ */
+
+static void delinearization_prefix(sha512_context *prefix, const unsigned char *public_keys_hash) {
+    sha512_init(prefix);
+    sha512_update(prefix, public_keys_hash, 64);
+}
+
+/*
+ * Computes the delinearization factor H(C || P) mod l of a public key P.
+ */
+
+static void delinearization_factor(unsigned char *factor, const sha512_context *prefix, const unsigned char *public_key) {
+    sha512_context hash = *prefix;
+    unsigned char h[64];
+
+    sha512_update(&hash, public_key, 32);
+    sha512_final(&hash, h);
+    sc_reduce(h);
+    memcpy(factor, h, 32);
+}
+
 /*
  * Let public_keys_hash = C = H(P_1 || ... || P_n).
  * Derives a public key H(C||P)P used for multisignatures.
  */
 
 void ed25519_derive_delinearized_private_key(unsigned char *multisig_private_key, const unsigned char *public_keys_hash, const unsigned char *public_key, const unsigned char *private_key) {
-    sha512_context hash;
-    unsigned char r[64];
     unsigned char az[64];
-    const unsigned char SC_0[32] = {0}; /* scalar with value 0 */
-
-    // Compute H(C||P).
-    sha512_init(&hash);
-    sha512_update(&hash, public_keys_hash, 64);
-    sha512_update(&hash, public_key, 32);
-    sha512_final(&hash, r);
-
-    // Reduce hash to group.
-    sc_reduce(r);
 
     // Decompress the 32 byte private key to 64 byte.
     ed25519_private_key_decompress(az, private_key);
 
+    ed25519_derive_delinearized_expanded_key(multisig_private_key, public_keys_hash, public_key, az);
+}
+
+/*
+ * Same as ed25519_derive_delinearized_private_key for an already decompressed private key az.
+ */
+
+void ed25519_derive_delinearized_expanded_key(unsigned char *multisig_private_key, const unsigned char *public_keys_hash, const unsigned char *public_key, const unsigned char *az) {
+    sha512_context prefix;
+    unsigned char r[32];
+    const unsigned char SC_0[32] = {0}; /* scalar with value 0 */
+
+    // Compute H(C||P) mod l.
+    delinearization_prefix(&prefix, public_keys_hash);
+    delinearization_factor(r, &prefix, public_key);
+
     // a * b + c
     sc_muladd(multisig_private_key, r, az, SC_0);
 }
@@ -54,36 +82,46 @@ void ed25519_derive_delinearized_private_key(unsigned char *multisig_private_key
  */
 
 void ed25519_aggregate_delinearized_public_keys(unsigned char *aggregate_public_key, const unsigned char *public_keys_hash, const unsigned char *public_keys, const size_t num_public_keys) {
-    unsigned char delinearized_public_key[32];
+    sha512_context prefix;
+    unsigned char factors[GE_MULTI_SCALARMULT_MAX * 32];
+    ge_p3 points[GE_MULTI_SCALARMULT_MAX];
     ge_p1p1 sum_tmp;
     ge_p3 sum;
-    ge_p3 delinearized_public_key_unpacked;
-    ge_cached delinearized_public_key_cached;
+    ge_p3 chunk;
+    ge_cached chunk_cached;
+    size_t i, j, n;
 
+    delinearization_prefix(&prefix, public_keys_hash);
     ge_p3_0(&sum);
 
-    for (size_t i = 0; i < num_public_keys; ++i) {
-        const unsigned char *public_key = public_keys + (i * 32);
+    /* All inputs are public, so the sum is computed with variable-time multi-scalar multiplications. */
+    for (i = 0; i < num_public_keys; i += n) {
+        n = num_public_keys - i < GE_MULTI_SCALARMULT_MAX ? num_public_keys - i : GE_MULTI_SCALARMULT_MAX;
 
-        ed25519_delinearize_public_key(delinearized_public_key, public_keys_hash, public_key);
+        for (j = 0; j < n; ++j) {
+            const unsigned char *public_key = public_keys + ((i + j) * 32);
 
-        /* unpack delinearized public key */
-        ge_frombytes_negate_vartime(&delinearized_public_key_unpacked, delinearized_public_key);
-        fe_neg(delinearized_public_key_unpacked.X, delinearized_public_key_unpacked.X); /* undo negate */
-        fe_neg(delinearized_public_key_unpacked.T, delinearized_public_key_unpacked.T); /* undo negate */
+            /* unpack public key */
+            ge_frombytes_negate_vartime(&points[j], public_key);
+            fe_neg(points[j].X, points[j].X); /* undo negate */
+            fe_neg(points[j].T, points[j].T); /* undo negate */
+
+            delinearization_factor(factors + (j * 32), &prefix, public_key);
+        }
 
         if (i == 0) {
-            sum = delinearized_public_key_unpacked;
+            ge_multi_scalarmult_vartime(&sum, NULL, points, factors, n);
             continue;
         }
-        
-        ge_p3_to_cached(&delinearized_public_key_cached, &delinearized_public_key_unpacked);
-        
-        /* sum = sum + public key */
-        ge_add(&sum_tmp, &sum, &delinearized_public_key_cached);
+
+        ge_multi_scalarmult_vartime(&chunk, NULL, points, factors, n);
+        ge_p3_to_cached(&chunk_cached, &chunk);
+
+        /* sum = sum + chunk */
+        ge_add(&sum_tmp, &sum, &chunk_cached);
         ge_p1p1_to_p3(&sum, &sum_tmp);
     }
-    
+
     /* pack point */
     ge_p3_tobytes(aggregate_public_key, &sum);
 }
@@ -94,11 +132,10 @@ void ed25519_aggregate_delinearized_public_keys(unsigned char *aggregate_public_
  */
 
 void ed25519_delinearize_public_key(unsigned char *delinearized_public_key, const unsigned char *public_keys_hash, const unsigned char *public_key) {
-    sha512_context hash;
-    unsigned char pH[64];
+    sha512_context prefix;
+    unsigned char pH[32];
     ge_p3 P;
-    ge_p2 P_prime;
-    const unsigned char SC_0[32] = {0}; /* scalar with value 0 */
+    ge_p3 P_prime;
 
     // Compute P.
     /* unpack point public_key into P */
@@ -107,15 +144,12 @@ void ed25519_delinearize_public_key(unsigned char *delinearized_public_key, cons
     fe_neg(P.T, P.T); /* undo negate */
 
     // Compute H(C||P).
-    sha512_init(&hash);
-    sha512_update(&hash, public_keys_hash, 64);
-    sha512_update(&hash, public_key, 32);
-    sha512_final(&hash, pH);
-    sc_reduce(pH);
+    delinearization_prefix(&prefix, public_keys_hash);
+    delinearization_factor(pH, &prefix, public_key);
 
     // Compute H(C||P)P.
-    ge_double_scalarmult_vartime(&P_prime, pH, &P, SC_0);
-    ge_tobytes(delinearized_public_key, &P_prime);
+    ge_multi_scalarmult_vartime(&P_prime, NULL, &P, pH, 1);
+    ge_p3_tobytes(delinearized_public_key, &P_prime);
 }
 
 /*
@@ -20,14 +20,32 @@
 extern "C" {
 #endif
 
+/*
+ * Expanded private key for repeated signing: the clamped scalar a, the nonce prefix
+ * and the public key A. Created with ed25519_signing_key_create, which keeps it in
+ * locked memory where available, and wiped by ed25519_signing_key_destroy.
+ */
+typedef struct {
+    unsigned char az[64];
+    unsigned char public_key[32];
+} ed25519_signing_key;
+
 /* Common functions */
 void ed25519_private_key_decompress(unsigned char *az, const unsigned char *private_key);
+void ed25519_derive_delinearized_expanded_key(unsigned char *multisig_private_key, const unsigned char *public_keys_hash, const unsigned char *public_key, const unsigned char *az);
 int ED25519_DECLSPEC ed25519_verify(const unsigned char *signature, const unsigned char *message, size_t message_len, const unsigned char *public_key);
 
 /* Single signature functions */
 void ED25519_DECLSPEC ed25519_public_key_derive(unsigned char *out_public_key, const unsigned char *private_key);
 void ED25519_DECLSPEC ed25519_sign(unsigned char *signature, const unsigned char *message, size_t message_len, const unsigned char *public_key, const unsigned char *private_key);
 
+/* Signing key functions */
+ed25519_signing_key ED25519_DECLSPEC * ed25519_signing_key_create(const unsigned char *private_key);
+void ED25519_DECLSPEC ed25519_signing_key_destroy(ed25519_signing_key *key);
+void ED25519_DECLSPEC ed25519_signing_key_public_key(unsigned char *out_public_key, const ed25519_signing_key *key);
+void ED25519_DECLSPEC ed25519_signing_key_sign(unsigned char *signature, const unsigned char *message, size_t message_len, const ed25519_signing_key *key);
+void ED25519_DECLSPEC ed25519_signing_key_delinearized_partial_sign(unsigned char *partial_signature, const unsigned char *message, size_t message_len, const unsigned char* commitment_R, const unsigned char *secret_r, const unsigned char *public_keys_hash, const unsigned char *aggregate_public_key, const ed25519_signing_key *key);
+
 /* Common multisig functions */
 int ED25519_DECLSPEC ed25519_create_commitment(unsigned char *secret_r, unsigned char *commitment_R, const unsigned char *randomness);
 void ED25519_DECLSPEC ed25519_aggregate_commitments(unsigned char *aggregate_commitment, const unsigned char *commitments, const size_t num_commitments);
@@ -39,6 +57,7 @@ void ED25519_DECLSPEC ed25519_delinearize_public_key(unsigned char *delinearized
 void ED25519_DECLSPEC ed25519_aggregate_delinearized_public_keys(unsigned char *aggregate_public_key, const unsigned char *public_keys_hash, const unsigned char *public_keys, const size_t num_public_keys);
 void ED25519_DECLSPEC ed25519_derive_delinearized_private_key(unsigned char *multisig_private_key, const unsigned char *public_keys_hash, const unsigned char *public_key, const unsigned char *private_key);
 void ED25519_DECLSPEC ed25519_delinearized_partial_sign(unsigned char *partial_signature, const unsigned char *message, size_t message_len, const unsigned char* commitment_R, const unsigned char *secret_r, const unsigned char *public_keys, size_t num_cosigners, const unsigned char *public_key, const unsigned char *private_key);
+void ED25519_DECLSPEC ed25519_delinearized_partial_sign_precomputed(unsigned char *partial_signature, const unsigned char *message, size_t message_len, const unsigned char* commitment_R, const unsigned char *secret_r, const unsigned char *public_keys_hash, const unsigned char *aggregate_public_key, const unsigned char *public_key, const unsigned char *private_key);
 
 #ifdef __cplusplus
 }
@@ -7,13 +7,26 @@
 /*
     fe means field element.
     Here the field is \Z/(2^255-19).
+
+    With ED25519_FE51 (64-bit hosts with __int128, see fe51.c):
+    An element t, entries t[0]...t[4], represents the integer
+    t[0]+2^51 t[1]+2^102 t[2]+2^153 t[3]+2^204 t[4].
+
+    Otherwise (fe.c):
     An element t, entries t[0]...t[9], represents the integer
     t[0]+2^26 t[1]+2^51 t[2]+2^77 t[3]+2^102 t[4]+...+2^230 t[9].
     Bounds on each t[i] vary depending on context.
 */
 
 
+#ifdef ED25519_FE51
+    #ifndef __SIZEOF_INT128__
+        #error "ED25519_FE51 requires a compiler with unsigned __int128"
+    #endif
+typedef uint64_t fe[5];
+#else
 typedef int32_t fe[10];
+#endif
 
 
 void fe_0(fe h);
@@ -0,0 +1,325 @@
+#include "fixedint.h"
+#include "fe.h"
+
+#ifdef ED25519_FE51
+
+/*
+    Radix 2^51 implementation of the functions declared in fe.h for 64-bit hosts.
+    Products are accumulated in unsigned __int128. fe_add, fe_sub and fe_neg carry
+    their result, so every function accepts the output of any other one and limbs
+    stay below 2^52 between operations.
+*/
+
+typedef unsigned __int128 uint128_t;
+
+#define MASK51 ((uint64_t) 0x7ffffffffffff)
+
+static uint64_t load_8(const unsigned char *in) {
+    uint64_t result = 0;
+    int i;
+
+    for (i = 7; i >= 0; --i) {
+        result = (result << 8) | in[i];
+    }
+
+    return result;
+}
+
+/*
+    Propagates the carries of h so that every limb is below 2^51 + 2^13.
+*/
+
+static void fe_carry(fe h) {
+    uint64_t c;
+
+    c = h[0] >> 51; h[0] &= MASK51; h[1] += c;
+    c = h[1] >> 51; h[1] &= MASK51; h[2] += c;
+    c = h[2] >> 51; h[2] &= MASK51; h[3] += c;
+    c = h[3] >> 51; h[3] &= MASK51; h[4] += c;
+    c = h[4] >> 51; h[4] &= MASK51; h[0] += c * 19;
+}
+
+static void fe_carry_wide(fe h, uint128_t t0, uint128_t t1, uint128_t t2, uint128_t t3, uint128_t t4) {
+    t1 += (uint64_t) (t0 >> 51);
+    t2 += (uint64_t) (t1 >> 51);
+    t3 += (uint64_t) (t2 >> 51);
+    t4 += (uint64_t) (t3 >> 51);
+    t0 = ((uint64_t) t0 & MASK51) + (t4 >> 51) * 19;
+    h[0] = (uint64_t) t0 & MASK51;
+    h[1] = ((uint64_t) t1 & MASK51) + (uint64_t) (t0 >> 51);
+    h[2] = (uint64_t) t2 & MASK51;
+    h[3] = (uint64_t) t3 & MASK51;
+    h[4] = (uint64_t) t4 & MASK51;
+}
+
+void fe_0(fe h) {
+    h[0] = 0;
+    h[1] = 0;
+    h[2] = 0;
+    h[3] = 0;
+    h[4] = 0;
+}
+
+void fe_1(fe h) {
+    h[0] = 1;
+    h[1] = 0;
+    h[2] = 0;
+    h[3] = 0;
+    h[4] = 0;
+}
+
+void fe_copy(fe h, const fe f) {
+    h[0] = f[0];
+    h[1] = f[1];
+    h[2] = f[2];
+    h[3] = f[3];
+    h[4] = f[4];
+}
+
+/*
+    Ignores the top bit of s, like the ref10 implementation.
+*/
+
+void fe_frombytes(fe h, const unsigned char *s) {
+    h[0] = load_8(s) & MASK51;
+    h[1] = (load_8(s + 6) >> 3) & MASK51;
+    h[2] = (load_8(s + 12) >> 6) & MASK51;
+    h[3] = (load_8(s + 19) >> 1) & MASK51;
+    h[4] = (load_8(s + 24) >> 12) & MASK51;
+}
+
+void fe_tobytes(unsigned char *s, const fe h) {
+    fe t;
+    uint64_t q;
+    int i;
+
+    fe_copy(t, h);
+    fe_carry(t);
+    fe_carry(t);
+
+    /* t < 2^255 + 2^13 now, so t - p is negative iff t + 19 < 2^255. */
+    q = (t[0] + 19) >> 51;
+    q = (t[1] + q) >> 51;
+    q = (t[2] + q) >> 51;
+    q = (t[3] + q) >> 51;
+    q = (t[4] + q) >> 51;
+
+    t[0] += 19 * q;
+    t[1] += t[0] >> 51; t[0] &= MASK51;
+    t[2] += t[1] >> 51; t[1] &= MASK51;
+    t[3] += t[2] >> 51; t[2] &= MASK51;
+    t[4] += t[3] >> 51; t[3] &= MASK51;
+    t[4] &= MASK51;
+
+    t[0] |= t[1] << 51;
+    t[1] = (t[1] >> 13) | (t[2] << 38);
+    t[2] = (t[2] >> 26) | (t[3] << 25);
+    t[3] = (t[3] >> 39) | (t[4] << 12);
+
+    for (i = 0; i < 32; ++i) {
+        s[i] = (unsigned char) (t[i >> 3] >> ((i & 7) * 8));
+    }
+}
+
+int fe_isnegative(const fe f) {
+    unsigned char s[32];
+
+    fe_tobytes(s, f);
+
+    return s[0] & 1;
+}
+
+int fe_isnonzero(const fe f) {
+    unsigned char s[32];
+    unsigned char r = 0;
+    int i;
+
+    fe_tobytes(s, f);
+
+    for (i = 0; i < 32; ++i) {
+        r |= s[i];
+    }
+
+    return r != 0;
+}
+
+/*
+    Replace (f,g) with (g,g) if b == 1;
+    replace (f,g) with (f,g) if b == 0.
+
+    Preconditions: b in {0,1}.
+*/
+
+void fe_cmov(fe f, const fe g, unsigned int b) {
+    uint64_t mask = (uint64_t) 0 - (uint64_t) b;
+
+    f[0] ^= (f[0] ^ g[0]) & mask;
+    f[1] ^= (f[1] ^ g[1]) & mask;
+    f[2] ^= (f[2] ^ g[2]) & mask;
+    f[3] ^= (f[3] ^ g[3]) & mask;
+    f[4] ^= (f[4] ^ g[4]) & mask;
+}
+
+void fe_cswap(fe f, fe g, unsigned int b) {
+    uint64_t mask = (uint64_t) 0 - (uint64_t) b;
+    uint64_t x;
+    int i;
+
+    for (i = 0; i < 5; ++i) {
+        x = (f[i] ^ g[i]) & mask;
+        f[i] ^= x;
+        g[i] ^= x;
+    }
+}
+
+void fe_add(fe h, const fe f, const fe g) {
+    h[0] = f[0] + g[0];
+    h[1] = f[1] + g[1];
+    h[2] = f[2] + g[2];
+    h[3] = f[3] + g[3];
+    h[4] = f[4] + g[4];
+    fe_carry(h);
+}
+
+/*
+    h = f - g, computed as f + 4p - g so that no limb underflows.
+*/
+
+void fe_sub(fe h, const fe f, const fe g) {
+    h[0] = (f[0] + 0x1fffffffffffb4) - g[0];
+    h[1] = (f[1] + 0x1ffffffffffffc) - g[1];
+    h[2] = (f[2] + 0x1ffffffffffffc) - g[2];
+    h[3] = (f[3] + 0x1ffffffffffffc) - g[3];
+    h[4] = (f[4] + 0x1ffffffffffffc) - g[4];
+    fe_carry(h);
+}
+
+void fe_neg(fe h, const fe f) {
+    fe zero;
+
+    fe_0(zero);
+    fe_sub(h, zero, f);
+}
+
+void fe_mul(fe h, const fe f, const fe g) {
+    uint64_t f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+    uint64_t g0 = g[0], g1 = g[1], g2 = g[2], g3 = g[3], g4 = g[4];
+    uint64_t g1_19 = 19 * g1, g2_19 = 19 * g2, g3_19 = 19 * g3, g4_19 = 19 * g4;
+    uint128_t t0, t1, t2, t3, t4;
+
+    t0 = (uint128_t) f0 * g0 + (uint128_t) f1 * g4_19 + (uint128_t) f2 * g3_19 + (uint128_t) f3 * g2_19 + (uint128_t) f4 * g1_19;
+    t1 = (uint128_t) f0 * g1 + (uint128_t) f1 * g0 + (uint128_t) f2 * g4_19 + (uint128_t) f3 * g3_19 + (uint128_t) f4 * g2_19;
+    t2 = (uint128_t) f0 * g2 + (uint128_t) f1 * g1 + (uint128_t) f2 * g0 + (uint128_t) f3 * g4_19 + (uint128_t) f4 * g3_19;
+    t3 = (uint128_t) f0 * g3 + (uint128_t) f1 * g2 + (uint128_t) f2 * g1 + (uint128_t) f3 * g0 + (uint128_t) f4 * g4_19;
+    t4 = (uint128_t) f0 * g4 + (uint128_t) f1 * g3 + (uint128_t) f2 * g2 + (uint128_t) f3 * g1 + (uint128_t) f4 * g0;
+
+    fe_carry_wide(h, t0, t1, t2, t3, t4);
+}
+
+void fe_sq(fe h, const fe f) {
+    uint64_t f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+    uint64_t f0_2 = 2 * f0, f1_2 = 2 * f1;
+    uint64_t f1_38 = 38 * f1, f2_38 = 38 * f2, f3_38 = 38 * f3;
+    uint64_t f3_19 = 19 * f3, f4_19 = 19 * f4;
+    uint128_t t0, t1, t2, t3, t4;
+
+    t0 = (uint128_t) f0 * f0 + (uint128_t) f1_38 * f4 + (uint128_t) f2_38 * f3;
+    t1 = (uint128_t) f0_2 * f1 + (uint128_t) f2_38 * f4 + (uint128_t) f3_19 * f3;
+    t2 = (uint128_t) f0_2 * f2 + (uint128_t) f1 * f1 + (uint128_t) f3_38 * f4;
+    t3 = (uint128_t) f0_2 * f3 + (uint128_t) f1_2 * f2 + (uint128_t) f4_19 * f4;
+    t4 = (uint128_t) f0_2 * f4 + (uint128_t) f1_2 * f3 + (uint128_t) f2 * f2;
+
+    fe_carry_wide(h, t0, t1, t2, t3, t4);
+}
+
+/*
+    h = 2 * f * f
+*/
+
+void fe_sq2(fe h, const fe f) {
+    fe_sq(h, f);
+    fe_add(h, h, h);
+}
+
+void fe_mul121666(fe h, fe f) {
+    fe_carry_wide(h,
+        (uint128_t) f[0] * 121666,
+        (uint128_t) f[1] * 121666,
+        (uint128_t) f[2] * 121666,
+        (uint128_t) f[3] * 121666,
+        (uint128_t) f[4] * 121666);
+}
+
+static void fe_sq_n(fe h, const fe f, int n) {
+    int i;
+
+    fe_sq(h, f);
+    for (i = 1; i < n; ++i) {
+        fe_sq(h, h);
+    }
+}
+
+/*
+    Same addition chains as the ref10 implementation.
+*/
+
+void fe_invert(fe out, const fe z) {
+    fe t0;
+    fe t1;
+    fe t2;
+    fe t3;
+
+    fe_sq(t0, z);
+    fe_sq_n(t1, t0, 2);
+    fe_mul(t1, z, t1);
+    fe_mul(t0, t0, t1);
+    fe_sq(t2, t0);
+    fe_mul(t1, t1, t2);
+    fe_sq_n(t2, t1, 5);
+    fe_mul(t1, t2, t1);
+    fe_sq_n(t2, t1, 10);
+    fe_mul(t2, t2, t1);
+    fe_sq_n(t3, t2, 20);
+    fe_mul(t2, t3, t2);
+    fe_sq_n(t2, t2, 10);
+    fe_mul(t1, t2, t1);
+    fe_sq_n(t2, t1, 50);
+    fe_mul(t2, t2, t1);
+    fe_sq_n(t3, t2, 100);
+    fe_mul(t2, t3, t2);
+    fe_sq_n(t2, t2, 50);
+    fe_mul(t1, t2, t1);
+    fe_sq_n(t1, t1, 5);
+    fe_mul(out, t1, t0);
+}
+
+void fe_pow22523(fe out, const fe z) {
+    fe t0;
+    fe t1;
+    fe t2;
+
+    fe_sq(t0, z);
+    fe_sq_n(t1, t0, 2);
+    fe_mul(t1, z, t1);
+    fe_mul(t0, t0, t1);
+    fe_sq(t0, t0);
+    fe_mul(t0, t1, t0);
+    fe_sq_n(t1, t0, 5);
+    fe_mul(t0, t1, t0);
+    fe_sq_n(t1, t0, 10);
+    fe_mul(t1, t1, t0);
+    fe_sq_n(t2, t1, 20);
+    fe_mul(t1, t2, t1);
+    fe_sq_n(t1, t1, 10);
+    fe_mul(t0, t1, t0);
+    fe_sq_n(t1, t0, 50);
+    fe_mul(t1, t1, t0);
+    fe_sq_n(t2, t1, 100);
+    fe_mul(t1, t2, t1);
+    fe_sq_n(t1, t1, 50);
+    fe_mul(t0, t1, t0);
+    fe_sq_n(t0, t0, 2);
+    fe_mul(out, t0, z);
+}
+
+#endif
@@ -1,5 +1,14 @@
+#include <string.h>
 #include "ge.h"
+#include "sc.h"
+#ifdef ED25519_FE51
+#include "precomp_data_51.h"
+#else
 #include "precomp_data.h"
+#endif
+#ifdef ED25519_BASE_WIDE
+#include "precomp_base_wide.h"
+#endif
 
 
 /*
@@ -130,6 +139,85 @@ void ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a, const ge_p3
 }
 
 
+/*
+r = b * B + a[0] * A[0] + ... + a[n-1] * A[n-1]
+where every scalar is given as 32 bytes like in ge_double_scalarmult_vartime
+and n <= GE_MULTI_SCALARMULT_MAX. The doublings are shared between all points.
+b may be NULL to leave out the base point term.
+*/
+
+void ge_multi_scalarmult_vartime(ge_p3 *r, const unsigned char *b, const ge_p3 *A, const unsigned char *a, size_t n) {
+    signed char aslide[GE_MULTI_SCALARMULT_MAX][256];
+    signed char bslide[256] = {0};
+    ge_cached Ai[GE_MULTI_SCALARMULT_MAX][8]; /* A,3A,5A,7A,9A,11A,13A,15A */
+    ge_p1p1 t;
+    ge_p2 acc;
+    ge_p3 u;
+    ge_p3 A2;
+    size_t j;
+    int i, k;
+
+    if (b) {
+        slide(bslide, b);
+    }
+    for (j = 0; j < n; ++j) {
+        slide(aslide[j], a + 32 * j);
+        ge_p3_to_cached(&Ai[j][0], &A[j]);
+        ge_p3_dbl(&t, &A[j]);
+        ge_p1p1_to_p3(&A2, &t);
+        for (k = 1; k < 8; ++k) {
+            ge_add(&t, &A2, &Ai[j][k - 1]);
+            ge_p1p1_to_p3(&u, &t);
+            ge_p3_to_cached(&Ai[j][k], &u);
+        }
+    }
+
+    for (i = 255; i >= 0; --i) {
+        if (bslide[i]) {
+            break;
+        }
+        for (j = 0; j < n && !aslide[j][i]; ++j);
+        if (j < n) {
+            break;
+        }
+    }
+
+    if (i < 0) {
+        ge_p3_0(r);
+        return;
+    }
+
+    ge_p2_0(&acc);
+
+    for (; i >= 0; --i) {
+        ge_p2_dbl(&t, &acc);
+
+        for (j = 0; j < n; ++j) {
+            if (aslide[j][i] > 0) {
+                ge_p1p1_to_p3(&u, &t);
+                ge_add(&t, &u, &Ai[j][aslide[j][i] / 2]);
+            } else if (aslide[j][i] < 0) {
+                ge_p1p1_to_p3(&u, &t);
+                ge_sub(&t, &u, &Ai[j][(-aslide[j][i]) / 2]);
+            }
+        }
+
+        if (bslide[i] > 0) {
+            ge_p1p1_to_p3(&u, &t);
+            ge_madd(&t, &u, &Bi[bslide[i] / 2]);
+        } else if (bslide[i] < 0) {
+            ge_p1p1_to_p3(&u, &t);
+            ge_msub(&t, &u, &Bi[(-bslide[i]) / 2]);
+        }
+
+        ge_p1p1_to_p2(&acc, &t);
+    }
+
+    ge_p1p1_to_p3(r, &t);
+}
+
+
+#ifndef ED25519_FE51
 static const fe d = {
     -10913610, 13857413, -15372611, 6949391, 114729, -8787816, -6275908, -3247719, -18696448, -12055116
 };
@@ -137,6 +225,7 @@ static const fe d = {
 static const fe sqrtm1 = {
     -32595792, -7943725, 9377950, 3500415, 12389472, -272473, -25146209, -2005654, 326686, 11406482
 };
+#endif
 
 int ge_frombytes_negate_vartime(ge_p3 *h, const unsigned char *s) {
     fe u;
@@ -295,9 +384,11 @@ void ge_p3_dbl(ge_p1p1 *r, const ge_p3 *p) {
 r = p
 */
 
+#ifndef ED25519_FE51
 static const fe d2 = {
     -21827239, -5839606, -30745221, 13898782, 229458, 15978800, -12551817, -6495438, 29715968, 9444199
 };
+#endif
 
 void ge_p3_to_cached(ge_cached *r, const ge_p3 *p) {
     fe_add(r->YplusX, p->Y, p->X);
@@ -374,6 +465,93 @@ static void select(ge_precomp *t, int pos, signed char b) {
     cmov(t, &minust, bnegative);
 }
 
+#ifdef ED25519_BASE_WIDE
+
+/* (l+1)/2 and (2^256-1)/2 mod l */
+static const unsigned char comb_scale[32] = {
+    0xf7, 0xe9, 0x7a, 0x2e, 0x8d, 0x31, 0x09, 0x2c, 0x6b, 0xce, 0x7b, 0x51, 0xef, 0x7c, 0x6f, 0x0a,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08
+};
+
+static const unsigned char comb_offset[32] = {
+    0x8e, 0x4a, 0xcc, 0x46, 0xba, 0x18, 0x76, 0x6b, 0xb8, 0xe7, 0xbe, 0x39, 0xfa, 0xad, 0x77, 0x63,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07
+};
+
+/*
+Constant-time lookup of sum_{t<8} (2*bit_t - 1) * 2^(8*(8*pos+t)) * B,
+where bit_t is bit t of bits. Entries with bit 7 clear are the negation of
+the complemented entry. The row is read as 64-bit words and masked, which
+compilers vectorize.
+*/
+
+static void select_wide(ge_precomp *t, int pos, unsigned int bits) {
+    ge_precomp minust;
+    unsigned char bnegative = (unsigned char) (1 ^ (bits >> 7));
+    unsigned int index = (bits ^ (0 - (unsigned int) bnegative)) & 0x7f;
+    uint64_t words[sizeof(ge_precomp) / 8] = {0};
+    uint64_t entry_words[sizeof(ge_precomp) / 8];
+    uint64_t mask;
+    size_t i, j;
+
+    for (i = 0; i < 128; ++i) {
+        /* mask is all ones iff index == i */
+        mask = 0 - ((((uint64_t) (index ^ (unsigned int) i)) - 1) >> 63);
+        memcpy(entry_words, &base_wide[pos][i], sizeof(ge_precomp));
+        for (j = 0; j < sizeof(ge_precomp) / 8; ++j) {
+            words[j] |= entry_words[j] & mask;
+        }
+    }
+    memcpy(t, words, sizeof(ge_precomp));
+
+    fe_copy(minust.yplusx, t->yminusx);
+    fe_copy(minust.yminusx, t->yplusx);
+    fe_neg(minust.xy2d, t->xy2d);
+    cmov(t, &minust, bnegative);
+}
+
+/*
+h = a * B
+where a = a[0]+256*a[1]+...+256^31 a[31]
+B is the Ed25519 base point (x,4/5) with x positive.
+
+Signed-digit comb with 4 blocks of 8 teeth spaced 8 bits apart: with
+s = (a + 2^256 - 1) / 2 mod l, a = sum_i (2*s_i - 1) * 2^i mod l, so every
+bit of s selects +-2^i * B. This needs 32 additions and 7 doublings instead
+of the 64 additions and 4 doublings below, at the cost of a 128 entry table
+scan per addition.
+*/
+
+void ge_scalarmult_base(ge_p3 *h, const unsigned char *a) {
+    unsigned char s[32];
+    unsigned int bits;
+    ge_p1p1 r;
+    ge_precomp t;
+    int i, j, k;
+
+    sc_muladd(s, a, comb_scale, comb_offset);
+    ge_p3_0(h);
+
+    for (j = 7; j >= 0; --j) {
+        if (j < 7) {
+            ge_p3_dbl(&r, h);
+            ge_p1p1_to_p3(h, &r);
+        }
+
+        for (i = 0; i < 4; ++i) {
+            bits = 0;
+            for (k = 0; k < 8; ++k) {
+                bits |= ((s[8 * i + k] >> j) & 1) << k;
+            }
+            select_wide(&t, i, bits);
+            ge_madd(&r, h, &t);
+            ge_p1p1_to_p3(h, &r);
+        }
+    }
+}
+
+#else
+
 /*
 h = a * B
 where a = a[0]+256*a[1]+...+256^31 a[31]
@@ -433,6 +611,8 @@ void ge_scalarmult_base(ge_p3 *h, const unsigned char *a) {
     }
 }
 
+#endif
+
 
 /*
 r = p - q
@@ -1,6 +1,7 @@
 #ifndef GE_H
 #define GE_H
 
+#include <stddef.h>
 #include "fe.h"
 
 
@@ -18,6 +19,9 @@ Representations:
   ge_precomp (Duif): (y+x,y-x,2dxy)
 */
 
+/* Maximum number of points (besides the base point) in ge_multi_scalarmult_vartime. */
+#define GE_MULTI_SCALARMULT_MAX 16
+
 typedef struct {
   fe X;
   fe Y;
@@ -58,6 +62,7 @@ int ge_frombytes_negate_vartime(ge_p3 *h, const unsigned char *s);
 void ge_add(ge_p1p1 *r, const ge_p3 *p, const ge_cached *q);
 void ge_sub(ge_p1p1 *r, const ge_p3 *p, const ge_cached *q);
 void ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a, const ge_p3 *A, const unsigned char *b);
+void ge_multi_scalarmult_vartime(ge_p3 *r, const unsigned char *b, const ge_p3 *A, const unsigned char *a, size_t n);
 void ge_madd(ge_p1p1 *r, const ge_p3 *p, const ge_precomp *q);
 void ge_msub(ge_p1p1 *r, const ge_p3 *p, const ge_precomp *q);
 void ge_scalarmult_base(ge_p3 *h, const unsigned char *a);
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include "fe.h"
+#include "ge.h"
+
+/*
+    Writes precomp_base_wide.h, the signed-digit comb table used by ge_scalarmult_base
+    when ge.c is built with ED25519_BASE_WIDE. Entry j of block i is
+
+        base_wide[i][j] = sum_{t<8} (2*bit_t - 1) * 2^(8*(8*i+t)) * B
+
+    where bit_t is bit t of j for t < 7 and bit_7 is 1. The limbs are written in the
+    representation of the field arithmetic this program is built with, so it must be
+    built with the same ED25519_FE51 setting as ge.c:
+
+        make ed25519/precomp_base_wide.h
+*/
+
+#define WIDE_BLOCKS 4
+#define WIDE_TEETH 8
+#define WIDE_SPACING 8
+#define WIDE_ENTRIES (1 << (WIDE_TEETH - 1))
+
+/* Encoding of the base point B = (x,4/5) with x positive. */
+static const unsigned char base_point[32] = {
+    0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66
+};
+
+static FILE *out;
+
+static void fe_from_uint(fe h, unsigned int v) {
+    unsigned char s[32] = {0};
+
+    s[0] = v & 0xff;
+    s[1] = (v >> 8) & 0xff;
+    s[2] = (v >> 16) & 0xff;
+    fe_frombytes(h, s);
+}
+
+/* d2 = 2 * -121665/121666 */
+static void compute_d2(fe d2) {
+    fe num, den;
+
+    fe_from_uint(num, 121665);
+    fe_from_uint(den, 121666);
+    fe_invert(den, den);
+    fe_mul(d2, num, den);
+    fe_neg(d2, d2);
+    fe_add(d2, d2, d2);
+}
+
+static void print_fe(const char *indent, const fe f, const char *suffix) {
+    unsigned char s[32];
+    fe g;
+    int i;
+
+    /* fe_frombytes of the canonical encoding gives reduced limbs. */
+    fe_tobytes(s, f);
+    fe_frombytes(g, s);
+
+    fprintf(out, "%s{ ", indent);
+    for (i = 0; i < (int) (sizeof(fe) / sizeof(g[0])); ++i) {
+        if (sizeof(g[0]) == 8) {
+            fprintf(out, "%s0x%013llx", i ? ", " : "", (unsigned long long) g[i]);
+        } else {
+            fprintf(out, "%s%lld", i ? ", " : "", (long long) g[i]);
+        }
+    }
+    fprintf(out, " }%s\n", suffix);
+}
+
+static void print_precomp(const ge_p3 *p, const fe d2) {
+    fe recip, x, y, t;
+
+    fe_invert(recip, p->Z);
+    fe_mul(x, p->X, recip);
+    fe_mul(y, p->Y, recip);
+
+    fprintf(out, "        {\n");
+    fe_add(t, y, x);
+    print_fe("            ", t, ",");
+    fe_sub(t, y, x);
+    print_fe("            ", t, ",");
+    fe_mul(t, x, y);
+    fe_mul(t, t, d2);
+    print_fe("            ", t, ",");
+    fprintf(out, "        },\n");
+}
+
+int main(int argc, char **argv) {
+    ge_p3 teeth[WIDE_BLOCKS * WIDE_TEETH];
+    ge_cached tooth_cached;
+    ge_p3 p, sum;
+    ge_p1p1 t;
+    fe d2;
+    int i, j, k;
+
+    out = argc > 1 ? fopen(argv[1], "w") : stdout;
+    if (!out) {
+        perror("fopen");
+        return 1;
+    }
+
+    compute_d2(d2);
+
+    /* teeth[k] = 2^(WIDE_SPACING*k) * B */
+    ge_frombytes_negate_vartime(&p, base_point);
+    fe_neg(p.X, p.X); /* undo negate */
+    fe_neg(p.T, p.T); /* undo negate */
+    for (k = 0; k < WIDE_BLOCKS * WIDE_TEETH; ++k) {
+        teeth[k] = p;
+        for (j = 0; j < WIDE_SPACING; ++j) {
+            ge_p3_dbl(&t, &p);
+            ge_p1p1_to_p3(&p, &t);
+        }
+    }
+
+    fprintf(out, "/* This file was automatically generated by gen_base_table_wide.c. */\n\n");
+#ifdef ED25519_FE51
+    fprintf(out, "#ifndef ED25519_FE51\n");
+#else
+    fprintf(out, "#ifdef ED25519_FE51\n");
+#endif
+    fprintf(out, "#error \"precomp_base_wide.h was generated for the other field arithmetic, run make ed25519/precomp_base_wide.h\"\n");
+    fprintf(out, "#endif\n\n");
+
+    fprintf(out, "/* base_wide[i][j] = sum_{t<8} (2*bit_t - 1) * 2^(8*(8*i+t)) * B, bit_7 = 1 */\n");
+    fprintf(out, "static const ge_precomp base_wide[%d][%d] = {\n", WIDE_BLOCKS, WIDE_ENTRIES);
+    for (i = 0; i < WIDE_BLOCKS; ++i) {
+        fprintf(out, "    {\n");
+        for (j = 0; j < WIDE_ENTRIES; ++j) {
+            sum = teeth[i * WIDE_TEETH + WIDE_TEETH - 1];
+            for (k = 0; k < WIDE_TEETH - 1; ++k) {
+                ge_p3_to_cached(&tooth_cached, &teeth[i * WIDE_TEETH + k]);
+                if ((j >> k) & 1) {
+                    ge_add(&t, &sum, &tooth_cached);
+                } else {
+                    ge_sub(&t, &sum, &tooth_cached);
+                }
+                ge_p1p1_to_p3(&sum, &t);
+            }
+            print_precomp(&sum, d2);
+        }
+        fprintf(out, "    },\n");
+    }
+    fprintf(out, "};\n");
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
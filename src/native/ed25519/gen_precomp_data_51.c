@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include "fe.h"
+#include "ge.h"
+#include "precomp_data.h"
+
+/*
+    Writes precomp_data_51.h, the radix 2^51 version of the constants used by ge.c
+    (precomp_data.h and the curve constants d, 2*d and sqrt(-1)).
+    Must be built without ED25519_FE51 against the 10-limb fe.c:
+
+        make ed25519/precomp_data_51.h
+*/
+
+static const fe d = {
+    -10913610, 13857413, -15372611, 6949391, 114729, -8787816, -6275908, -3247719, -18696448, -12055116
+};
+
+static const fe d2 = {
+    -21827239, -5839606, -30745221, 13898782, 229458, 15978800, -12551817, -6495438, 29715968, 9444199
+};
+
+static const fe sqrtm1 = {
+    -32595792, -7943725, 9377950, 3500415, 12389472, -272473, -25146209, -2005654, 326686, 11406482
+};
+
+static FILE *out;
+
+static void print_fe(const char *indent, const fe f, const char *suffix) {
+    unsigned char s[32];
+    unsigned long long limbs[5] = {0};
+    int i;
+
+    fe_tobytes(s, f);
+    for (i = 0; i < 255; ++i) {
+        limbs[i / 51] |= (unsigned long long) ((s[i >> 3] >> (i & 7)) & 1) << (i % 51);
+    }
+    fprintf(out, "%s{ 0x%013llx, 0x%013llx, 0x%013llx, 0x%013llx, 0x%013llx }%s\n",
+            indent, limbs[0], limbs[1], limbs[2], limbs[3], limbs[4], suffix);
+}
+
+static void print_precomp(const char *indent, const ge_precomp *p) {
+    char inner[32];
+
+    snprintf(inner, sizeof(inner), "%s    ", indent);
+    fprintf(out, "%s{\n", indent);
+    print_fe(inner, p->yplusx, ",");
+    print_fe(inner, p->yminusx, ",");
+    print_fe(inner, p->xy2d, ",");
+    fprintf(out, "%s},\n", indent);
+}
+
+static void print_constant(const char *name, const fe f) {
+    fprintf(out, "static const fe %s =\n", name);
+    print_fe("    ", f, ";");
+    fprintf(out, "\n");
+}
+
+int main(int argc, char **argv) {
+    int i, j;
+
+    out = argc > 1 ? fopen(argv[1], "w") : stdout;
+    if (!out) {
+        perror("fopen");
+        return 1;
+    }
+
+    fprintf(out, "/* This file was automatically generated by gen_precomp_data_51.c from precomp_data.h. */\n\n");
+
+    print_constant("d", d);
+    print_constant("d2", d2);
+    print_constant("sqrtm1", sqrtm1);
+
+    fprintf(out, "static const ge_precomp Bi[8] = {\n");
+    for (i = 0; i < 8; ++i) {
+        print_precomp("    ", &Bi[i]);
+    }
+    fprintf(out, "};\n\n\n");
+
+    fprintf(out, "/* base[i][j] = (j+1)*256^i*B */\n");
+    fprintf(out, "static const ge_precomp base[32][8] = {\n");
+    for (i = 0; i < 32; ++i) {
+        fprintf(out, "    {\n");
+        for (j = 0; j < 8; ++j) {
+            print_precomp("        ", &base[i][j]);
+        }
+        fprintf(out, "    },\n");
+    }
+    fprintf(out, "};\n");
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
@@ -1,7 +1,41 @@
+/* MAP_ANONYMOUS is not declared by sys/mman.h under -std=c99 otherwise. */
+#define _DEFAULT_SOURCE
+
+#include <stdlib.h>
 #include "ed25519.h"
 #include "../sha512.h"
+#include "../util.h"
 #include "ge.h"
 
+/*
+ * mlock and VirtualLock work on whole pages and do not count nested locks, so each signing
+ * key gets a page of its own: unlocking one key never unlocks the page of another.
+ */
+#if defined(_WIN32)
+#include <windows.h>
+#define alloc_key_page(len) VirtualAlloc(NULL, len, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)
+#define free_key_page(addr, len) VirtualFree(addr, 0, MEM_RELEASE)
+#define lock_memory(addr, len) VirtualLock(addr, len)
+#define unlock_memory(addr, len) VirtualUnlock(addr, len)
+#elif defined(__EMSCRIPTEN__)
+#define alloc_key_page(len) calloc(1, len)
+#define free_key_page(addr, len) free(addr)
+#define lock_memory(addr, len)
+#define unlock_memory(addr, len)
+#else
+#include <sys/mman.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+static void *alloc_key_page(size_t len) {
+    void *addr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return addr == MAP_FAILED ? NULL : addr;
+}
+#define free_key_page(addr, len) munmap(addr, len)
+#define lock_memory(addr, len) mlock(addr, len)
+#define unlock_memory(addr, len) munlock(addr, len)
+#endif
+
 void ed25519_private_key_decompress(unsigned char *az, const unsigned char *private_key) {
     // decompress the 32 byte private key into 64 byte
     sha512(private_key, 32, az);
@@ -20,3 +54,39 @@ void ed25519_public_key_derive(unsigned char *out_public_key, const unsigned cha
     ge_scalarmult_base(&A,az);
     ge_p3_tobytes(out_public_key, &A);
 }
+
+/*
+ * Expands a private key once for repeated signing. The key is locked into memory on a
+ * best-effort basis, so signing still works if the process exceeds its lock limit.
+ * Returns NULL if the allocation fails.
+ */
+
+ed25519_signing_key *ed25519_signing_key_create(const unsigned char *private_key) {
+    ed25519_signing_key *key = alloc_key_page(sizeof(ed25519_signing_key));
+    ge_p3 A;
+
+    if (!key) {
+        return NULL;
+    }
+    lock_memory(key, sizeof(ed25519_signing_key));
+
+    ed25519_private_key_decompress(key->az, private_key);
+
+    ge_scalarmult_base(&A, key->az);
+    ge_p3_tobytes(key->public_key, &A);
+
+    return key;
+}
+
+void ed25519_signing_key_destroy(ed25519_signing_key *key) {
+    if (!key) {
+        return;
+    }
+    memzero(key, sizeof(ed25519_signing_key));
+    unlock_memory(key, sizeof(ed25519_signing_key));
+    free_key_page(key, sizeof(ed25519_signing_key));
+}
+
+void ed25519_signing_key_public_key(unsigned char *out_public_key, const ed25519_signing_key *key) {
+    memcpy(out_public_key, key->public_key, 32);
+}
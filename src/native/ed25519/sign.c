@@ -37,25 +37,35 @@ void create_signature(unsigned char *partial_signature, const unsigned char *mes
 
 void ed25519_delinearized_partial_sign(unsigned char *partial_signature, const unsigned char *message, size_t message_len, const unsigned char* commitment_R, const unsigned char *secret_r, const unsigned char *public_keys, size_t num_cosigners, const unsigned char *public_key, const unsigned char *private_key) {
     unsigned char public_keys_hash[64];
-    unsigned char delinearized_private_key[32];
-    unsigned char delinearized_public_key[32];
+    unsigned char aggregate_public_key[32];
 
     ed25519_hash_public_keys(public_keys_hash, public_keys, num_cosigners);
+    ed25519_aggregate_delinearized_public_keys(aggregate_public_key, public_keys_hash, public_keys, num_cosigners);
+
+    ed25519_delinearized_partial_sign_precomputed(partial_signature, message, message_len, commitment_R, secret_r, public_keys_hash, aggregate_public_key, public_key, private_key);
+}
+
+/*
+ * Same as ed25519_delinearized_partial_sign, but takes the public keys hash C and the aggregate
+ * public key from ed25519_hash_public_keys and ed25519_aggregate_delinearized_public_keys,
+ * so that they are computed once per signing session instead of once per partial signature.
+ */
+void ed25519_delinearized_partial_sign_precomputed(unsigned char *partial_signature, const unsigned char *message, size_t message_len, const unsigned char* commitment_R, const unsigned char *secret_r, const unsigned char *public_keys_hash, const unsigned char *aggregate_public_key, const unsigned char *public_key, const unsigned char *private_key) {
+    unsigned char delinearized_private_key[32];
+
     ed25519_derive_delinearized_private_key(delinearized_private_key, public_keys_hash, public_key, private_key);
-    ed25519_aggregate_delinearized_public_keys(delinearized_public_key, public_keys_hash, public_keys, num_cosigners);
 
-    create_signature(partial_signature, message, message_len, commitment_R, secret_r, delinearized_public_key, delinearized_private_key);
+    create_signature(partial_signature, message, message_len, commitment_R, secret_r, aggregate_public_key, delinearized_private_key);
 }
 
-void ed25519_sign(unsigned char *signature, const unsigned char *message, size_t message_len, const unsigned char *public_key, const unsigned char *private_key) {
+/*
+ * Signs with the decompressed private key az.
+ */
+static void sign_expanded(unsigned char *signature, const unsigned char *message, size_t message_len, const unsigned char *public_key, const unsigned char *az) {
     sha512_context hash;
-    unsigned char az[64];
     unsigned char r[64];
     ge_p3 R;
 
-    // decompress the 32 byte private key to 64 byte
-    ed25519_private_key_decompress(az, private_key);
-
     sha512_init(&hash);
     sha512_update(&hash, az + 32, 32);
     sha512_update(&hash, message, message_len);
@@ -67,3 +77,32 @@ void ed25519_sign(unsigned char *signature, const unsigned char *message, size_t
 
     create_signature(signature + 32, message, message_len, signature, r, public_key, az);
 }
+
+void ed25519_sign(unsigned char *signature, const unsigned char *message, size_t message_len, const unsigned char *public_key, const unsigned char *private_key) {
+    unsigned char az[64];
+
+    // decompress the 32 byte private key to 64 byte
+    ed25519_private_key_decompress(az, private_key);
+
+    sign_expanded(signature, message, message_len, public_key, az);
+}
+
+/*
+ * Same as ed25519_sign with the key expanded by ed25519_signing_key_create,
+ * which saves the private key decompression.
+ */
+void ed25519_signing_key_sign(unsigned char *signature, const unsigned char *message, size_t message_len, const ed25519_signing_key *key) {
+    sign_expanded(signature, message, message_len, key->public_key, key->az);
+}
+
+/*
+ * Same as ed25519_delinearized_partial_sign_precomputed with the key expanded by
+ * ed25519_signing_key_create.
+ */
+void ed25519_signing_key_delinearized_partial_sign(unsigned char *partial_signature, const unsigned char *message, size_t message_len, const unsigned char* commitment_R, const unsigned char *secret_r, const unsigned char *public_keys_hash, const unsigned char *aggregate_public_key, const ed25519_signing_key *key) {
+    unsigned char delinearized_private_key[32];
+
+    ed25519_derive_delinearized_expanded_key(delinearized_private_key, public_keys_hash, key->public_key, key->az);
+
+    create_signature(partial_signature, message, message_len, commitment_R, secret_r, aggregate_public_key, delinearized_private_key);
+}
@@ -4,6 +4,11 @@
 #include "krypton_native.h"
 #include "endian.h"
 
+#ifdef KRYPTON_MINER_THREADS
+#include <pthread.h>
+#include <stdatomic.h>
+#endif
+
 typedef uint64_t* uint256;
 
 uint256 uint256_new() {
@@ -49,6 +54,19 @@ int8_t uint256_compare(uint256 left, uint256 right) {
     return 0;
 }
 
+// Fixed buffer that the browser copies the inputs of a call into and reads its output from, instead
+// of allocating them on the wasm stack for every call. It is only used from the JS thread.
+#define KRYPTON_SCRATCH_SIZE 65536
+static uint8_t krypton_scratch[KRYPTON_SCRATCH_SIZE] __attribute__((aligned(16)));
+
+uint8_t *krypton_scratch_start() {
+    return krypton_scratch;
+}
+
+size_t krypton_scratch_size() {
+    return KRYPTON_SCRATCH_SIZE;
+}
+
 int krypton_blake2(void *out, const void *in, const size_t inlen) {
     return blake2b(out, 32, in, inlen, NULL, 0);
 }
@@ -79,6 +97,18 @@ int krypton_argon2_no_wipe(void *out, const void *in, const size_t inlen, const
     return krypton_argon2_flags(out, in, inlen, m_cost, ARGON2_DEFAULT_FLAGS | ARGON2_FLAG_NO_WIPE);
 }
 
+int krypton_argon2_batch(void *out, const void *in, const uint32_t *inlens, const size_t count, const uint32_t m_cost) {
+    const uint8_t *pin = (const uint8_t *) in;
+    uint8_t *pout = (uint8_t *) out;
+    for (size_t i = 0; i < count; ++i) {
+        int ret = krypton_argon2(pout, pin, inlens[i], m_cost);
+        if (ret != ARGON2_OK) return ret;
+        pin += inlens[i];
+        pout += 32;
+    }
+    return ARGON2_OK;
+}
+
 int krypton_kdf_legacy(void *out, const size_t outlen, const void *in, const size_t inlen, const void* seed, const size_t seedlen, const uint32_t m_cost, const uint32_t iter) {
     int ret;
     uint32_t i;
@@ -111,6 +141,87 @@ uint32_t krypton_argon2_target(void *out, void *in, const size_t inlen, const ui
     return be32toh(noncer[0]);
 }
 
+#ifdef KRYPTON_MINER_THREADS
+typedef struct {
+    const uint8_t *in;
+    size_t inlen;
+    uint32_t compact;
+    uint32_t max_nonce;
+    uint32_t m_cost;
+    // 64 bits, so claiming past max_nonce = 0xffffffff does not wrap around.
+    atomic_uint_fast64_t next_nonce;
+    // Lowest nonce meeting the target, max_nonce while there is none. Written under lock.
+    atomic_uint_fast32_t found_nonce;
+    pthread_mutex_t lock;
+    uint8_t *out;
+} krypton_argon2_target_job;
+
+static void *krypton_argon2_target_thread(void *arg) {
+    krypton_argon2_target_job *job = arg;
+    uint8_t *in = malloc(job->inlen);
+    uint8_t out[32];
+    uint256 target = uint256_new(), hash = uint256_new();
+    memcpy(in, job->in, job->inlen);
+    uint256_set_compact(target, job->compact);
+    for (;;) {
+        uint64_t nonce = atomic_fetch_add(&job->next_nonce, 1);
+        // Nonces below a found one were all claimed before it, so they are still checked.
+        if (nonce >= job->max_nonce || nonce >= atomic_load(&job->found_nonce)) break;
+        uint32_t noncer = htobe32((uint32_t) nonce);
+        memcpy(in + job->inlen - 4, &noncer, 4);
+        krypton_argon2_no_wipe(out, in, job->inlen, job->m_cost);
+        uint256_set_bytes(hash, out);
+        if (uint256_compare(target, hash) > 0) {
+            pthread_mutex_lock(&job->lock);
+            if (nonce < atomic_load(&job->found_nonce)) {
+                memcpy(job->out, out, 32);
+                atomic_store(&job->found_nonce, (uint32_t) nonce);
+            }
+            pthread_mutex_unlock(&job->lock);
+            break;
+        }
+    }
+    free(hash);
+    free(target);
+    free(in);
+    return NULL;
+}
+#endif
+
+uint32_t krypton_argon2_target_mt(void *out, void *in, const size_t inlen, const uint32_t compact, const uint32_t min_nonce, const uint32_t max_nonce, const uint32_t m_cost, const uint32_t threads) {
+#ifdef KRYPTON_MINER_THREADS
+    if (threads > 1 && max_nonce - min_nonce > 1) {
+        krypton_argon2_target_job job;
+        pthread_t *workers = malloc(sizeof(pthread_t) * (threads - 1));
+        uint32_t started = 0;
+        job.in = in;
+        job.inlen = inlen;
+        job.compact = compact;
+        job.max_nonce = max_nonce;
+        job.m_cost = m_cost;
+        job.out = out;
+        atomic_init(&job.next_nonce, min_nonce);
+        atomic_init(&job.found_nonce, max_nonce);
+        pthread_mutex_init(&job.lock, NULL);
+        // The calling thread mines as well. With fewer threads started, the others take over their nonces.
+        for (; started < threads - 1; ++started) {
+            if (pthread_create(&workers[started], NULL, krypton_argon2_target_thread, &job) != 0) break;
+        }
+        krypton_argon2_target_thread(&job);
+        for (uint32_t i = 0; i < started; ++i) {
+            pthread_join(workers[i], NULL);
+        }
+        pthread_mutex_destroy(&job.lock);
+        free(workers);
+        uint32_t nonce = (uint32_t) atomic_load(&job.found_nonce);
+        uint32_t* noncer = (uint32_t*)(((uint8_t*)in)+inlen-4);
+        noncer[0] = htobe32(nonce);
+        return nonce;
+    }
+#endif
+    return krypton_argon2_target(out, in, inlen, compact, min_nonce, max_nonce, m_cost);
+}
+
 int krypton_argon2_verify(const void *hash, const void *in, const size_t inlen, const uint32_t m_cost) {
     void* out = malloc(32);
     krypton_argon2(out, in, inlen, m_cost);
@@ -10,11 +10,18 @@
 #define KRYPTON_ARGON2_SALT_LEN 11
 #define KRYPTON_DEFAULT_ARGON2_COST 512
 
+uint8_t *krypton_scratch_start();
+size_t krypton_scratch_size();
 int krypton_blake2(void *out, const void *in, const size_t inlen);
 int krypton_argon2(void *out, const void *in, const size_t inlen, const uint32_t m_cost);
+// Hashes count inputs stored one after another, inlens[i] bytes each, into 32 bytes each.
+int krypton_argon2_batch(void *out, const void *in, const uint32_t *inlens, const size_t count, const uint32_t m_cost);
 int krypton_kdf_legacy(void *out, const size_t outlen, const void *in, const size_t inlen, const void* seed, const size_t seedlen, const uint32_t m_cost, const uint32_t iter);
 int krypton_kdf(void *out, const size_t outlen, const void *in, const size_t inlen, const void* seed, const size_t seedlen, const uint32_t m_cost, const uint32_t iter);
 uint32_t krypton_argon2_target(void *out, void *in, const size_t inlen, const uint32_t compact, const uint32_t min_nonce, const uint32_t max_nonce, const uint32_t m_cost);
+// Like krypton_argon2_target, but spreads the nonces over the given number of threads when built with
+// KRYPTON_MINER_THREADS (the -pthread wasm build). Returns the same nonce as the single-threaded loop.
+uint32_t krypton_argon2_target_mt(void *out, void *in, const size_t inlen, const uint32_t compact, const uint32_t min_nonce, const uint32_t max_nonce, const uint32_t m_cost, const uint32_t threads);
 int krypton_argon2_verify(const void *hash, const void *in, const size_t inlen, const uint32_t m_cost);
 void krypton_sha256(void *out, const void *in, const size_t inlen);
 void krypton_sha512(void *out, const void *in, const size_t inlen);
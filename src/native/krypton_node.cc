@@ -1,44 +1,262 @@
-#include <nan.h>
+#include <node_api.h>
+#include <stdio.h>
+#include <initializer_list>
+#include <memory>
+#include <vector>
 extern "C" {
 #include "krypton_native.h"
 #include "ed25519/ed25519.h"
 #include "secp256k1_native.h"
 #include "ripemd160.h"
 #include "keccak.h"
+#include "crc32.h"
 }
+#include "crypto_pool.h"
+#include "crypto_batch.h"
+#include "crypto_ring.h"
+#include "block_body.h"
+#include "accounts_tree.h"
 
-using v8::Function;
-using v8::FunctionTemplate;
-using v8::Local;
-using v8::Number;
-using v8::Object;
-using v8::String;
-using v8::Uint8Array;
-using v8::Value;
-using Nan::AsyncQueueWorker;
-using Nan::AsyncWorker;
-using Nan::Callback;
-using Nan::GetFunction;
-using Nan::HandleScope;
-using Nan::New;
-using Nan::Null;
-using Nan::Set;
-using Nan::To;
-
-class MinerWorker : public AsyncWorker {
+#define MAX_ARGS 8
+
+#define NAPI_METHOD(name) static napi_value name(napi_env env, napi_callback_info info)
+
+template<typename T> struct ElementType;
+
+template<> struct ElementType<uint8_t> {
+    static const char* Error() { return "Expected a Uint8Array"; }
+    static bool Matches(napi_typedarray_type type) {
+        return type == napi_uint8_array || type == napi_uint8_clamped_array || type == napi_int8_array;
+    }
+};
+
+template<> struct ElementType<uint32_t> {
+    static const char* Error() { return "Expected a Uint32Array"; }
+    static bool Matches(napi_typedarray_type type) {
+        return type == napi_uint32_array;
+    }
+};
+
+// Arguments of a call into the addon. Typed arrays are accessed in place: the pointer returned by
+// napi_get_typedarray_info already includes the byte offset, so callers may pass subarrays (e.g. a
+// slice of a SerialBuffer) without copying them first. The first invalid argument throws a
+// TypeError, after which ok() is false and the method must return without touching the data.
+class Arguments {
     public:
-        MinerWorker(Callback* callback, void* in, uint32_t inlen, uint32_t compact, uint32_t min_nonce, uint32_t max_nonce, uint32_t m_cost)
-            : AsyncWorker(callback), in(in), inlen(inlen), compact(compact), min_nonce(min_nonce), max_nonce(max_nonce), m_cost(m_cost), result_nonce(0) {}
-        ~MinerWorker() {}
+        Arguments(napi_env env, napi_callback_info info) : env(env), argc(MAX_ARGS), self(NULL), valid(true) {
+            napi_get_cb_info(env, info, &argc, argv, &self, NULL);
+        }
+
+        // The length is in elements of T; the element type of the array has to match T, so that a
+        // Uint8Array cannot be read as a longer array of words.
+        template<typename T = uint8_t>
+        T* Data(size_t index, size_t* length = NULL) {
+            napi_typedarray_type type;
+            size_t count = 0;
+            void* data = NULL;
+            if (valid && napi_get_typedarray_info(env, argv[index], &type, &count, &data, NULL, NULL) != napi_ok) {
+                Fail("Expected a TypedArray");
+            } else if (valid && !ElementType<T>::Matches(type)) {
+                Fail(ElementType<T>::Error());
+                count = 0;
+                data = NULL;
+            }
+            if (length) *length = count;
+            return (T*) data;
+        }
+
+        uint32_t Uint32(size_t index) {
+            uint32_t value = 0;
+            if (valid && napi_get_value_uint32(env, argv[index], &value) != napi_ok) {
+                Fail("Expected a number");
+            }
+            return value;
+        }
+
+        bool Bool(size_t index) {
+            bool value = false;
+            if (valid && napi_get_value_bool(env, argv[index], &value) != napi_ok) {
+                Fail("Expected a boolean");
+            }
+            return value;
+        }
+
+        template<typename T>
+        T* External(size_t index) {
+            void* data = NULL;
+            if (valid && napi_get_value_external(env, argv[index], &data) != napi_ok) {
+                Fail("Expected a native handle");
+            }
+            return (T*) data;
+        }
+
+        napi_value Function(size_t index) {
+            napi_valuetype type = napi_undefined;
+            if (valid && (napi_typeof(env, argv[index], &type) != napi_ok || type != napi_function)) {
+                Fail("Expected a function");
+            }
+            return argv[index];
+        }
+
+        // An optional priority class of the crypto pool, fallback if the argument is undefined.
+        CryptoPoolPriority Priority(size_t index, CryptoPoolPriority fallback) {
+            napi_valuetype type = napi_undefined;
+            if (valid) napi_typeof(env, argv[index], &type);
+            if (type == napi_undefined) return fallback;
+            uint32_t value = Uint32(index);
+            if (valid && value >= CRYPTO_POOL_PRIORITIES) {
+                Fail("Invalid priority");
+            }
+            return (CryptoPoolPriority) value;
+        }
+
+        napi_value operator[](size_t index) const { return argv[index]; }
+        napi_value This() const { return self; }
+        bool ok() const { return valid; }
+
+    private:
+        void Fail(const char* message) {
+            napi_throw_type_error(env, NULL, message);
+            valid = false;
+        }
+
+        napi_env env;
+        size_t argc;
+        napi_value argv[MAX_ARGS];
+        napi_value self;
+        bool valid;
+};
+
+static napi_value NewNumber(napi_env env, double value) {
+    napi_value result;
+    napi_create_double(env, value, &result);
+    return result;
+}
+
+// Calls a JS callback from a thread-safe function, with the global object as receiver.
+static void CallCallback(napi_env env, napi_value callback, size_t argc, napi_value* argv) {
+    napi_value global;
+    napi_get_global(env, &global);
+    if (napi_call_function(env, global, callback, argc, argv, NULL) == napi_pending_exception) {
+        // Report it like an exception thrown from any other event loop callback.
+        napi_value exception;
+        napi_get_and_clear_last_exception(env, &exception);
+        napi_fatal_exception(env, exception);
+    }
+}
+
+// Node finalizes the thread-safe function when the environment is torn down, even while pool
+// threads still hold it. Threads only touch it under this lock and while it is open.
+struct CompletionGuard {
+    std::mutex mutex;
+    bool open = true;
+};
+
+// Per environment state: the thread-safe function that hands completed pool jobs back to the JS
+// thread, and the number of jobs in flight. The function only keeps the event loop alive while
+// there are some.
+struct AddonData {
+    napi_threadsafe_function complete;
+    std::shared_ptr<CompletionGuard> guard;
+    uint32_t pending;
+};
+
+// Runs Execute() on the crypto pool (see crypto_pool.h) and passes Result() to a JS callback. The
+// typed arrays the job reads or writes are referenced until it completes, so they cannot be
+// collected while a pool thread is using them.
+class PoolJob : public CryptoPoolTask {
+    public:
+        virtual ~PoolJob() {}
+
+        bool Queue(napi_env env, napi_value callback, std::initializer_list<napi_value> arrays, CryptoPoolPriority priority) {
+            napi_get_instance_data(env, (void**) &addon);
+            if (napi_acquire_threadsafe_function(addon->complete) != napi_ok) {
+                napi_throw_error(env, NULL, "Crypto pool is shutting down");
+                return false;
+            }
+            complete = addon->complete;
+            guard = addon->guard;
+            napi_create_reference(env, callback, 1, &callback_ref);
+            for (napi_value array : arrays) {
+                napi_ref ref;
+                napi_create_reference(env, array, 1, &ref);
+                array_refs.push_back(ref);
+            }
+            if (addon->pending++ == 0) {
+                napi_ref_threadsafe_function(env, complete);
+            }
+            CryptoPool::Instance().Submit(this, priority);
+            return true;
+        }
+
+        static void CallComplete(napi_env env, napi_value js_callback, void* context, void* data) {
+            PoolJob* job = (PoolJob*) data;
+            // env is NULL if the environment is torn down before the job is delivered.
+            if (env) {
+                job->Complete(env);
+            }
+            delete job;
+        }
+
+    protected:
+        virtual void Execute() = 0;
+        virtual napi_value Result(napi_env env) = 0;
+
+    private:
+        void Run() {
+            Execute();
+        }
 
+        void Done() {
+            // The job may be deleted on the JS thread as soon as it is queued.
+            napi_threadsafe_function tsfn = complete;
+            std::shared_ptr<CompletionGuard> guard = this->guard;
+            std::lock_guard<std::mutex> lock(guard->mutex);
+            if (!guard->open) {
+                // The environment is gone, and its references with it.
+                delete this;
+                return;
+            }
+            if (napi_call_threadsafe_function(tsfn, this, napi_tsfn_blocking) != napi_ok) {
+                delete this;
+            }
+            napi_release_threadsafe_function(tsfn, napi_tsfn_release);
+        }
+
+        void Complete(napi_env env) {
+            if (--addon->pending == 0) {
+                napi_unref_threadsafe_function(env, complete);
+            }
+            napi_value callback;
+            napi_value argv[] = {Result(env)};
+            napi_get_reference_value(env, callback_ref, &callback);
+            CallCallback(env, callback, 1, argv);
+
+            napi_delete_reference(env, callback_ref);
+            for (napi_ref ref : array_refs) {
+                napi_delete_reference(env, ref);
+            }
+        }
+
+        AddonData* addon = NULL;
+        napi_threadsafe_function complete = NULL;
+        std::shared_ptr<CompletionGuard> guard;
+        napi_ref callback_ref = NULL;
+        std::vector<napi_ref> array_refs;
+};
+
+class MinerWorker : public PoolJob {
+    public:
+        MinerWorker(void* in, uint32_t inlen, uint32_t compact, uint32_t min_nonce, uint32_t max_nonce, uint32_t m_cost)
+            : in(in), inlen(inlen), compact(compact), min_nonce(min_nonce), max_nonce(max_nonce), m_cost(m_cost), result_nonce(0) {}
+
+    protected:
         void Execute() {
             result_nonce = krypton_argon2_target(out, in, inlen, compact, min_nonce, max_nonce, m_cost);
         }
 
-        void HandleOKCallback() {
-            HandleScope scope;
-            Local<Value> argv[] = {New<Number>(result_nonce)};
-            callback->Call(1, argv, async_resource);
+        napi_value Result(napi_env env) {
+            return NewNumber(env, result_nonce);
         }
 
     private:
@@ -52,20 +270,18 @@ class MinerWorker : public AsyncWorker {
         uint32_t result_nonce;
 };
 
-class Argon2Worker : public AsyncWorker {
+class Argon2Worker : public PoolJob {
     public:
-        Argon2Worker(Callback* callback, void* out, void* in, uint32_t inlen, uint32_t m_cost)
-            : AsyncWorker(callback), out(out), in(in), inlen(inlen), m_cost(m_cost), res(0) {}
-        ~Argon2Worker() {}
+        Argon2Worker(void* out, void* in, uint32_t inlen, uint32_t m_cost)
+            : out(out), in(in), inlen(inlen), m_cost(m_cost), res(0) {}
 
-        void Execute()  {
+    protected:
+        void Execute() {
             res = krypton_argon2(out, in, inlen, m_cost);
         }
 
-        void HandleOKCallback() {
-            HandleScope scope;
-            Local<Value> argv[] = {New<Number>(res)};
-            callback->Call(1, argv, async_resource);
+        napi_value Result(napi_env env) {
+            return NewNumber(env, res);
         }
 
     private:
@@ -76,817 +292,1506 @@ class Argon2Worker : public AsyncWorker {
         int res;
 };
 
-NAN_METHOD(node_argon2_target_async) {
-    Callback* callback = new Callback(info[0].As<Function>());
-
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t inlen = in_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    void* in = in_array->Buffer()->GetBackingStore()->Data();
-#else
-    void* in = in_array->Buffer()->GetContents().Data();
-#endif
-
-    uint32_t compact = To<uint32_t>(info[2]).FromJust();
-    uint32_t min_nonce = To<uint32_t>(info[3]).FromJust();
-    uint32_t max_nonce = To<uint32_t>(info[4]).FromJust();
-    uint32_t m_cost = To<uint32_t>(info[5]).FromJust();
-
-    AsyncQueueWorker(new MinerWorker(callback, in, inlen, compact, min_nonce, max_nonce, m_cost));
-}
-
-NAN_METHOD(node_sha256) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t inlen = in_array->Length();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    void* out = out_array->Buffer()->GetBackingStore()->Data();
-    void* in = in_array->Buffer()->GetBackingStore()->Data();
-#else
-    void* out = out_array->Buffer()->GetContents().Data();
-    void* in = in_array->Buffer()->GetContents().Data();
-#endif
+typedef int (*HashFunction)(void* out, const void* in, size_t inlen);
+
+class HashWorker : public PoolJob {
+    public:
+        HashWorker(HashFunction hash, void* out, void* in, size_t inlen)
+            : hash(hash), out(out), in(in), inlen(inlen), res(0) {}
+
+    protected:
+        void Execute() {
+            res = hash(out, in, inlen);
+        }
+
+        napi_value Result(napi_env env) {
+            return NewNumber(env, res);
+        }
+
+    private:
+        HashFunction hash;
+        void* out;
+        void* in;
+        size_t inlen;
+        int res;
+};
+
+typedef int (*VerifyFunction)(const unsigned char* signature, const unsigned char* message, size_t message_len, const unsigned char* public_key);
+
+class VerifyWorker : public PoolJob {
+    public:
+        VerifyWorker(VerifyFunction verify, uint8_t* signature, uint8_t* message, size_t message_len, uint8_t* public_key)
+            : verify(verify), signature(signature), message(message), message_len(message_len), public_key(public_key), res(0) {}
+
+    protected:
+        void Execute() {
+            res = verify(signature, message, message_len, public_key);
+        }
+
+        napi_value Result(napi_env env) {
+            return NewNumber(env, res);
+        }
+
+    private:
+        VerifyFunction verify;
+        uint8_t* signature;
+        uint8_t* message;
+        size_t message_len;
+        uint8_t* public_key;
+        int res;
+};
+
+// ECDSA signatures are DER encoded with a variable length, and the message is hashed with
+// SHA-256 first, like node_secp256k1_verify does.
+class EcdsaVerifyWorker : public PoolJob {
+    public:
+        EcdsaVerifyWorker(uint8_t* signature, size_t signature_len, uint8_t* message, size_t message_len, uint8_t* public_key)
+            : signature(signature), signature_len(signature_len), message(message), message_len(message_len), public_key(public_key), res(0) {}
+
+    protected:
+        void Execute() {
+            unsigned char msghash32[32];
+            krypton_sha256(msghash32, message, message_len);
+            res = secp256k1_verify(msghash32, public_key, signature, signature_len);
+        }
+
+        napi_value Result(napi_env env) {
+            return NewNumber(env, res);
+        }
+
+    private:
+        uint8_t* signature;
+        size_t signature_len;
+        uint8_t* message;
+        size_t message_len;
+        uint8_t* public_key;
+        int res;
+};
+
+class BatchWorker : public PoolJob {
+    public:
+        explicit BatchWorker(std::shared_ptr<CryptoBatch> batch) : batch(batch) {}
+
+    protected:
+        void Execute() {
+            batch->Work();
+            batch->Wait();
+        }
+
+        napi_value Result(napi_env env) {
+            napi_value result;
+            napi_get_undefined(env, &result);
+            return result;
+        }
+
+    private:
+        std::shared_ptr<CryptoBatch> batch;
+};
+
+// Runs a block body pre-validation (see block_body.h), sharing the transactions with the pool.
+static BlockBodyResult validate_block_body(std::shared_ptr<BlockBodyValidator> validator, CryptoPoolPriority priority) {
+    if (!validator->Parse()) return BLOCK_BODY_MALFORMED;
+    BlockBodyValidator::Share(validator, priority);
+    validator->Work();
+    validator->Wait();
+    return validator->Finish();
+}
+
+class BlockBodyWorker : public PoolJob {
+    public:
+        BlockBodyWorker(std::shared_ptr<BlockBodyValidator> validator, CryptoPoolPriority priority)
+            : validator(validator), priority(priority), result(BLOCK_BODY_MALFORMED) {}
+
+    protected:
+        void Execute() {
+            result = validate_block_body(validator, priority);
+        }
+
+        napi_value Result(napi_env env) {
+            return NewNumber(env, result);
+        }
+
+    private:
+        std::shared_ptr<BlockBodyValidator> validator;
+        CryptoPoolPriority priority;
+        BlockBodyResult result;
+};
+
+// Request ring shared with NativeCryptoRing.js (see crypto_ring.h). The consumer thread holds the
+// ring's own thread-safe function, which calls the JS completion callback at most once per batch.
+// The ring is deleted once that function and the JS handle were both finalized.
+class NodeCryptoRing : public CryptoRing {
+    public:
+        NodeCryptoRing(uint32_t* header, uint32_t* slots, size_t slot_count, uint8_t* data, size_t data_length, CryptoPoolPriority priority)
+            : CryptoRing(header, slots, slot_count, data, data_length, priority), complete(NULL), completion_pending(false), owners(2) {}
+
+        ~NodeCryptoRing() {
+            Stop();
+        }
+
+        static napi_value Create(napi_env env, Arguments& args, napi_value callback, CryptoPoolPriority priority) {
+            size_t header_length, slots_length, data_length;
+            uint32_t* header = args.Data<uint32_t>(1, &header_length);
+            uint32_t* slots = args.Data<uint32_t>(2, &slots_length);
+            uint8_t* data = args.Data(3, &data_length);
+            if (!args.ok()) return NULL;
+            if (header_length < CRYPTO_RING_HEADER_WORDS || slots_length == 0 || slots_length % CRYPTO_JOB_WORDS != 0) {
+                napi_throw_range_error(env, NULL, "Invalid crypto ring layout");
+                return NULL;
+            }
+
+            NodeCryptoRing* ring = new NodeCryptoRing(header, slots, slots_length / CRYPTO_JOB_WORDS, data, data_length, priority);
+            // The arrays are views of the same SharedArrayBuffer, referencing them keeps it alive.
+            for (size_t i = 0; i < 3; ++i) {
+                napi_create_reference(env, args[i + 1], 1, &ring->array_refs[i]);
+            }
+            napi_value resource_name;
+            napi_create_string_utf8(env, "krypton:crypto_ring", NAPI_AUTO_LENGTH, &resource_name);
+            napi_create_threadsafe_function(env, callback, NULL, resource_name, 0, 1, ring, Finalize, ring,
+                CallComplete, &ring->complete);
+            napi_unref_threadsafe_function(env, ring->complete);
+            ring->Start();
+
+            // A ring that JS never closed is stopped once its handle is garbage collected.
+            napi_value handle;
+            napi_create_external(env, ring, FinalizeHandle, NULL, &handle);
+            return handle;
+        }
+
+        // Keeps the event loop alive while JS waits for requests.
+        void Ref(napi_env env, bool ref) {
+            if (ref) {
+                napi_ref_threadsafe_function(env, complete);
+            } else {
+                napi_unref_threadsafe_function(env, complete);
+            }
+        }
+
+    protected:
+        void Completed() {
+            if (!completion_pending.exchange(true)) {
+                napi_call_threadsafe_function(complete, NULL, napi_tsfn_nonblocking);
+            }
+        }
+
+        void Stopped() {
+            napi_release_threadsafe_function(complete, napi_tsfn_release);
+        }
+
+    private:
+        static void CallComplete(napi_env env, napi_value js_callback, void* context, void* data) {
+            NodeCryptoRing* ring = (NodeCryptoRing*) context;
+            // Cleared before JS reads the completed counter, so no completion can be missed.
+            ring->completion_pending = false;
+            if (env) {
+                CallCallback(env, js_callback, 0, NULL);
+            }
+        }
+
+        // Runs once the consumer released the function after Stop(), or on environment teardown.
+        static void Finalize(napi_env env, void* data, void* hint) {
+            NodeCryptoRing* ring = (NodeCryptoRing*) data;
+            ring->Stop();
+            for (napi_ref ref : ring->array_refs) {
+                napi_delete_reference(env, ref);
+            }
+            ring->Release();
+        }
+
+        static void FinalizeHandle(napi_env env, void* data, void* hint) {
+            NodeCryptoRing* ring = (NodeCryptoRing*) data;
+            ring->RequestStop();
+            ring->Release();
+        }
+
+        // The ring is deleted once both the handle and the thread-safe function were finalized,
+        // both on the JS thread.
+        void Release() {
+            if (--owners == 0) delete this;
+        }
+
+        napi_threadsafe_function complete;
+        std::atomic<bool> completion_pending;
+        napi_ref array_refs[3];
+        int owners;
+};
+
+static int sha256_hash(void* out, const void* in, size_t inlen) {
+    krypton_sha256(out, in, inlen);
+    return 0;
+}
+
+static int schnorr_verify(const unsigned char* signature, const unsigned char* message, size_t message_len, const unsigned char* public_key) {
+    return secp256k1_schnorr_verify(signature, (unsigned char*) message, message_len, public_key);
+}
+
+// Native handle for an expanded ed25519 private key (see ed25519_signing_key_create).
+// The key is wiped when destroy() is called or the handle is garbage collected.
+class Ed25519SigningKey {
+    public:
+        static void Init(napi_env env, napi_value exports) {
+            napi_property_descriptor methods[] = {
+                {"publicKey", NULL, PublicKey, NULL, NULL, NULL, napi_default_method, NULL},
+                {"sign", NULL, Sign, NULL, NULL, NULL, napi_default_method, NULL},
+                {"delinearizedPartialSign", NULL, DelinearizedPartialSign, NULL, NULL, NULL, napi_default_method, NULL},
+                {"destroy", NULL, Destroy, NULL, NULL, NULL, napi_default_method, NULL}
+            };
+            napi_value constructor;
+            napi_define_class(env, "Ed25519SigningKey", NAPI_AUTO_LENGTH, Create, NULL,
+                sizeof(methods) / sizeof(methods[0]), methods, &constructor);
+            napi_set_named_property(env, exports, "Ed25519SigningKey", constructor);
+        }
+
+    private:
+        explicit Ed25519SigningKey(ed25519_signing_key* key) : key(key) {}
+        ~Ed25519SigningKey() {
+            ed25519_signing_key_destroy(key);
+        }
+
+        static Ed25519SigningKey* Unwrap(napi_env env, const Arguments& args) {
+            Ed25519SigningKey* obj = NULL;
+            if (napi_unwrap(env, args.This(), (void**) &obj) != napi_ok) {
+                napi_throw_type_error(env, NULL, "Illegal invocation");
+                return NULL;
+            }
+            return obj;
+        }
+
+        static ed25519_signing_key* Key(napi_env env, const Arguments& args) {
+            Ed25519SigningKey* obj = Unwrap(env, args);
+            if (!obj) return NULL;
+            if (!obj->key) {
+                napi_throw_error(env, NULL, "Signing key was destroyed");
+            }
+            return obj->key;
+        }
+
+        static void Finalize(napi_env env, void* data, void* hint) {
+            delete (Ed25519SigningKey*) data;
+        }
+
+        NAPI_METHOD(Create) {
+            napi_value new_target;
+            napi_get_new_target(env, info, &new_target);
+            if (!new_target) {
+                napi_throw_type_error(env, NULL, "Ed25519SigningKey must be called with new");
+                return NULL;
+            }
+            Arguments args(env, info);
+            uint8_t* privkey = args.Data(0);
+            if (!args.ok()) return NULL;
+
+            ed25519_signing_key* key = ed25519_signing_key_create(privkey);
+            if (!key) {
+                napi_throw_error(env, NULL, "Failed to allocate signing key");
+                return NULL;
+            }
+            Ed25519SigningKey* obj = new Ed25519SigningKey(key);
+            if (napi_wrap(env, args.This(), obj, Finalize, NULL, NULL) != napi_ok) {
+                delete obj;
+                napi_throw_error(env, NULL, "Failed to wrap signing key");
+                return NULL;
+            }
+            return args.This();
+        }
+
+        NAPI_METHOD(PublicKey) {
+            Arguments args(env, info);
+            ed25519_signing_key* key = Key(env, args);
+            if (!key) return NULL;
+            uint8_t* out = args.Data(0);
+            if (!args.ok()) return NULL;
+
+            ed25519_signing_key_public_key(out, key);
+            return NULL;
+        }
+
+        NAPI_METHOD(Sign) {
+            Arguments args(env, info);
+            ed25519_signing_key* key = Key(env, args);
+            if (!key) return NULL;
+            size_t message_length;
+            uint8_t* out = args.Data(0);
+            uint8_t* message = args.Data(1, &message_length);
+            if (!args.ok()) return NULL;
+
+            ed25519_signing_key_sign(out, message, message_length, key);
+            return NULL;
+        }
+
+        NAPI_METHOD(DelinearizedPartialSign) {
+            Arguments args(env, info);
+            ed25519_signing_key* key = Key(env, args);
+            if (!key) return NULL;
+            size_t message_length;
+            uint8_t* out = args.Data(0);
+            uint8_t* message = args.Data(1, &message_length);
+            uint8_t* commitment = args.Data(2);
+            uint8_t* secret = args.Data(3);
+            uint8_t* hash = args.Data(4);
+            uint8_t* aggregate = args.Data(5);
+            if (!args.ok()) return NULL;
+
+            ed25519_signing_key_delinearized_partial_sign(out, message, message_length, commitment, secret, hash, aggregate, key);
+            return NULL;
+        }
+
+        NAPI_METHOD(Destroy) {
+            Arguments args(env, info);
+            Ed25519SigningKey* obj = Unwrap(env, args);
+            if (!obj) return NULL;
+            ed25519_signing_key_destroy(obj->key);
+            obj->key = NULL;
+            return NULL;
+        }
+
+        ed25519_signing_key* key;
+};
+
+// Native handle for a secp256k1 multisig signing session (see secp256k1_multisig_session_init).
+// The session holds the delinearized private key and the commitment secret, so it never leaves
+// native memory and is wiped when destroy() is called or the handle is garbage collected. The
+// methods return 1 on success and 0 if the keys, commitments or signatures are invalid, and throw
+// a RangeError for buffers of the wrong size.
+class Secp256k1MultiSigSession {
+    public:
+        static void Init(napi_env env, napi_value exports) {
+            napi_property_descriptor methods[] = {
+                {"aggregatePublicKey", NULL, AggregatePublicKey, NULL, NULL, NULL, napi_default_method, NULL},
+                {"createCommitment", NULL, CreateCommitment, NULL, NULL, NULL, napi_default_method, NULL},
+                {"aggregateCommitments", NULL, AggregateCommitments, NULL, NULL, NULL, napi_default_method, NULL},
+                {"setCommitment", NULL, SetCommitment, NULL, NULL, NULL, napi_default_method, NULL},
+                {"partialSign", NULL, PartialSign, NULL, NULL, NULL, napi_default_method, NULL},
+                {"combine", NULL, Combine, NULL, NULL, NULL, napi_default_method, NULL},
+                {"destroy", NULL, Destroy, NULL, NULL, NULL, napi_default_method, NULL}
+            };
+            napi_value constructor;
+            napi_define_class(env, "Secp256k1MultiSigSession", NAPI_AUTO_LENGTH, Create, NULL,
+                sizeof(methods) / sizeof(methods[0]), methods, &constructor);
+            napi_set_named_property(env, exports, "Secp256k1MultiSigSession", constructor);
+        }
+
+    private:
+        // Private keys, commitment secrets and randomness are scalars, signatures are R.x || s.
+        enum { SCALAR_SIZE = 32, SCHNORR_SIGNATURE_SIZE = 64 };
+
+        Secp256k1MultiSigSession() : session(new uint8_t[secp256k1_multisig_session_size()]) {
+            secp256k1_multisig_session_clear(session);
+        }
+        ~Secp256k1MultiSigSession() {
+            Clear();
+        }
+
+        void Clear() {
+            if (!session) return;
+            secp256k1_multisig_session_clear(session);
+            delete[] session;
+            session = NULL;
+        }
+
+        static uint8_t* Session(napi_env env, const Arguments& args) {
+            Secp256k1MultiSigSession* obj = NULL;
+            if (napi_unwrap(env, args.This(), (void**) &obj) != napi_ok) {
+                napi_throw_type_error(env, NULL, "Illegal invocation");
+                return NULL;
+            }
+            if (!obj->session) {
+                napi_throw_error(env, NULL, "Multisig session was destroyed");
+            }
+            return obj->session;
+        }
+
+        static bool IsPointSize(size_t size) {
+            return size == PUBKEY_COMPRESSED_SIZE || size == PUBKEY_SIZE;
+        }
+
+        static napi_value InvalidSize(napi_env env) {
+            napi_throw_range_error(env, NULL, "Invalid multisig buffer size");
+            return NULL;
+        }
+
+        static void Finalize(napi_env env, void* data, void* hint) {
+            delete (Secp256k1MultiSigSession*) data;
+        }
+
+        NAPI_METHOD(Create) {
+            napi_value new_target;
+            napi_get_new_target(env, info, &new_target);
+            if (!new_target) {
+                napi_throw_type_error(env, NULL, "Secp256k1MultiSigSession must be called with new");
+                return NULL;
+            }
+            Arguments args(env, info);
+            size_t pubkeys_length, pubkey_length, seckey_length;
+            uint8_t* pubkeys = args.Data(0, &pubkeys_length);
+            uint32_t num_cosigners = args.Uint32(1);
+            uint8_t* pubkey = args.Data(2, &pubkey_length);
+            uint8_t* seckey = args.Data(3, &seckey_length);
+            if (!args.ok()) return NULL;
+            if (num_cosigners == 0 || pubkeys_length != (size_t) num_cosigners * PUBKEY_COMPRESSED_SIZE
+                    || pubkey_length != PUBKEY_COMPRESSED_SIZE || seckey_length != SCALAR_SIZE) {
+                return InvalidSize(env);
+            }
+
+            Secp256k1MultiSigSession* obj = new Secp256k1MultiSigSession();
+            if (!secp256k1_multisig_session_init(obj->session, pubkeys, num_cosigners, pubkey, seckey)) {
+                delete obj;
+                napi_throw_error(env, NULL, "Invalid multisig session keys");
+                return NULL;
+            }
+            if (napi_wrap(env, args.This(), obj, Finalize, NULL, NULL) != napi_ok) {
+                delete obj;
+                napi_throw_error(env, NULL, "Failed to wrap multisig session");
+                return NULL;
+            }
+            return args.This();
+        }
+
+        NAPI_METHOD(AggregatePublicKey) {
+            Arguments args(env, info);
+            uint8_t* session = Session(env, args);
+            if (!session) return NULL;
+            size_t out_length;
+            uint8_t* out = args.Data(0, &out_length);
+            if (!args.ok()) return NULL;
+            if (!IsPointSize(out_length)) return InvalidSize(env);
+
+            return NewNumber(env, secp256k1_multisig_session_aggregate_pubkey(session, out, out_length));
+        }
+
+        NAPI_METHOD(CreateCommitment) {
+            Arguments args(env, info);
+            uint8_t* session = Session(env, args);
+            if (!session) return NULL;
+            size_t out_length, randomness_length;
+            uint8_t* out = args.Data(0, &out_length);
+            uint8_t* randomness = args.Data(1, &randomness_length);
+            if (!args.ok()) return NULL;
+            if (!IsPointSize(out_length) || randomness_length != SCALAR_SIZE) return InvalidSize(env);
+
+            // The secret stays in the session.
+            return NewNumber(env, secp256k1_multisig_session_create_commitment(session, NULL, out, out_length, randomness));
+        }
+
+        NAPI_METHOD(AggregateCommitments) {
+            Arguments args(env, info);
+            uint8_t* session = Session(env, args);
+            if (!session) return NULL;
+            size_t out_length, commitments_length;
+            uint8_t* out = args.Data(0, &out_length);
+            uint8_t* commitments = args.Data(1, &commitments_length);
+            uint32_t num_commitments = args.Uint32(2);
+            if (!args.ok()) return NULL;
+            if (!IsPointSize(out_length) || commitments_length != (size_t) num_commitments * out_length) return InvalidSize(env);
+
+            return NewNumber(env, secp256k1_multisig_session_aggregate_commitments(session, out, commitments, num_commitments, out_length));
+        }
+
+        NAPI_METHOD(SetCommitment) {
+            Arguments args(env, info);
+            uint8_t* session = Session(env, args);
+            if (!session) return NULL;
+            size_t secret_length, commitment_length;
+            uint8_t* secret = args.Data(0, &secret_length);
+            uint8_t* commitment = args.Data(1, &commitment_length);
+            if (!args.ok()) return NULL;
+            if (secret_length != SCALAR_SIZE || !IsPointSize(commitment_length)) return InvalidSize(env);
+
+            return NewNumber(env, secp256k1_multisig_session_set_commitment(session, secret, commitment, commitment_length));
+        }
+
+        NAPI_METHOD(PartialSign) {
+            Arguments args(env, info);
+            uint8_t* session = Session(env, args);
+            if (!session) return NULL;
+            size_t out_length, message_length;
+            uint8_t* out = args.Data(0, &out_length);
+            uint8_t* message = args.Data(1, &message_length);
+            if (!args.ok()) return NULL;
+            if (out_length != SCHNORR_SIGNATURE_SIZE) return InvalidSize(env);
+
+            return NewNumber(env, secp256k1_multisig_session_partial_sign(session, out, message, message_length));
+        }
+
+        NAPI_METHOD(Combine) {
+            Arguments args(env, info);
+            uint8_t* session = Session(env, args);
+            if (!session) return NULL;
+            size_t out_length, signatures_length;
+            uint8_t* out = args.Data(0, &out_length);
+            uint8_t* signatures = args.Data(1, &signatures_length);
+            uint32_t num_signatures = args.Uint32(2);
+            if (!args.ok()) return NULL;
+            if (out_length != SCHNORR_SIGNATURE_SIZE || signatures_length != (size_t) num_signatures * SCHNORR_SIGNATURE_SIZE) return InvalidSize(env);
+
+            return NewNumber(env, secp256k1_multisig_session_combine(session, out, signatures, num_signatures));
+        }
+
+        NAPI_METHOD(Destroy) {
+            Arguments args(env, info);
+            Secp256k1MultiSigSession* obj = NULL;
+            if (napi_unwrap(env, args.This(), (void**) &obj) != napi_ok) {
+                napi_throw_type_error(env, NULL, "Illegal invocation");
+                return NULL;
+            }
+            obj->Clear();
+            return NULL;
+        }
+
+        uint8_t* session;
+};
+
+NAPI_METHOD(node_argon2_target_async) {
+    Arguments args(env, info);
+    size_t inlen;
+    napi_value callback = args.Function(0);
+    void* in = args.Data(1, &inlen);
+    uint32_t compact = args.Uint32(2);
+    uint32_t min_nonce = args.Uint32(3);
+    uint32_t max_nonce = args.Uint32(4);
+    uint32_t m_cost = args.Uint32(5);
+    CryptoPoolPriority priority = args.Priority(6, CRYPTO_POOL_MINING);
+    if (!args.ok()) return NULL;
+
+    MinerWorker* worker = new MinerWorker(in, inlen, compact, min_nonce, max_nonce, m_cost);
+    if (!worker->Queue(env, callback, {args[1]}, priority)) {
+        delete worker;
+    }
+    return NULL;
+}
+
+NAPI_METHOD(node_sha256) {
+    Arguments args(env, info);
+    size_t inlen;
+    void* out = args.Data(0);
+    void* in = args.Data(1, &inlen);
+    if (!args.ok()) return NULL;
+
     krypton_sha256(out, in, inlen);
+    return NULL;
 }
 
-NAN_METHOD(node_sha512) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t inlen = in_array->Length();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    void* out = out_array->Buffer()->GetBackingStore()->Data();
-    void* in = in_array->Buffer()->GetBackingStore()->Data();
-#else
-    void* out = out_array->Buffer()->GetContents().Data();
-    void* in = in_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_sha512) {
+    Arguments args(env, info);
+    size_t inlen;
+    void* out = args.Data(0);
+    void* in = args.Data(1, &inlen);
+    if (!args.ok()) return NULL;
+
     krypton_sha512(out, in, inlen);
+    return NULL;
 }
 
-NAN_METHOD(node_blake2) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t inlen = in_array->Length();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    void* out = out_array->Buffer()->GetBackingStore()->Data();
-    void* in = in_array->Buffer()->GetBackingStore()->Data();
-#else
-    void* out = out_array->Buffer()->GetContents().Data();
-    void* in = in_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_blake2) {
+    Arguments args(env, info);
+    size_t inlen;
+    void* out = args.Data(0);
+    void* in = args.Data(1, &inlen);
+    if (!args.ok()) return NULL;
+
     krypton_blake2(out, in, inlen);
+    return NULL;
+}
+
+NAPI_METHOD(node_argon2) {
+    Arguments args(env, info);
+    size_t inlen;
+    void* out = args.Data(0);
+    void* in = args.Data(1, &inlen);
+    uint32_t m_cost = args.Uint32(2);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, krypton_argon2(out, in, inlen, m_cost));
 }
 
-NAN_METHOD(node_argon2) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t m_cost = To<uint32_t>(info[2]).FromJust();
-    uint32_t inlen = in_array->Length();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    void* out = out_array->Buffer()->GetBackingStore()->Data();
-    void* in = in_array->Buffer()->GetBackingStore()->Data();
-#else
-    void* out = out_array->Buffer()->GetContents().Data();
-    void* in = in_array->Buffer()->GetContents().Data();
-#endif
-
-    info.GetReturnValue().Set(New<Number>(krypton_argon2(out, in, inlen, m_cost)));
-}
-
-NAN_METHOD(node_argon2_async) {
-    Callback* callback = new Callback(info[0].As<Function>());
-
-    Local<Uint8Array> out_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[2].As<Uint8Array>();
-    uint32_t m_cost = To<uint32_t>(info[3]).FromJust();
-    uint32_t inlen = in_array->Length();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    void* out = out_array->Buffer()->GetBackingStore()->Data();
-    void* in = in_array->Buffer()->GetBackingStore()->Data();
-#else
-    void* out = out_array->Buffer()->GetContents().Data();
-    void* in = in_array->Buffer()->GetContents().Data();
-#endif
-    AsyncQueueWorker(new Argon2Worker(callback, out, in, inlen, m_cost));
-}
-
-NAN_METHOD(node_ed25519_public_key_derive) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_argon2_async) {
+    Arguments args(env, info);
+    size_t inlen;
+    napi_value callback = args.Function(0);
+    void* out = args.Data(1);
+    void* in = args.Data(2, &inlen);
+    uint32_t m_cost = args.Uint32(3);
+    CryptoPoolPriority priority = args.Priority(4, CRYPTO_POOL_CONSENSUS);
+    if (!args.ok()) return NULL;
+
+    Argon2Worker* worker = new Argon2Worker(out, in, inlen, m_cost);
+    if (!worker->Queue(env, callback, {args[1], args[2]}, priority)) {
+        delete worker;
+    }
+    return NULL;
+}
+
+static napi_value queue_hash(napi_env env, napi_callback_info info, HashFunction hash) {
+    Arguments args(env, info);
+    size_t inlen;
+    napi_value callback = args.Function(0);
+    void* out = args.Data(1);
+    void* in = args.Data(2, &inlen);
+    CryptoPoolPriority priority = args.Priority(3, CRYPTO_POOL_CONSENSUS);
+    if (!args.ok()) return NULL;
+
+    HashWorker* worker = new HashWorker(hash, out, in, inlen);
+    if (!worker->Queue(env, callback, {args[1], args[2]}, priority)) {
+        delete worker;
+    }
+    return NULL;
+}
+
+NAPI_METHOD(node_sha256_async) {
+    return queue_hash(env, info, sha256_hash);
+}
+
+NAPI_METHOD(node_blake2_async) {
+    return queue_hash(env, info, krypton_blake2);
+}
+
+static napi_value queue_verify(napi_env env, napi_callback_info info, VerifyFunction verify) {
+    Arguments args(env, info);
+    size_t message_length;
+    napi_value callback = args.Function(0);
+    uint8_t* signature = args.Data(1);
+    uint8_t* message = args.Data(2, &message_length);
+    uint8_t* pubkey = args.Data(3);
+    CryptoPoolPriority priority = args.Priority(4, CRYPTO_POOL_CONSENSUS);
+    if (!args.ok()) return NULL;
+
+    VerifyWorker* worker = new VerifyWorker(verify, signature, message, message_length, pubkey);
+    if (!worker->Queue(env, callback, {args[1], args[2], args[3]}, priority)) {
+        delete worker;
+    }
+    return NULL;
+}
+
+NAPI_METHOD(node_ed25519_verify_async) {
+    return queue_verify(env, info, ed25519_verify);
+}
+
+NAPI_METHOD(node_secp256k1_schnorr_verify_async) {
+    return queue_verify(env, info, schnorr_verify);
+}
+
+NAPI_METHOD(node_secp256k1_verify_async) {
+    Arguments args(env, info);
+    size_t signature_length, message_length;
+    napi_value callback = args.Function(0);
+    uint8_t* signature = args.Data(1, &signature_length);
+    uint8_t* message = args.Data(2, &message_length);
+    uint8_t* pubkey = args.Data(3);
+    CryptoPoolPriority priority = args.Priority(4, CRYPTO_POOL_CONSENSUS);
+    if (!args.ok()) return NULL;
+
+    EcdsaVerifyWorker* worker = new EcdsaVerifyWorker(signature, signature_length, message, message_length, pubkey);
+    if (!worker->Queue(env, callback, {args[1], args[2], args[3]}, priority)) {
+        delete worker;
+    }
+    return NULL;
+}
+
+// Validates a batch of jobs (see crypto_batch.h), throws a RangeError naming the first invalid one.
+static std::shared_ptr<CryptoBatch> create_batch(napi_env env, Arguments& args, size_t index) {
+    size_t words, input_length, output_length;
+    uint32_t* jobs = args.Data<uint32_t>(index, &words);
+    uint8_t* input = args.Data(index + 1, &input_length);
+    uint8_t* output = args.Data(index + 2, &output_length);
+    if (!args.ok()) return NULL;
+    if (words % CRYPTO_JOB_WORDS != 0) {
+        napi_throw_range_error(env, NULL, "Invalid crypto job list length");
+        return NULL;
+    }
+
+    std::shared_ptr<CryptoBatch> batch = std::make_shared<CryptoBatch>(jobs, words / CRYPTO_JOB_WORDS, input, output);
+    long invalid = batch->Validate(input_length, output_length);
+    if (invalid >= 0) {
+        char message[64];
+        snprintf(message, sizeof(message), "Invalid crypto job %ld", invalid);
+        napi_throw_range_error(env, NULL, message);
+        return NULL;
+    }
+    return batch;
+}
+
+NAPI_METHOD(node_crypto_batch) {
+    Arguments args(env, info);
+    std::shared_ptr<CryptoBatch> batch = create_batch(env, args, 0);
+    CryptoPoolPriority priority = args.Priority(3, CRYPTO_POOL_CONSENSUS);
+    if (!batch || !args.ok()) return NULL;
+
+    // Large batches are shared with the pool; the calling thread only blocks for the jobs still
+    // running on a pool thread once it has run out of jobs itself.
+    CryptoBatch::Share(batch, priority);
+    batch->Work();
+    batch->Wait();
+    return NULL;
+}
+
+NAPI_METHOD(node_crypto_batch_async) {
+    Arguments args(env, info);
+    napi_value callback = args.Function(0);
+    std::shared_ptr<CryptoBatch> batch = create_batch(env, args, 1);
+    CryptoPoolPriority priority = args.Priority(4, CRYPTO_POOL_CONSENSUS);
+    if (!batch || !args.ok()) return NULL;
+
+    BatchWorker* worker = new BatchWorker(batch);
+    if (!worker->Queue(env, callback, {args[2], args[3]}, priority)) {
+        delete worker;
+        return NULL;
+    }
+    CryptoBatch::Share(batch, priority);
+    return NULL;
+}
+
+NAPI_METHOD(node_block_body_prevalidate) {
+    Arguments args(env, info);
+    size_t body_length, report_length;
+    uint8_t* body = args.Data(0, &body_length);
+    uint32_t network_id = args.Uint32(1);
+    uint8_t* report = args.Data(2, &report_length);
+    CryptoPoolPriority priority = args.Priority(3, CRYPTO_POOL_CONSENSUS);
+    if (!args.ok()) return NULL;
+
+    std::shared_ptr<BlockBodyValidator> validator = std::make_shared<BlockBodyValidator>(body, body_length, network_id, report, report_length);
+    return NewNumber(env, validate_block_body(validator, priority));
+}
+
+NAPI_METHOD(node_block_body_prevalidate_async) {
+    Arguments args(env, info);
+    napi_value callback = args.Function(0);
+    size_t body_length, report_length;
+    uint8_t* body = args.Data(1, &body_length);
+    uint32_t network_id = args.Uint32(2);
+    uint8_t* report = args.Data(3, &report_length);
+    CryptoPoolPriority priority = args.Priority(4, CRYPTO_POOL_CONSENSUS);
+    if (!args.ok()) return NULL;
+
+    // The body is parsed on the pool thread as well.
+    std::shared_ptr<BlockBodyValidator> validator = std::make_shared<BlockBodyValidator>(body, body_length, network_id, report, report_length);
+    BlockBodyWorker* worker = new BlockBodyWorker(validator, priority);
+    if (!worker->Queue(env, callback, {args[1], args[3]}, priority)) {
+        delete worker;
+    }
+    return NULL;
+}
+
+static napi_value NewUint8Array(napi_env env, const std::vector<uint8_t>& data) {
+    void* copy;
+    napi_value buffer;
+    napi_create_buffer_copy(env, data.size(), data.data(), &copy, &buffer);
+    return buffer;
+}
+
+// Applies a batch of account updates to the accounts tree (see accounts_tree.h) and writes the
+// new root hash. updates holds address, account length (uint16) and serialized account of each
+// update. load(prefix) is called for the branch nodes the updates descend into and returns the
+// serialized node, or undefined if it is missing. Returns the changed nodes and the removed
+// prefixes as {puts, removals}.
+NAPI_METHOD(node_accounts_tree_update) {
+    Arguments args(env, info);
+    napi_value load = args.Function(0);
+    size_t updates_length, root_length;
+    uint8_t* updates = args.Data(1, &updates_length);
+    uint8_t* root = args.Data(2, &root_length);
+    if (!args.ok()) return NULL;
+    if (root_length != ACCOUNTS_TREE_HASH_SIZE) {
+        napi_throw_range_error(env, NULL, "Invalid root hash length");
+        return NULL;
+    }
+
+    AccountsTrie trie([env, load](const std::string& prefix, std::vector<uint8_t>& node) {
+        napi_value global, key, result;
+        napi_get_global(env, &global);
+        napi_create_string_latin1(env, prefix.data(), prefix.size(), &key);
+        if (napi_call_function(env, global, load, 1, &key, &result) != napi_ok) return false;
+
+        napi_typedarray_type type;
+        size_t length;
+        void* data;
+        if (napi_get_typedarray_info(env, result, &type, &length, &data, NULL, NULL) != napi_ok || type != napi_uint8_array) {
+            return false;
+        }
+        node.assign((uint8_t*) data, (uint8_t*) data + length);
+        return true;
+    });
+
+    bool ok = trie.Init();
+    for (size_t pos = 0; ok && pos < updates_length; ) {
+        if (updates_length - pos < ACCOUNTS_TREE_ADDRESS_SIZE + 2) {
+            napi_throw_range_error(env, NULL, "Malformed accounts tree update");
+            return NULL;
+        }
+        const uint8_t* address = updates + pos;
+        size_t account_length = (updates[pos + ACCOUNTS_TREE_ADDRESS_SIZE] << 8) | updates[pos + ACCOUNTS_TREE_ADDRESS_SIZE + 1];
+        pos += ACCOUNTS_TREE_ADDRESS_SIZE + 2;
+        if (updates_length - pos < account_length) {
+            napi_throw_range_error(env, NULL, "Malformed accounts tree update");
+            return NULL;
+        }
+        ok = trie.Put(address, updates + pos, account_length);
+        pos += account_length;
+    }
+    if (!ok) {
+        // Rethrow an exception of the loader as it is.
+        bool pending = false;
+        napi_is_exception_pending(env, &pending);
+        if (!pending) napi_throw_error(env, NULL, "Corrupted store: Failed to fetch AccountsTree node");
+        return NULL;
+    }
+
+    std::vector<uint8_t> puts, removals;
+    trie.Finish(root, puts, removals);
+
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_set_named_property(env, result, "puts", NewUint8Array(env, puts));
+    napi_set_named_property(env, result, "removals", NewUint8Array(env, removals));
+    return result;
+}
+
+// Verifies a serialized AccountsProof (see accounts_tree.h) and writes the hashes of its nodes,
+// 32 bytes each. Returns 1 if the proof is valid, 0 otherwise.
+NAPI_METHOD(node_accounts_proof_verify) {
+    Arguments args(env, info);
+    size_t proof_length, hashes_length;
+    uint8_t* proof = args.Data(0, &proof_length);
+    uint8_t* hashes = args.Data(1, &hashes_length);
+    if (!args.ok()) return NULL;
+    if (hashes_length % ACCOUNTS_TREE_HASH_SIZE != 0) {
+        napi_throw_range_error(env, NULL, "Invalid proof hashes length");
+        return NULL;
+    }
+
+    return NewNumber(env, accounts_tree_proof_verify(proof, proof_length, hashes, hashes_length / ACCOUNTS_TREE_HASH_SIZE));
+}
+
+// Verifies a serialized AccountsTreeChunk (see accounts_tree.h) and writes the hashes of the nodes
+// of its proof, 32 bytes each. Returns 1 if the chunk is valid, 0 otherwise.
+NAPI_METHOD(node_accounts_tree_chunk_verify) {
+    Arguments args(env, info);
+    size_t chunk_length, hashes_length;
+    uint8_t* chunk = args.Data(0, &chunk_length);
+    uint8_t* hashes = args.Data(1, &hashes_length);
+    if (!args.ok()) return NULL;
+    if (hashes_length % ACCOUNTS_TREE_HASH_SIZE != 0) {
+        napi_throw_range_error(env, NULL, "Invalid proof hashes length");
+        return NULL;
+    }
+
+    return NewNumber(env, accounts_tree_chunk_verify(chunk, chunk_length, hashes, hashes_length / ACCOUNTS_TREE_HASH_SIZE));
+}
+
+NAPI_METHOD(node_crypto_ring_create) {
+    Arguments args(env, info);
+    napi_value callback = args.Function(0);
+    CryptoPoolPriority priority = args.Priority(4, CRYPTO_POOL_MEMPOOL);
+    if (!args.ok()) return NULL;
+
+    return NodeCryptoRing::Create(env, args, callback, priority);
+}
+
+NAPI_METHOD(node_crypto_ring_notify) {
+    Arguments args(env, info);
+    NodeCryptoRing* ring = args.External<NodeCryptoRing>(0);
+    if (!args.ok()) return NULL;
+
+    ring->Notify();
+    return NULL;
+}
+
+NAPI_METHOD(node_crypto_ring_ref) {
+    Arguments args(env, info);
+    NodeCryptoRing* ring = args.External<NodeCryptoRing>(0);
+    bool ref = args.Bool(1);
+    if (!args.ok()) return NULL;
+
+    ring->Ref(env, ref);
+    return NULL;
+}
+
+// Does not wait for the consumer: it finishes its current batch, releases the function on its way
+// out and is joined in Finalize.
+NAPI_METHOD(node_crypto_ring_close) {
+    Arguments args(env, info);
+    NodeCryptoRing* ring = args.External<NodeCryptoRing>(0);
+    if (!args.ok()) return NULL;
+
+    ring->RequestStop();
+    return NULL;
+}
+
+NAPI_METHOD(node_crypto_pool_configure) {
+    Arguments args(env, info);
+    uint32_t threads = args.Uint32(0);
+    if (!args.ok()) return NULL;
+
+    napi_value result;
+    napi_get_boolean(env, CryptoPool::Instance().Configure(threads), &result);
+    return result;
+}
+
+static napi_value NewNumberArray(napi_env env, const uint64_t* values, size_t count) {
+    napi_value result;
+    napi_create_array_with_length(env, count, &result);
+    for (size_t i = 0; i < count; ++i) {
+        napi_set_element(env, result, i, NewNumber(env, (double) values[i]));
+    }
+    return result;
+}
+
+NAPI_METHOD(node_crypto_pool_stats) {
+    CryptoPoolStats stats = CryptoPool::Instance().Stats();
+
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_set_named_property(env, result, "threads", NewNumber(env, stats.threads));
+    napi_set_named_property(env, result, "running", NewNumber(env, stats.running));
+    napi_set_named_property(env, result, "queued", NewNumberArray(env, stats.queued, CRYPTO_POOL_PRIORITIES));
+    napi_set_named_property(env, result, "completed", NewNumberArray(env, stats.completed, CRYPTO_POOL_PRIORITIES));
+    napi_set_named_property(env, result, "busyTime", NewNumber(env, stats.busy_seconds));
+    napi_set_named_property(env, result, "uptime", NewNumber(env, stats.uptime_seconds));
+    return result;
+}
+
+NAPI_METHOD(node_ed25519_public_key_derive) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* in = args.Data(1);
+    if (!args.ok()) return NULL;
 
     ed25519_public_key_derive(out, in);
+    return NULL;
 }
 
-NAN_METHOD(node_ed25519_hash_public_keys) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t length = To<uint32_t>(info[2]).FromJust();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_ed25519_hash_public_keys) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* in = args.Data(1);
+    uint32_t length = args.Uint32(2);
+    if (!args.ok()) return NULL;
 
     ed25519_hash_public_keys(out, in, length);
+    return NULL;
 }
 
-NAN_METHOD(node_ed25519_delinearize_public_key) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> hash_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> key_array = info[2].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* hash = (uint8_t*) hash_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* key = (uint8_t*) key_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* hash = (uint8_t*) hash_array->Buffer()->GetContents().Data();
-    uint8_t* key = (uint8_t*) key_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_ed25519_delinearize_public_key) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* hash = args.Data(1);
+    uint8_t* key = args.Data(2);
+    if (!args.ok()) return NULL;
 
     ed25519_delinearize_public_key(out, hash, key);
+    return NULL;
 }
 
-NAN_METHOD(node_ed25519_aggregate_delinearized_public_keys) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> hash_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> keys_array = info[2].As<Uint8Array>();
-    uint32_t length = To<uint32_t>(info[3]).FromJust();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* hash = (uint8_t*) hash_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* keys = (uint8_t*) keys_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* hash = (uint8_t*) hash_array->Buffer()->GetContents().Data();
-    uint8_t* keys = (uint8_t*) keys_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_ed25519_aggregate_delinearized_public_keys) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* hash = args.Data(1);
+    uint8_t* keys = args.Data(2);
+    uint32_t length = args.Uint32(3);
+    if (!args.ok()) return NULL;
 
     ed25519_aggregate_delinearized_public_keys(out, hash, keys, length);
+    return NULL;
 }
 
-NAN_METHOD(node_ed25519_add_scalars) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> a_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> b_array = info[2].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* a = (uint8_t*) a_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* b = (uint8_t*) b_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* a = (uint8_t*) a_array->Buffer()->GetContents().Data();
-    uint8_t* b = (uint8_t*) b_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_ed25519_add_scalars) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* a = args.Data(1);
+    uint8_t* b = args.Data(2);
+    if (!args.ok()) return NULL;
 
     ed25519_add_scalars(out, a, b);
+    return NULL;
 }
 
-NAN_METHOD(node_ed25519_sign) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> pubkey_array = info[2].As<Uint8Array>();
-    Local<Uint8Array> privkey_array = info[3].As<Uint8Array>();
-    uint32_t message_length = message_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* privkey = (uint8_t*) privkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetContents().Data();
-    uint8_t* privkey = (uint8_t*) privkey_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_ed25519_sign) {
+    Arguments args(env, info);
+    size_t message_length;
+    uint8_t* out = args.Data(0);
+    uint8_t* message = args.Data(1, &message_length);
+    uint8_t* pubkey = args.Data(2);
+    uint8_t* privkey = args.Data(3);
+    if (!args.ok()) return NULL;
 
     ed25519_sign(out, message, message_length, pubkey, privkey);
+    return NULL;
 }
 
-NAN_METHOD(node_ed25519_verify) {
-    Local<Uint8Array> signature_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> pubkey_array = info[2].As<Uint8Array>();
-    uint32_t message_length = message_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* signature = (uint8_t*) signature_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* signature = (uint8_t*) signature_array->Buffer()->GetContents().Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetContents().Data();
-#endif
-
-    info.GetReturnValue().Set(New<Number>(ed25519_verify(signature, message, message_length, pubkey)));
-}
-
-NAN_METHOD(node_kdf_legacy) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> key_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> salt_array = info[2].As<Uint8Array>();
-    uint32_t m_cost = To<uint32_t>(info[3]).FromJust();
-    uint32_t iterations = To<uint32_t>(info[4]).FromJust();
-    uint32_t outlen = out_array->Length();
-    uint32_t keylen = key_array->Length();
-    uint32_t saltlen = salt_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    void* out = out_array->Buffer()->GetBackingStore()->Data();
-    void* key = key_array->Buffer()->GetBackingStore()->Data();
-    void* salt = salt_array->Buffer()->GetBackingStore()->Data();
-#else
-    void* out = out_array->Buffer()->GetContents().Data();
-    void* key = key_array->Buffer()->GetContents().Data();
-    void* salt = salt_array->Buffer()->GetContents().Data();
-#endif
-
-    info.GetReturnValue().Set(New<Number>(krypton_kdf_legacy(out, outlen, key, keylen, salt, saltlen, m_cost, iterations)));
-}
-
-NAN_METHOD(node_kdf) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> key_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> salt_array = info[2].As<Uint8Array>();
-    uint32_t m_cost = To<uint32_t>(info[3]).FromJust();
-    uint32_t iterations = To<uint32_t>(info[4]).FromJust();
-    uint32_t outlen = out_array->Length();
-    uint32_t keylen = key_array->Length();
-    uint32_t saltlen = salt_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    void* out = out_array->Buffer()->GetBackingStore()->Data();
-    void* key = key_array->Buffer()->GetBackingStore()->Data();
-    void* salt = salt_array->Buffer()->GetBackingStore()->Data();
-#else
-    void* out = out_array->Buffer()->GetContents().Data();
-    void* key = key_array->Buffer()->GetContents().Data();
-    void* salt = salt_array->Buffer()->GetContents().Data();
-#endif
-
-    info.GetReturnValue().Set(New<Number>(krypton_kdf(out, outlen, key, keylen, salt, saltlen, m_cost, iterations)));
-}
-
-NAN_METHOD(node_ed25519_aggregate_commitments) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t length = To<uint32_t>(info[2]).FromJust();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_ed25519_verify) {
+    Arguments args(env, info);
+    size_t message_length;
+    uint8_t* signature = args.Data(0);
+    uint8_t* message = args.Data(1, &message_length);
+    uint8_t* pubkey = args.Data(2);
+    if (!args.ok()) return NULL;
 
-    ed25519_aggregate_commitments(out, in, length);
+    return NewNumber(env, ed25519_verify(signature, message, message_length, pubkey));
+}
+
+NAPI_METHOD(node_kdf_legacy) {
+    Arguments args(env, info);
+    size_t outlen, keylen, saltlen;
+    void* out = args.Data(0, &outlen);
+    void* key = args.Data(1, &keylen);
+    void* salt = args.Data(2, &saltlen);
+    uint32_t m_cost = args.Uint32(3);
+    uint32_t iterations = args.Uint32(4);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, krypton_kdf_legacy(out, outlen, key, keylen, salt, saltlen, m_cost, iterations));
+}
+
+NAPI_METHOD(node_kdf) {
+    Arguments args(env, info);
+    size_t outlen, keylen, saltlen;
+    void* out = args.Data(0, &outlen);
+    void* key = args.Data(1, &keylen);
+    void* salt = args.Data(2, &saltlen);
+    uint32_t m_cost = args.Uint32(3);
+    uint32_t iterations = args.Uint32(4);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, krypton_kdf(out, outlen, key, keylen, salt, saltlen, m_cost, iterations));
 }
 
-NAN_METHOD(node_ed25519_create_commitment) {
-    Local<Uint8Array> out_secret_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> out_commitment_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[2].As<Uint8Array>();
+NAPI_METHOD(node_ed25519_aggregate_commitments) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* in = args.Data(1);
+    uint32_t length = args.Uint32(2);
+    if (!args.ok()) return NULL;
 
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out_secret = (uint8_t*) out_secret_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* out_commitment = (uint8_t*) out_commitment_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out_secret = (uint8_t*) out_secret_array->Buffer()->GetContents().Data();
-    uint8_t* out_commitment = (uint8_t*) out_commitment_array->Buffer()->GetContents().Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
+    ed25519_aggregate_commitments(out, in, length);
+    return NULL;
+}
+
+NAPI_METHOD(node_ed25519_create_commitment) {
+    Arguments args(env, info);
+    uint8_t* out_secret = args.Data(0);
+    uint8_t* out_commitment = args.Data(1);
+    uint8_t* in = args.Data(2);
+    if (!args.ok()) return NULL;
 
     ed25519_create_commitment(out_secret, out_commitment, in);
+    return NULL;
 }
 
-NAN_METHOD(node_ed25519_derive_delinearized_private_key) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_hash_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> in_public_array = info[2].As<Uint8Array>();
-    Local<Uint8Array> in_private_array = info[3].As<Uint8Array>();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in_hash = (uint8_t*) in_hash_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in_public = (uint8_t*) in_public_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in_private = (uint8_t*) in_private_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* in_hash = (uint8_t*) in_hash_array->Buffer()->GetContents().Data();
-    uint8_t* in_public = (uint8_t*) in_public_array->Buffer()->GetContents().Data();
-    uint8_t* in_private = (uint8_t*) in_private_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_ed25519_derive_delinearized_private_key) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* in_hash = args.Data(1);
+    uint8_t* in_public = args.Data(2);
+    uint8_t* in_private = args.Data(3);
+    if (!args.ok()) return NULL;
 
     ed25519_derive_delinearized_private_key(out, in_hash, in_public, in_private);
+    return NULL;
 }
 
-NAN_METHOD(node_ed25519_delinearized_partial_sign) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> commitment_array = info[2].As<Uint8Array>();
-    Local<Uint8Array> secret_array = info[3].As<Uint8Array>();
-    Local<Uint8Array> keys_array = info[4].As<Uint8Array>();
-    uint32_t keys_length = To<uint32_t>(info[5]).FromJust();
-    Local<Uint8Array> pubkey_array = info[6].As<Uint8Array>();
-    Local<Uint8Array> privkey_array = info[7].As<Uint8Array>();
-    uint32_t message_length = message_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* commitment = (uint8_t*) commitment_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* secret = (uint8_t*) secret_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* keys = (uint8_t*) keys_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* privkey = (uint8_t*) privkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* commitment = (uint8_t*) commitment_array->Buffer()->GetContents().Data();
-    uint8_t* secret = (uint8_t*) secret_array->Buffer()->GetContents().Data();
-    uint8_t* keys = (uint8_t*) keys_array->Buffer()->GetContents().Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetContents().Data();
-    uint8_t* privkey = (uint8_t*) privkey_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_ed25519_delinearized_partial_sign) {
+    Arguments args(env, info);
+    size_t message_length;
+    uint8_t* out = args.Data(0);
+    uint8_t* message = args.Data(1, &message_length);
+    uint8_t* commitment = args.Data(2);
+    uint8_t* secret = args.Data(3);
+    uint8_t* keys = args.Data(4);
+    uint32_t keys_length = args.Uint32(5);
+    uint8_t* pubkey = args.Data(6);
+    uint8_t* privkey = args.Data(7);
+    if (!args.ok()) return NULL;
 
     ed25519_delinearized_partial_sign(out, message, message_length, commitment, secret, keys, keys_length, pubkey, privkey);
+    return NULL;
+}
+
+NAPI_METHOD(node_ed25519_delinearized_partial_sign_precomputed) {
+    Arguments args(env, info);
+    size_t message_length;
+    uint8_t* out = args.Data(0);
+    uint8_t* message = args.Data(1, &message_length);
+    uint8_t* commitment = args.Data(2);
+    uint8_t* secret = args.Data(3);
+    uint8_t* hash = args.Data(4);
+    uint8_t* aggregate = args.Data(5);
+    uint8_t* pubkey = args.Data(6);
+    uint8_t* privkey = args.Data(7);
+    if (!args.ok()) return NULL;
+
+    ed25519_delinearized_partial_sign_precomputed(out, message, message_length, commitment, secret, hash, aggregate, pubkey, privkey);
+    return NULL;
 }
 
-NAN_METHOD(node_ripemd160) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t inlen = in_array->Length();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
-    info.GetReturnValue().Set(New<Number>(ripemd160(in, inlen, out)));
-}
-
-NAN_METHOD(node_keccak256) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t inlen = in_array->Length();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_ripemd160) {
+    Arguments args(env, info);
+    size_t inlen;
+    uint8_t* out = args.Data(0);
+    uint8_t* in = args.Data(1, &inlen);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, ripemd160(in, inlen, out));
+}
+
+NAPI_METHOD(node_keccak256) {
+    Arguments args(env, info);
+    size_t inlen;
+    uint8_t* out = args.Data(0);
+    uint8_t* in = args.Data(1, &inlen);
+    if (!args.ok()) return NULL;
+
     keccak256(in, inlen, out);
+    return NULL;
 }
 
-NAN_METHOD(node_secp256k1_ctx_init) {
-    Local<Uint8Array> randomize_array = info[0].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* randomize = (uint8_t*) randomize_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* randomize = (uint8_t*) randomize_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_crc32) {
+    Arguments args(env, info);
+    size_t inlen;
+    uint8_t* in = args.Data(0, &inlen);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, krypton_crc32(in, inlen));
+}
+
+NAPI_METHOD(node_secp256k1_ctx_init) {
+    Arguments args(env, info);
+    uint8_t* randomize = args.Data(0);
+    if (!args.ok()) return NULL;
+
     secp256k1_ctx_init(randomize);
+    return NULL;
 }
 
-NAN_METHOD(node_secp256k1_ctx_release) {
+NAPI_METHOD(node_secp256k1_ctx_release) {
     secp256k1_ctx_release();
+    return NULL;
+}
+
+NAPI_METHOD(node_secp256k1_seckey_verify) {
+    Arguments args(env, info);
+    uint8_t* seckey = args.Data(0);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_seckey_verify(seckey));
 }
 
-NAN_METHOD(node_secp256k1_seckey_verify) {
-    Local<Uint8Array> in_array = info[0].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* seckey = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* seckey = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
-    info.GetReturnValue().Set(New<Number>(secp256k1_seckey_verify(seckey)));
-}
-
-NAN_METHOD(node_secp256k1_pubkey_create) {
-    Local<Uint8Array> out_pubkey = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_seckey = info[1].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* output = (uint8_t*) out_pubkey->Buffer()->GetBackingStore()->Data();
-    uint8_t* seckey = (uint8_t*) in_seckey->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* output = (uint8_t*) out_pubkey->Buffer()->GetContents().Data();
-    uint8_t* seckey = (uint8_t*) in_seckey->Buffer()->GetContents().Data();
-#endif
-    size_t outputlen = out_pubkey->Length();
+NAPI_METHOD(node_secp256k1_pubkey_create) {
+    Arguments args(env, info);
+    size_t outputlen;
+    uint8_t* output = args.Data(0, &outputlen);
+    uint8_t* seckey = args.Data(1);
+    if (!args.ok()) return NULL;
+
     secp256k1_pubkey_create(output, outputlen, seckey);
+    return NULL;
+}
+
+NAPI_METHOD(node_secp256k1_pubkey_create_batch) {
+    Arguments args(env, info);
+    size_t length, seckeys_length;
+    uint8_t* output = args.Data(0, &length);
+    uint8_t* seckeys = args.Data(1, &seckeys_length);
+    uint32_t num_keys = args.Uint32(2);
+    if (!args.ok()) return NULL;
+    // secp256k1 aborts the process on an invalid output length.
+    if (num_keys == 0 || seckeys_length != (size_t) num_keys * 32
+        || (length != (size_t) num_keys * 33 && length != (size_t) num_keys * 65)) {
+        napi_throw_range_error(env, NULL, "Invalid public key batch length");
+        return NULL;
+    }
+
+    return NewNumber(env, secp256k1_pubkey_create_batch(output, length / num_keys, seckeys, num_keys));
+}
+
+NAPI_METHOD(node_secp256k1_pubkey_verify) {
+    Arguments args(env, info);
+    uint8_t* pubkey = args.Data(0);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_pubkey_verify(pubkey));
+}
+
+NAPI_METHOD(node_secp256k1_pubkey_compress) {
+    Arguments args(env, info);
+    uint8_t* out_pubkey = args.Data(0);
+    uint8_t* in_pubkey = args.Data(1);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_pubkey_compress(out_pubkey, in_pubkey));
+}
+
+NAPI_METHOD(node_secp256k1_pubkey_decompress) {
+    Arguments args(env, info);
+    uint8_t* out_pubkey = args.Data(0);
+    uint8_t* in_pubkey = args.Data(1);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_pubkey_decompress(out_pubkey, in_pubkey));
 }
 
-NAN_METHOD(node_secp256k1_pubkey_verify) {
-    Local<Uint8Array> pubkey_array = info[0].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetContents().Data();
-#endif
-    info.GetReturnValue().Set(New<Number>(secp256k1_pubkey_verify(pubkey)));
-}
-
-NAN_METHOD(node_secp256k1_pubkey_compress) {
-    Local<Uint8Array> out_pubkey_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_pubkey_array = info[1].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out_pubkey = (uint8_t*) out_pubkey_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in_pubkey = (uint8_t*) in_pubkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out_pubkey = (uint8_t*) out_pubkey_array->Buffer()->GetContents().Data();
-    uint8_t* in_pubkey = (uint8_t*) in_pubkey_array->Buffer()->GetContents().Data();
-#endif
-    info.GetReturnValue().Set(New<Number>(secp256k1_pubkey_compress(out_pubkey, in_pubkey)));
-}
-
-NAN_METHOD(node_secp256k1_pubkey_decompress) {
-    Local<Uint8Array> out_pubkey_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_pubkey_array = info[1].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out_pubkey = (uint8_t*) out_pubkey_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in_pubkey = (uint8_t*) in_pubkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out_pubkey = (uint8_t*) out_pubkey_array->Buffer()->GetContents().Data();
-    uint8_t* in_pubkey = (uint8_t*) in_pubkey_array->Buffer()->GetContents().Data();
-#endif
-    info.GetReturnValue().Set(New<Number>(secp256k1_pubkey_decompress(out_pubkey, in_pubkey)));
-}
-
-NAN_METHOD(node_secp256k1_sign) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> privkey_array = info[2].As<Uint8Array>();
-    uint32_t message_length = message_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* output = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* seckey = (uint8_t*) privkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* output = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* seckey = (uint8_t*) privkey_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_secp256k1_sign) {
+    Arguments args(env, info);
+    size_t message_length;
+    uint8_t* output = args.Data(0);
+    uint8_t* message = args.Data(1, &message_length);
+    uint8_t* seckey = args.Data(2);
+    if (!args.ok()) return NULL;
+
     unsigned char msghash32[32];
     krypton_sha256(msghash32, message, message_length);
-    
-    info.GetReturnValue().Set(New<Number>(secp256k1_sign(output, msghash32, seckey)));
-}
-
-NAN_METHOD(node_secp256k1_verify) {
-    Local<Uint8Array> signature_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> pubkey_array = info[2].As<Uint8Array>();
-    size_t message_length = message_array->Length();
-    size_t signature_length = signature_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* signature = (uint8_t*) signature_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* signature = (uint8_t*) signature_array->Buffer()->GetContents().Data();
-    uint8_t* message = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetContents().Data();
-#endif
+
+    return NewNumber(env, secp256k1_sign(output, msghash32, seckey));
+}
+
+NAPI_METHOD(node_secp256k1_verify) {
+    Arguments args(env, info);
+    size_t signature_length, message_length;
+    uint8_t* signature = args.Data(0, &signature_length);
+    uint8_t* message = args.Data(1, &message_length);
+    uint8_t* pubkey = args.Data(2);
+    if (!args.ok()) return NULL;
+
     unsigned char msghash32[32];
     krypton_sha256(msghash32, message, message_length);
 
-    info.GetReturnValue().Set(New<Number>(secp256k1_verify(msghash32, pubkey, signature, signature_length)));
-}
-
-NAN_METHOD(node_secp256k1_sign_compact) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> privkey_array = info[2].As<Uint8Array>();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* output = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* msghash32 = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* seckey = (uint8_t*) privkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* output = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* msghash32 = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* seckey = (uint8_t*) privkey_array->Buffer()->GetContents().Data();
-#endif
-    
-    info.GetReturnValue().Set(New<Number>(secp256k1_sign_compact(output, msghash32, seckey)));
-}
-
-NAN_METHOD(node_secp256k1_sign_compact_verify) {
-    Local<Uint8Array> signature_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> pubkey_array = info[2].As<Uint8Array>();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* signature = (uint8_t*) signature_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* msghash32 = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* signature = (uint8_t*) signature_array->Buffer()->GetContents().Data();
-    uint8_t* msghash32 = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetContents().Data();
-#endif
-
-    info.GetReturnValue().Set(New<Number>(secp256k1_sign_compact_verify(msghash32, pubkey, signature)));
-}
-
-NAN_METHOD(node_secp256k1_schnorr_sign) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> pubkey_array = info[2].As<Uint8Array>();
-    Local<Uint8Array> privkey_array = info[3].As<Uint8Array>();
-    uint32_t msglen = message_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* sig64 = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* msg = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* seckey = (uint8_t*) privkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* sig64 = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* msg = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetContents().Data();
-    uint8_t* seckey = (uint8_t*) privkey_array->Buffer()->GetContents().Data();
-#endif
-    info.GetReturnValue().Set(New<Number>(secp256k1_schnorr_sign(sig64, msg, msglen, pubkey, seckey)));
-}
-
-NAN_METHOD(node_secp256k1_schnorr_verify) {
-    Local<Uint8Array> signature_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> pubkey_array = info[2].As<Uint8Array>();
-    size_t msglen = message_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* sig64 = (uint8_t*) signature_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* msg = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* sig64 = (uint8_t*) signature_array->Buffer()->GetContents().Data();
-    uint8_t* msg = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetContents().Data();
-#endif
-
-    info.GetReturnValue().Set(New<Number>(secp256k1_schnorr_verify(sig64, msg, msglen, pubkey)));
-}
-
-NAN_METHOD(node_secp256k1_hash_pubkeys) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t num_pubkey = To<uint32_t>(info[2]).FromJust();
-    uint32_t pubkey_size = To<uint32_t>(info[3]).FromJust();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkeys = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* pubkeys = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
+    return NewNumber(env, secp256k1_verify(msghash32, pubkey, signature, signature_length));
+}
+
+NAPI_METHOD(node_secp256k1_sign_compact) {
+    Arguments args(env, info);
+    uint8_t* output = args.Data(0);
+    uint8_t* msghash32 = args.Data(1);
+    uint8_t* seckey = args.Data(2);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_sign_compact(output, msghash32, seckey));
+}
+
+NAPI_METHOD(node_secp256k1_sign_compact_verify) {
+    Arguments args(env, info);
+    uint8_t* signature = args.Data(0);
+    uint8_t* msghash32 = args.Data(1);
+    uint8_t* pubkey = args.Data(2);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_sign_compact_verify(msghash32, pubkey, signature));
+}
+
+NAPI_METHOD(node_secp256k1_schnorr_sign) {
+    Arguments args(env, info);
+    size_t msglen;
+    uint8_t* sig64 = args.Data(0);
+    uint8_t* msg = args.Data(1, &msglen);
+    uint8_t* pubkey = args.Data(2);
+    uint8_t* seckey = args.Data(3);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_schnorr_sign(sig64, msg, msglen, pubkey, seckey));
+}
+
+NAPI_METHOD(node_secp256k1_schnorr_verify) {
+    Arguments args(env, info);
+    size_t msglen;
+    uint8_t* sig64 = args.Data(0);
+    uint8_t* msg = args.Data(1, &msglen);
+    uint8_t* pubkey = args.Data(2);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_schnorr_verify(sig64, msg, msglen, pubkey));
+}
+
+NAPI_METHOD(node_secp256k1_hash_pubkeys) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* pubkeys = args.Data(1);
+    uint32_t num_pubkey = args.Uint32(2);
+    uint32_t pubkey_size = args.Uint32(3);
+    if (!args.ok()) return NULL;
 
     secp256k1_hash_pubkeys(out, pubkeys, num_pubkey, pubkey_size);
+    return NULL;
 }
 
-NAN_METHOD(node_secp256k1_delinearize_pubkey) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> hash_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> key_array = info[2].As<Uint8Array>();
-    size_t key_len = key_array->Length();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* hash = (uint8_t*) hash_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* key = (uint8_t*) key_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* hash = (uint8_t*) hash_array->Buffer()->GetContents().Data();
-    uint8_t* key = (uint8_t*) key_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_secp256k1_delinearize_pubkey) {
+    Arguments args(env, info);
+    size_t key_len;
+    uint8_t* out = args.Data(0);
+    uint8_t* hash = args.Data(1);
+    uint8_t* key = args.Data(2, &key_len);
+    if (!args.ok()) return NULL;
+
     secp256k1_delinearize_pubkey(out, hash, key, key_len);
+    return NULL;
+}
+
+NAPI_METHOD(node_secp256k1_aggregate_delinearized_publkeys) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* pubkeys_hash = args.Data(1);
+    uint8_t* pubkeys = args.Data(2);
+    uint32_t num_pubkey = args.Uint32(3);
+    uint32_t key_len = args.Uint32(4);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_aggregate_delinearized_publkeys(out, pubkeys_hash, pubkeys, num_pubkey, key_len));
 }
 
-NAN_METHOD(node_secp256k1_aggregate_delinearized_publkeys) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> hash_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> keys_array = info[2].As<Uint8Array>();
-    uint32_t num_pubkey = To<uint32_t>(info[3]).FromJust();
-    uint32_t key_len = To<uint32_t>(info[4]).FromJust();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkeys_hash = (uint8_t*) hash_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkeys = (uint8_t*) keys_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* pubkeys_hash = (uint8_t*) hash_array->Buffer()->GetContents().Data();
-    uint8_t* pubkeys = (uint8_t*) keys_array->Buffer()->GetContents().Data();
-#endif
-    info.GetReturnValue().Set(New<Number>(secp256k1_aggregate_delinearized_publkeys(out, pubkeys_hash, pubkeys, num_pubkey, key_len)));
-}
-
-NAN_METHOD(node_secp256k1_derive_delinearized_seckey) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_hash_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> in_public_array = info[2].As<Uint8Array>();
-    Local<Uint8Array> in_seckey_array = info[3].As<Uint8Array>();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in_hash = (uint8_t*) in_hash_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkey = (uint8_t*) in_public_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* seckey = (uint8_t*) in_seckey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* in_hash = (uint8_t*) in_hash_array->Buffer()->GetContents().Data();
-    uint8_t* pubkey = (uint8_t*) in_public_array->Buffer()->GetContents().Data();
-    uint8_t* seckey = (uint8_t*) in_seckey_array->Buffer()->GetContents().Data();
-#endif
+NAPI_METHOD(node_secp256k1_derive_delinearized_seckey) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* in_hash = args.Data(1);
+    uint8_t* pubkey = args.Data(2);
+    uint8_t* seckey = args.Data(3);
+    if (!args.ok()) return NULL;
 
     secp256k1_derive_delinearized_seckey(out, in_hash, pubkey, seckey);
+    return NULL;
+}
+
+NAPI_METHOD(node_secp256k1_partial_sign) {
+    Arguments args(env, info);
+    size_t msglen;
+    uint8_t* out = args.Data(0);
+    uint8_t* msg = args.Data(1, &msglen);
+    uint8_t* commitment = args.Data(2);
+    uint8_t* secret = args.Data(3);
+    uint8_t* pubkeys = args.Data(4);
+    uint32_t num_cosigners = args.Uint32(5);
+    uint8_t* pubkey = args.Data(6);
+    uint8_t* seckey = args.Data(7);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_partial_sign(out, msg, msglen, commitment, secret, pubkeys, num_cosigners, pubkey, seckey));
+}
+
+NAPI_METHOD(node_secp256k1_create_commitment) {
+    Arguments args(env, info);
+    size_t len;
+    uint8_t* out_secret = args.Data(0);
+    uint8_t* out_commitment = args.Data(1, &len);
+    uint8_t* in = args.Data(2);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_create_commitment(out_secret, out_commitment, len, in));
+}
+
+NAPI_METHOD(node_secp256k1_aggregate_commitments) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* in = args.Data(1);
+    uint32_t num_cmt = args.Uint32(2);
+    uint32_t length = args.Uint32(3);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_aggregate_commitments(out, in, num_cmt, length));
+}
+
+NAPI_METHOD(node_secp256k1_add_scalars) {
+    Arguments args(env, info);
+    uint8_t* out = args.Data(0);
+    uint8_t* a = args.Data(1);
+    uint8_t* b = args.Data(2);
+    if (!args.ok()) return NULL;
+
+    return NewNumber(env, secp256k1_add_scalars(out, a, b));
+}
+
+static void FinalizeAddonData(napi_env env, void* data, void* hint) {
+    delete (AddonData*) data;
+}
+
+static void CloseCompletionGuard(napi_env env, void* data, void* hint) {
+    std::shared_ptr<CompletionGuard>* guard = (std::shared_ptr<CompletionGuard>*) data;
+    {
+        std::lock_guard<std::mutex> lock((*guard)->mutex);
+        (*guard)->open = false;
+    }
+    delete guard;
+}
+
+#define EXPORT_METHOD(name) {#name, NULL, name, NULL, NULL, NULL, napi_default_jsproperty, NULL}
+
+static napi_value Init(napi_env env, napi_value exports) {
+    napi_property_descriptor methods[] = {
+        EXPORT_METHOD(node_argon2_target_async),
+        EXPORT_METHOD(node_sha256),
+        EXPORT_METHOD(node_sha512),
+        EXPORT_METHOD(node_blake2),
+        EXPORT_METHOD(node_argon2),
+        EXPORT_METHOD(node_argon2_async),
+        EXPORT_METHOD(node_sha256_async),
+        EXPORT_METHOD(node_blake2_async),
+        EXPORT_METHOD(node_ed25519_verify_async),
+        EXPORT_METHOD(node_secp256k1_schnorr_verify_async),
+        EXPORT_METHOD(node_secp256k1_verify_async),
+        EXPORT_METHOD(node_crypto_batch),
+        EXPORT_METHOD(node_crypto_batch_async),
+        EXPORT_METHOD(node_block_body_prevalidate),
+        EXPORT_METHOD(node_block_body_prevalidate_async),
+        EXPORT_METHOD(node_accounts_tree_update),
+        EXPORT_METHOD(node_accounts_proof_verify),
+        EXPORT_METHOD(node_accounts_tree_chunk_verify),
+        EXPORT_METHOD(node_crypto_ring_create),
+        EXPORT_METHOD(node_crypto_ring_notify),
+        EXPORT_METHOD(node_crypto_ring_ref),
+        EXPORT_METHOD(node_crypto_ring_close),
+        EXPORT_METHOD(node_crypto_pool_configure),
+        EXPORT_METHOD(node_crypto_pool_stats),
+        EXPORT_METHOD(node_ed25519_public_key_derive),
+        EXPORT_METHOD(node_ed25519_hash_public_keys),
+        EXPORT_METHOD(node_ed25519_delinearize_public_key),
+        EXPORT_METHOD(node_ed25519_aggregate_delinearized_public_keys),
+        EXPORT_METHOD(node_ed25519_add_scalars),
+        EXPORT_METHOD(node_ed25519_sign),
+        EXPORT_METHOD(node_ed25519_verify),
+        EXPORT_METHOD(node_kdf_legacy),
+        EXPORT_METHOD(node_kdf),
+        EXPORT_METHOD(node_ed25519_aggregate_commitments),
+        EXPORT_METHOD(node_ed25519_create_commitment),
+        EXPORT_METHOD(node_ed25519_derive_delinearized_private_key),
+        EXPORT_METHOD(node_ed25519_delinearized_partial_sign),
+        EXPORT_METHOD(node_ed25519_delinearized_partial_sign_precomputed),
+        EXPORT_METHOD(node_ripemd160),
+        EXPORT_METHOD(node_keccak256),
+        EXPORT_METHOD(node_crc32),
+        EXPORT_METHOD(node_secp256k1_ctx_init),
+        EXPORT_METHOD(node_secp256k1_ctx_release),
+        EXPORT_METHOD(node_secp256k1_seckey_verify),
+        EXPORT_METHOD(node_secp256k1_pubkey_create),
+        EXPORT_METHOD(node_secp256k1_pubkey_verify),
+        EXPORT_METHOD(node_secp256k1_pubkey_create_batch),
+        EXPORT_METHOD(node_secp256k1_pubkey_compress),
+        EXPORT_METHOD(node_secp256k1_pubkey_decompress),
+        EXPORT_METHOD(node_secp256k1_sign),
+        EXPORT_METHOD(node_secp256k1_verify),
+        EXPORT_METHOD(node_secp256k1_sign_compact),
+        EXPORT_METHOD(node_secp256k1_sign_compact_verify),
+        EXPORT_METHOD(node_secp256k1_schnorr_sign),
+        EXPORT_METHOD(node_secp256k1_schnorr_verify),
+        EXPORT_METHOD(node_secp256k1_hash_pubkeys),
+        EXPORT_METHOD(node_secp256k1_delinearize_pubkey),
+        EXPORT_METHOD(node_secp256k1_aggregate_delinearized_publkeys),
+        EXPORT_METHOD(node_secp256k1_derive_delinearized_seckey),
+        EXPORT_METHOD(node_secp256k1_partial_sign),
+        EXPORT_METHOD(node_secp256k1_create_commitment),
+        EXPORT_METHOD(node_secp256k1_aggregate_commitments),
+        EXPORT_METHOD(node_secp256k1_add_scalars)
+    };
+    napi_define_properties(env, exports, sizeof(methods) / sizeof(methods[0]), methods);
+
+    Ed25519SigningKey::Init(env, exports);
+    Secp256k1MultiSigSession::Init(env, exports);
+
+    AddonData* addon = new AddonData();
+    addon->guard = std::make_shared<CompletionGuard>();
+    napi_value resource_name;
+    napi_create_string_utf8(env, "krypton:crypto_pool", NAPI_AUTO_LENGTH, &resource_name);
+    napi_create_threadsafe_function(env, NULL, NULL, resource_name, 0, 1,
+        new std::shared_ptr<CompletionGuard>(addon->guard), CloseCompletionGuard, NULL,
+        PoolJob::CallComplete, &addon->complete);
+    napi_unref_threadsafe_function(env, addon->complete);
+    napi_set_instance_data(env, addon, FinalizeAddonData, NULL);
+    return exports;
 }
 
-NAN_METHOD(node_secp256k1_partial_sign) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> message_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> commitment_array = info[2].As<Uint8Array>();
-    Local<Uint8Array> secret_array = info[3].As<Uint8Array>();
-    Local<Uint8Array> keys_array = info[4].As<Uint8Array>();
-    uint32_t num_cosigners = To<uint32_t>(info[5]).FromJust();
-    Local<Uint8Array> pubkey_array = info[6].As<Uint8Array>();
-    Local<Uint8Array> seckey_array = info[7].As<Uint8Array>();
-    uint32_t msglen = message_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* msg = (uint8_t*) message_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* commitment = (uint8_t*) commitment_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* secret = (uint8_t*) secret_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkeys = (uint8_t*) keys_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* seckey = (uint8_t*) seckey_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* msg = (uint8_t*) message_array->Buffer()->GetContents().Data();
-    uint8_t* commitment = (uint8_t*) commitment_array->Buffer()->GetContents().Data();
-    uint8_t* secret = (uint8_t*) secret_array->Buffer()->GetContents().Data();
-    uint8_t* pubkeys = (uint8_t*) keys_array->Buffer()->GetContents().Data();
-    uint8_t* pubkey = (uint8_t*) pubkey_array->Buffer()->GetContents().Data();
-    uint8_t* seckey = (uint8_t*) seckey_array->Buffer()->GetContents().Data();
-#endif
-
-    info.GetReturnValue().Set(New<Number>(secp256k1_partial_sign(out, msg, msglen, commitment, secret, pubkeys, num_cosigners, pubkey, seckey)));
-}
-
-NAN_METHOD(node_secp256k1_create_commitment) {
-    Local<Uint8Array> out_secret_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> out_commitment_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[2].As<Uint8Array>();
-    size_t len = out_commitment_array->Length();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out_secret = (uint8_t*) out_secret_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* out_commitment = (uint8_t*) out_commitment_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out_secret = (uint8_t*) out_secret_array->Buffer()->GetContents().Data();
-    uint8_t* out_commitment = (uint8_t*) out_commitment_array->Buffer()->GetContents().Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
-     info.GetReturnValue().Set(New<Number>(secp256k1_create_commitment(out_secret, out_commitment, len, in)));
-}
-
-NAN_METHOD(node_secp256k1_aggregate_commitments) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> in_array = info[1].As<Uint8Array>();
-    uint32_t num_cmt = To<uint32_t>(info[2]).FromJust();
-    uint32_t length = To<uint32_t>(info[3]).FromJust();
-
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* in = (uint8_t*) in_array->Buffer()->GetContents().Data();
-#endif
-    info.GetReturnValue().Set(New<Number>(secp256k1_aggregate_commitments(out, in, num_cmt, length)));
-}
-
-NAN_METHOD(node_secp256k1_add_scalars) {
-    Local<Uint8Array> out_array = info[0].As<Uint8Array>();
-    Local<Uint8Array> a_array = info[1].As<Uint8Array>();
-    Local<Uint8Array> b_array = info[2].As<Uint8Array>();
-#if (V8_MAJOR_VERSION >= 10 && V8_MINOR_VERSION >= 1)
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* a = (uint8_t*) a_array->Buffer()->GetBackingStore()->Data();
-    uint8_t* b = (uint8_t*) b_array->Buffer()->GetBackingStore()->Data();
-#else
-    uint8_t* out = (uint8_t*) out_array->Buffer()->GetContents().Data();
-    uint8_t* a = (uint8_t*) a_array->Buffer()->GetContents().Data();
-    uint8_t* b = (uint8_t*) b_array->Buffer()->GetContents().Data();
-#endif
-
-    info.GetReturnValue().Set(New<Number>(secp256k1_add_scalars(out, a, b)));
-}
-
-NAN_MODULE_INIT(Init) {
-    Set(target, New<String>("node_argon2_target_async").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_argon2_target_async)).ToLocalChecked());
-    Set(target, New<String>("node_sha256").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_sha256)).ToLocalChecked());
-    Set(target, New<String>("node_sha512").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_sha512)).ToLocalChecked());
-    Set(target, New<String>("node_blake2").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_blake2)).ToLocalChecked());
-    Set(target, New<String>("node_argon2").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_argon2)).ToLocalChecked());
-    Set(target, New<String>("node_argon2_async").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_argon2_async)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_public_key_derive").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_public_key_derive)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_hash_public_keys").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_hash_public_keys)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_delinearize_public_key").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_delinearize_public_key)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_aggregate_delinearized_public_keys").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_aggregate_delinearized_public_keys)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_add_scalars").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_add_scalars)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_sign").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_sign)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_verify").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_verify)).ToLocalChecked());
-    Set(target, New<String>("node_kdf_legacy").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_kdf_legacy)).ToLocalChecked());
-    Set(target, New<String>("node_kdf").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_kdf)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_aggregate_commitments").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_aggregate_commitments)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_create_commitment").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_create_commitment)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_derive_delinearized_private_key").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_derive_delinearized_private_key)).ToLocalChecked());
-    Set(target, New<String>("node_ed25519_delinearized_partial_sign").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ed25519_delinearized_partial_sign)).ToLocalChecked());
-    Set(target, New<String>("node_ripemd160").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_ripemd160)).ToLocalChecked());
-    Set(target, New<String>("node_keccak256").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_keccak256)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_ctx_init").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_ctx_init)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_ctx_release").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_ctx_release)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_seckey_verify").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_seckey_verify)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_pubkey_create").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_pubkey_create)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_pubkey_verify").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_pubkey_verify)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_pubkey_compress").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_pubkey_compress)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_pubkey_decompress").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_pubkey_decompress)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_sign").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_sign)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_verify").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_verify)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_sign_compact").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_sign_compact)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_sign_compact_verify").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_sign_compact_verify)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_schnorr_sign").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_schnorr_sign)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_schnorr_verify").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_schnorr_verify)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_hash_pubkeys").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_hash_pubkeys)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_delinearize_pubkey").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_delinearize_pubkey)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_aggregate_delinearized_publkeys").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_aggregate_delinearized_publkeys)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_derive_delinearized_seckey").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_derive_delinearized_seckey)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_partial_sign").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_partial_sign)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_create_commitment").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_create_commitment)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_aggregate_commitments").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_aggregate_commitments)).ToLocalChecked());
-    Set(target, New<String>("node_secp256k1_add_scalars").ToLocalChecked(),
-        GetFunction(New<FunctionTemplate>(node_secp256k1_add_scalars)).ToLocalChecked());
-}
-
-NODE_MODULE(krypton_node, Init)
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -23,7 +23,11 @@
 #include "core.h"
 
 #include "blake2/blake2.h"
+#if defined(__wasm_simd128__)
+#include "blake2/blamka-round-simd128.h"
+#else
 #include "blake2/blamka-round-opt.h"
+#endif
 
 /*
  * Function fills a new memory block and optionally XORs the old block over the new one.
@@ -106,6 +110,43 @@ static void fill_block(__m256i *state, const block *ref_block,
         _mm256_storeu_si256((__m256i *)next_block->v + i, state[i]);
     }
 }
+#elif defined(__wasm_simd128__)
+static void fill_block(v128_t *state, const block *ref_block,
+                       block *next_block, int with_xor) {
+    v128_t block_XY[ARGON2_OWORDS_IN_BLOCK];
+    unsigned int i;
+
+    if (with_xor) {
+        for (i = 0; i < ARGON2_OWORDS_IN_BLOCK; i++) {
+            state[i] = wasm_v128_xor(
+                state[i], wasm_v128_load((const v128_t *)ref_block->v + i));
+            block_XY[i] = wasm_v128_xor(
+                state[i], wasm_v128_load((const v128_t *)next_block->v + i));
+        }
+    } else {
+        for (i = 0; i < ARGON2_OWORDS_IN_BLOCK; i++) {
+            block_XY[i] = state[i] = wasm_v128_xor(
+                state[i], wasm_v128_load((const v128_t *)ref_block->v + i));
+        }
+    }
+
+    for (i = 0; i < 8; ++i) {
+        BLAKE2_ROUND(state[8 * i + 0], state[8 * i + 1], state[8 * i + 2],
+            state[8 * i + 3], state[8 * i + 4], state[8 * i + 5],
+            state[8 * i + 6], state[8 * i + 7]);
+    }
+
+    for (i = 0; i < 8; ++i) {
+        BLAKE2_ROUND(state[8 * 0 + i], state[8 * 1 + i], state[8 * 2 + i],
+            state[8 * 3 + i], state[8 * 4 + i], state[8 * 5 + i],
+            state[8 * 6 + i], state[8 * 7 + i]);
+    }
+
+    for (i = 0; i < ARGON2_OWORDS_IN_BLOCK; i++) {
+        state[i] = wasm_v128_xor(state[i], block_XY[i]);
+        wasm_v128_store((v128_t *)next_block->v + i, state[i]);
+    }
+}
 #else
 static void fill_block(__m128i *state, const block *ref_block,
                        block *next_block, int with_xor) {
@@ -153,6 +194,9 @@ static void next_addresses(block *address_block, block *input_block) {
 #elif defined(__AVX2__)
     __m256i zero_block[ARGON2_HWORDS_IN_BLOCK];
     __m256i zero2_block[ARGON2_HWORDS_IN_BLOCK];
+#elif defined(__wasm_simd128__)
+    v128_t zero_block[ARGON2_OWORDS_IN_BLOCK];
+    v128_t zero2_block[ARGON2_OWORDS_IN_BLOCK];
 #else
     __m128i zero_block[ARGON2_OWORDS_IN_BLOCK];
     __m128i zero2_block[ARGON2_OWORDS_IN_BLOCK];
@@ -182,6 +226,8 @@ void fill_segment(const argon2_instance_t *instance,
     __m512i state[ARGON2_512BIT_WORDS_IN_BLOCK];
 #elif defined(__AVX2__)
     __m256i state[ARGON2_HWORDS_IN_BLOCK];
+#elif defined(__wasm_simd128__)
+    v128_t state[ARGON2_OWORDS_IN_BLOCK];
 #else
     __m128i state[ARGON2_OWORDS_IN_BLOCK];
 #endif
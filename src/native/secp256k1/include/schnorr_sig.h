@@ -14,3 +14,15 @@ int secp256k1_schnorrsig_partial_sign(const secp256k1_context* ctx, unsigned cha
 int secp256k1_schnorrsig_create_commitment(const secp256k1_context* ctx, unsigned char *k, unsigned char *r, size_t cmt_len, const unsigned char *randomness);
 int secp256k1_schnorrsig_aggregate_commitments(unsigned char *aggregate_commitment, const unsigned char *commitments, const size_t num_commitments, size_t cmt_len);
 int secp256k1_schnorrsig_add_scalars(unsigned char *scalar_AB, const unsigned char *scalar_A, const unsigned char *scalar_B);
+
+typedef struct secp256k1_schnorrsig_session_struct secp256k1_schnorrsig_session;
+
+size_t secp256k1_schnorrsig_session_size(void);
+void secp256k1_schnorrsig_session_clear(secp256k1_schnorrsig_session *session);
+int secp256k1_schnorrsig_session_init(secp256k1_schnorrsig_session *session, const unsigned char *pubkeys, const size_t num_pubkey, size_t pubkey_size, const unsigned char *pubkey, const unsigned char *seckey);
+int secp256k1_schnorrsig_session_aggregate_pubkey(const secp256k1_schnorrsig_session *session, unsigned char *aggregate_pubkey, size_t pubkey_size);
+int secp256k1_schnorrsig_session_create_commitment(const secp256k1_context* ctx, secp256k1_schnorrsig_session *session, unsigned char *k, unsigned char *r, size_t cmt_len, const unsigned char *randomness);
+int secp256k1_schnorrsig_session_aggregate_commitments(secp256k1_schnorrsig_session *session, unsigned char *aggregate_commitment, const unsigned char *commitments, const size_t num_commitments, size_t cmt_len);
+int secp256k1_schnorrsig_session_set_commitment(secp256k1_schnorrsig_session *session, const unsigned char *k, const unsigned char *aggregate_commitment, size_t cmt_len);
+int secp256k1_schnorrsig_session_partial_sign(secp256k1_schnorrsig_session *session, unsigned char *sig64, const unsigned char *msg, size_t msglen);
+int secp256k1_schnorrsig_session_combine(secp256k1_schnorrsig_session *session, unsigned char *sig64, const unsigned char *partial_signatures, const size_t num_signatures);
@@ -697,6 +697,31 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_create(
     const unsigned char *seckey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Compute and serialize the public keys for many secret keys at once.
+ *
+ *  Equivalent to calling secp256k1_ec_pubkey_create and secp256k1_ec_pubkey_serialize
+ *  for every key, but converts the points to affine coordinates in chunks sharing
+ *  a single field inversion.
+ *
+ *  Returns: 1: all secret keys were valid.
+ *           0: at least one secret key was invalid, its output is zeroed.
+ *  Args:    ctx:       pointer to a context object (not secp256k1_context_static).
+ *  Out:     output:    pointer to n * outputlen bytes receiving the packed public keys.
+ *  In:      outputlen: size of one serialized public key, 33 if flags is
+ *                      SECP256K1_EC_COMPRESSED, 65 otherwise.
+ *           seckeys:   pointer to n packed 32-byte secret keys.
+ *           n:         number of secret keys.
+ *           flags:     SECP256K1_EC_COMPRESSED or SECP256K1_EC_UNCOMPRESSED.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_create_batch(
+    const secp256k1_context* ctx,
+    unsigned char *output,
+    size_t outputlen,
+    const unsigned char *seckeys,
+    size_t n,
+    unsigned int flags
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
 /** Negates a secret key in place.
  *
  *  Returns: 0 if the given secret key is invalid according to
@@ -70,7 +70,6 @@ static int secp256k1_schnorrsig_create_sign(const secp256k1_context* ctx, unsign
   secp256k1_memczero(sig64, 64, !ret);
   secp256k1_scalar_clear(&k);
   secp256k1_scalar_clear(&sk);
-  memset((void *)seckey, 0, sizeof(seckey));
 
   return ret;
 }
@@ -82,8 +81,9 @@ int secp256k1_schnorrsig_verify(const secp256k1_context* ctx, const unsigned cha
   secp256k1_ge pk;
   secp256k1_gej pkj;
   secp256k1_fe rx;
-  secp256k1_ge r;
-  unsigned char buf[32];
+  secp256k1_fe zi;
+  secp256k1_fe zi3;
+  secp256k1_fe ry;
   int overflow;
 
   ARG_CHECK(sig64 != NULL);
@@ -103,27 +103,32 @@ int secp256k1_schnorrsig_verify(const secp256k1_context* ctx, const unsigned cha
     return 0;
   }
 
-  /* Compute e. */
-  secp256k1_fe_normalize_var(&pk.x);
-  secp256k1_fe_normalize_var(&pk.y);
-  secp256k1_fe_get_b32(buf, &pk.x);
-  secp256k1_schnorrsig_challenge(&e, &sig64[0], msg, msglen, buf);
+  /* Compute e. The parsed key has the x coordinate of the serialized key
+   * (which is < p, or parsing would have failed) and the parity of its tag,
+   * so neither needs to be recomputed from pk. */
+  secp256k1_schnorrsig_challenge(&e, &sig64[0], msg, msglen, &pubkey[1]);
 
   /* Compute rj =  s*G - e*pkj if pk.y is even */
   /* Compute rj =  s*G + e*pkj if pk.y is odd */
-  if (!secp256k1_fe_is_odd(&pk.y)) {
+  if (pubkey[0] != SECP256K1_TAG_PUBKEY_ODD) {
     secp256k1_scalar_negate(&e, &e);
   }
   secp256k1_gej_set_ge(&pkj, &pk);
   secp256k1_ecmult(&rj, &pkj, &e, &s);
 
-  secp256k1_ge_set_gej_var(&r, &rj);
-  if (secp256k1_ge_is_infinity(&r)) {
+  /* Compare the x coordinate in Jacobian coordinates (rx * Z^2 == X) so that
+   * invalid signatures are rejected without a field inversion. */
+  if (secp256k1_gej_is_infinity(&rj) || !secp256k1_gej_eq_x_var(&rx, &rj)) {
     return 0;
   }
 
-  secp256k1_fe_normalize_var(&r.y);
-  return !secp256k1_fe_is_odd(&r.y) && secp256k1_fe_equal_var(&rx, &r.x);
+  /* The parity of the affine y = Y / Z^3 still needs the inversion. */
+  secp256k1_fe_inv_var(&zi, &rj.z);
+  secp256k1_fe_sqr(&zi3, &zi);
+  secp256k1_fe_mul(&zi3, &zi3, &zi);
+  secp256k1_fe_mul(&ry, &rj.y, &zi3);
+  secp256k1_fe_normalize_var(&ry);
+  return !secp256k1_fe_is_odd(&ry);
 }
 
 int secp256k1_schnorrsig_sign(const secp256k1_context *ctx, unsigned char *sig64, unsigned char *msg, size_t msglen, const unsigned char *pubkey, const unsigned char *seckey) {
@@ -174,17 +179,12 @@ int secp256k1_schnorrsig_sign(const secp256k1_context *ctx, unsigned char *sig64
  */
 
 void secp256k1_schnorrsig_hash_pubkeys(unsigned char *out, const unsigned char *pubkeys, const size_t num_pubkey, size_t pubkey_size) {
-  size_t size = num_pubkey * 32;
-  unsigned char* buf = malloc(size);
-
-  for (size_t i = 0; i < num_pubkey; i++) {
-    memcpy(buf + (i * 32), pubkeys + (i * pubkey_size) + 1, 32); // x-only public
-  }
   secp256k1_sha256 hash;
   secp256k1_sha256_initialize(&hash);
-  secp256k1_sha256_write(&hash, buf, size);
+  for (size_t i = 0; i < num_pubkey; i++) {
+    secp256k1_sha256_write(&hash, pubkeys + (i * pubkey_size) + 1, 32); // x-only public
+  }
   secp256k1_sha256_finalize(&hash, out);
-  free(buf);
 }
 
 /*
@@ -340,3 +340,188 @@ int secp256k1_schnorrsig_add_scalars(unsigned char *scalar_AB, const unsigned ch
 
   return ret;
 }
+
+/*
+ * A multisig signing session for one cosigner. The cosigner set is fixed at
+ * init: the pubkeys hash C = H(P_1 || ... || P_n), the aggregate public key
+ * P = ∑ H(C || P_i) P_i and the cosigner's delinearized seckey H(C || P)x are
+ * computed once and reused for every signature made in the session. The
+ * commitment secret of a round is consumed by the partial signature it
+ * produces, so a nonce can never be used twice.
+ */
+
+struct secp256k1_schnorrsig_session_struct {
+  unsigned char pubkeys_hash[32];
+  unsigned char aggregate_pubkey[33];
+  secp256k1_scalar seckey; /* H(C||P)x, negated if P has an odd Y */
+  secp256k1_scalar k;      /* commitment secret */
+  unsigned char r32[32];   /* x coordinate of the aggregate commitment R */
+  int r_is_odd;
+  int has_seckey;
+  int has_secret;
+  int has_commitment;
+};
+
+size_t secp256k1_schnorrsig_session_size(void) {
+  return sizeof(secp256k1_schnorrsig_session);
+}
+
+void secp256k1_schnorrsig_session_clear(secp256k1_schnorrsig_session *session) {
+  secp256k1_memczero(session, sizeof(secp256k1_schnorrsig_session), 1);
+}
+
+int secp256k1_schnorrsig_session_init(secp256k1_schnorrsig_session *session, const unsigned char *pubkeys, const size_t num_pubkey, size_t pubkey_size, const unsigned char *pubkey, const unsigned char *seckey) {
+  secp256k1_ge pk;
+  unsigned char delinearized_seckey[32];
+  int ret = 1;
+
+  secp256k1_schnorrsig_session_clear(session);
+  secp256k1_schnorrsig_hash_pubkeys(session->pubkeys_hash, pubkeys, num_pubkey, pubkey_size);
+  ret &= secp256k1_schnorrsig_aggregate_delinearized_publkeys(session->aggregate_pubkey, session->pubkeys_hash, pubkeys, num_pubkey, 33u);
+  ret &= secp256k1_eckey_pubkey_parse(&pk, session->aggregate_pubkey, 33u);
+
+  if (seckey != NULL) {
+    secp256k1_schnorrsig_derive_delinearized_seckey(delinearized_seckey, session->pubkeys_hash, pubkey, seckey);
+    ret &= secp256k1_scalar_set_b32_seckey(&session->seckey, delinearized_seckey);
+    /* We sign for the x-only aggregate pubkey, see secp256k1_schnorrsig_create_sign. */
+    secp256k1_fe_normalize_var(&pk.y);
+    if (secp256k1_fe_is_odd(&pk.y)) {
+      secp256k1_scalar_negate(&session->seckey, &session->seckey);
+    }
+    session->has_seckey = ret;
+    secp256k1_memczero(delinearized_seckey, sizeof(delinearized_seckey), 1);
+  }
+
+  if (!ret) {
+    secp256k1_schnorrsig_session_clear(session);
+  }
+  return ret;
+}
+
+int secp256k1_schnorrsig_session_aggregate_pubkey(const secp256k1_schnorrsig_session *session, unsigned char *aggregate_pubkey, size_t pubkey_size) {
+  secp256k1_ge pk;
+  if (!secp256k1_eckey_pubkey_parse(&pk, session->aggregate_pubkey, 33u)) {
+    return 0;
+  }
+  return secp256k1_eckey_pubkey_serialize(&pk, aggregate_pubkey, &pubkey_size, pubkey_size == 33u);
+}
+
+int secp256k1_schnorrsig_session_create_commitment(const secp256k1_context* ctx, secp256k1_schnorrsig_session *session, unsigned char *k, unsigned char *r, size_t cmt_len, const unsigned char *randomness) {
+  unsigned char kbuf[32];
+  int ret = secp256k1_schnorrsig_create_commitment(ctx, kbuf, r, cmt_len, randomness);
+
+  ret &= secp256k1_scalar_set_b32_seckey(&session->k, kbuf);
+  session->has_secret = ret;
+  session->has_commitment = 0;
+  if (k != NULL) {
+    memcpy(k, kbuf, 32);
+  }
+  secp256k1_memczero(kbuf, sizeof(kbuf), 1);
+  return ret;
+}
+
+static int secp256k1_schnorrsig_session_load_commitment(secp256k1_schnorrsig_session *session, secp256k1_ge *r) {
+  secp256k1_fe_normalize_var(&r->x);
+  secp256k1_fe_normalize_var(&r->y);
+  session->r_is_odd = secp256k1_fe_is_odd(&r->y);
+  secp256k1_fe_get_b32(session->r32, &r->x);
+  session->has_commitment = 1;
+  return 1;
+}
+
+int secp256k1_schnorrsig_session_aggregate_commitments(secp256k1_schnorrsig_session *session, unsigned char *aggregate_commitment, const unsigned char *commitments, const size_t num_commitments, size_t cmt_len) {
+  secp256k1_ge Q;
+  secp256k1_gej Qj;
+
+  secp256k1_gej_set_infinity(&Qj);
+  for (size_t i = 0; i < num_commitments; ++i) {
+    if (!secp256k1_eckey_pubkey_parse(&Q, commitments + (i * cmt_len), cmt_len)) {
+      return 0;
+    }
+    secp256k1_gej_add_ge_var(&Qj, &Qj, &Q, NULL);
+  }
+  if (secp256k1_gej_is_infinity(&Qj)) {
+    return 0;
+  }
+  secp256k1_ge_set_gej_var(&Q, &Qj);
+  if (aggregate_commitment != NULL) {
+    size_t len = cmt_len;
+    secp256k1_ge out = Q;
+    secp256k1_eckey_pubkey_serialize(&out, aggregate_commitment, &len, cmt_len == 33u);
+  }
+  return secp256k1_schnorrsig_session_load_commitment(session, &Q);
+}
+
+int secp256k1_schnorrsig_session_set_commitment(secp256k1_schnorrsig_session *session, const unsigned char *k, const unsigned char *aggregate_commitment, size_t cmt_len) {
+  secp256k1_ge r;
+
+  session->has_secret = 0;
+  session->has_commitment = 0;
+  if (k != NULL) {
+    if (!secp256k1_scalar_set_b32_seckey(&session->k, k)) {
+      return 0;
+    }
+    session->has_secret = 1;
+  }
+  if (!secp256k1_eckey_pubkey_parse(&r, aggregate_commitment, cmt_len)) {
+    secp256k1_scalar_clear(&session->k);
+    session->has_secret = 0;
+    return 0;
+  }
+  return secp256k1_schnorrsig_session_load_commitment(session, &r);
+}
+
+int secp256k1_schnorrsig_session_partial_sign(secp256k1_schnorrsig_session *session, unsigned char *sig64, const unsigned char *msg, size_t msglen) {
+  secp256k1_scalar e;
+  secp256k1_scalar k;
+
+  if (!session->has_seckey || !session->has_secret || !session->has_commitment) {
+    memset(sig64, 0, 64);
+    return 0;
+  }
+
+  /* The partial signatures are made for the x-only aggregate commitment. */
+  k = session->k;
+  if (session->r_is_odd) {
+    secp256k1_scalar_negate(&k, &k);
+  }
+  secp256k1_schnorrsig_challenge(&e, session->r32, msg, msglen, session->aggregate_pubkey + 1);
+  secp256k1_scalar_mul(&e, &e, &session->seckey);
+  secp256k1_scalar_add(&e, &e, &k);
+  memcpy(&sig64[0], session->r32, 32);
+  secp256k1_scalar_get_b32(&sig64[32], &e);
+
+  /* The commitment secret must not be used for a second signature. */
+  secp256k1_scalar_clear(&session->k);
+  secp256k1_scalar_clear(&k);
+  secp256k1_scalar_clear(&e);
+  session->has_secret = 0;
+  return 1;
+}
+
+int secp256k1_schnorrsig_session_combine(secp256k1_schnorrsig_session *session, unsigned char *sig64, const unsigned char *partial_signatures, const size_t num_signatures) {
+  secp256k1_scalar s;
+  secp256k1_scalar si;
+  int overflow;
+
+  if (!session->has_commitment || num_signatures == 0) {
+    return 0;
+  }
+
+  secp256k1_scalar_set_int(&s, 0);
+  for (size_t i = 0; i < num_signatures; ++i) {
+    const unsigned char *partial_signature = partial_signatures + (i * 64);
+    if (memcmp(partial_signature, session->r32, 32) != 0) {
+      return 0;
+    }
+    secp256k1_scalar_set_b32(&si, partial_signature + 32, &overflow);
+    if (overflow) {
+      return 0;
+    }
+    secp256k1_scalar_add(&s, &s, &si);
+  }
+  memcpy(&sig64[0], session->r32, 32);
+  secp256k1_scalar_get_b32(&sig64[32], &s);
+  session->has_commitment = 0;
+  return 1;
+}
@@ -608,6 +608,46 @@ int secp256k1_ec_pubkey_create(const secp256k1_context* ctx, secp256k1_pubkey *p
     return ret;
 }
 
+/* Number of public keys converted to affine coordinates with one field inversion. */
+#define SECP256K1_PUBKEY_BATCH_SIZE 32
+
+int secp256k1_ec_pubkey_create_batch(const secp256k1_context* ctx, unsigned char *output, size_t outputlen, const unsigned char *seckeys, size_t n, unsigned int flags) {
+    secp256k1_gej pj[SECP256K1_PUBKEY_BATCH_SIZE];
+    secp256k1_ge p[SECP256K1_PUBKEY_BATCH_SIZE];
+    int valid[SECP256K1_PUBKEY_BATCH_SIZE];
+    secp256k1_scalar seckey_scalar;
+    size_t i, j, chunk, len;
+    int ret = 1;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL);
+    ARG_CHECK(outputlen == ((flags & SECP256K1_FLAGS_BIT_COMPRESSION) ? 33u : 65u));
+    ARG_CHECK((flags & SECP256K1_FLAGS_TYPE_MASK) == SECP256K1_FLAGS_TYPE_COMPRESSION);
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(seckeys != NULL || n == 0);
+
+    for (i = 0; i < n; i += chunk) {
+        chunk = n - i < SECP256K1_PUBKEY_BATCH_SIZE ? n - i : SECP256K1_PUBKEY_BATCH_SIZE;
+        for (j = 0; j < chunk; j++) {
+            valid[j] = secp256k1_scalar_set_b32_seckey(&seckey_scalar, &seckeys[(i + j) * 32]);
+            secp256k1_scalar_cmov(&seckey_scalar, &secp256k1_scalar_one, !valid[j]);
+            secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &pj[j], &seckey_scalar);
+        }
+        secp256k1_scalar_clear(&seckey_scalar);
+
+        /* The resulting points are public, so they may be normalized in variable time,
+         * sharing a single inversion across the chunk. */
+        secp256k1_ge_set_all_gej_var(p, pj, chunk);
+        for (j = 0; j < chunk; j++) {
+            unsigned char *out = &output[(i + j) * outputlen];
+            len = outputlen;
+            valid[j] &= secp256k1_eckey_pubkey_serialize(&p[j], out, &len, !!(flags & SECP256K1_FLAGS_BIT_COMPRESSION));
+            secp256k1_memczero(out, outputlen, !valid[j]);
+            ret &= valid[j];
+        }
+    }
+    return ret;
+}
+
 int secp256k1_ec_seckey_negate(const secp256k1_context* ctx, unsigned char *seckey) {
     secp256k1_scalar sec;
     int ret = 0;
@@ -1,5 +1,7 @@
 #include "secp256k1_native.h"
 
+static secp256k1_context *secp256k1_ctx = NULL;
+
 void secp256k1_ctx_release() {
     secp256k1_context *ctx = secp256k1_ctx;
     secp256k1_ctx = NULL;
@@ -31,22 +33,26 @@ void secp256k1_pubkey_create(unsigned char *output, size_t outputlen, const unsi
     secp256k1_ec_pubkey_serialize(secp256k1_ctx, output, &outputlen, &pubkey, flags);
 }
 
+int secp256k1_pubkey_create_batch(unsigned char *output, size_t outputlen, const unsigned char *seckeys, size_t num_keys) {
+    unsigned int flags = outputlen == PUBKEY_COMPRESSED_SIZE ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED;
+    return secp256k1_ec_pubkey_create_batch(secp256k1_ctx, output, outputlen, seckeys, num_keys, flags);
+}
+
 int secp256k1_pubkey_verify(const unsigned char *pubkey) {
     secp256k1_pubkey pub;
     return secp256k1_ec_pubkey_parse(secp256k1_ctx, &pub, pubkey, secp256k1_pubkey_get_length(pubkey[0]));
 }
 
 int secp256k1_pubkey_compress(unsigned char *out_pubkey, const unsigned char *in_pubkey) {
+    /* Parsing and serializing keys needs no precomputation either, the block body validator
+       compresses keys on crypto pool threads. */
     secp256k1_pubkey pubkey;
-    if (!secp256k1_ec_pubkey_parse(secp256k1_ctx, &pubkey, in_pubkey, secp256k1_pubkey_get_length(*in_pubkey))) {
+    if (!secp256k1_ec_pubkey_parse(secp256k1_context_static, &pubkey, in_pubkey, secp256k1_pubkey_get_length(*in_pubkey))) {
         return 0;
     }
     
     size_t publen = PUBKEY_COMPRESSED_SIZE;
-    unsigned char* pub = malloc(publen);
-    secp256k1_ec_pubkey_serialize(secp256k1_ctx, pub, &publen, &pubkey, SECP256K1_EC_COMPRESSED);
-    memcpy(out_pubkey, pub, publen);
-    free(pub);
+    secp256k1_ec_pubkey_serialize(secp256k1_context_static, out_pubkey, &publen, &pubkey, SECP256K1_EC_COMPRESSED);
     return 1;
 }
 
@@ -57,10 +63,7 @@ int secp256k1_pubkey_decompress(unsigned char *out_pubkey, const unsigned char *
     }
     
     size_t publen = PUBKEY_SIZE;
-    unsigned char* pub = malloc(publen);
-    secp256k1_ec_pubkey_serialize(secp256k1_ctx, pub, &publen, &pubkey, SECP256K1_EC_UNCOMPRESSED);
-    memcpy(out_pubkey, pub, publen);
-    free(pub);
+    secp256k1_ec_pubkey_serialize(secp256k1_ctx, out_pubkey, &publen, &pubkey, SECP256K1_EC_UNCOMPRESSED);
     return 1;
 }
 
@@ -229,7 +232,6 @@ unsigned int secp256k1_pubkey_get_length(const unsigned char chHeader) {
 
 int secp256k1_sign(unsigned char *output, const unsigned char *msghash32, const unsigned char *seckey) {
     size_t nSigLen = SIGNATURE_SIZE;
-    unsigned char* vchSig = malloc(nSigLen);
     secp256k1_ecdsa_signature sig;
     int ret = secp256k1_ecdsa_sign(secp256k1_ctx, &sig, msghash32, seckey, secp256k1_nonce_function_rfc6979, NULL);
     // Grind for low R
@@ -239,22 +241,21 @@ int secp256k1_sign(unsigned char *output, const unsigned char *msghash32, const
         WriteLE32(extra_entropy, ++counter);
         ret = secp256k1_ecdsa_sign(secp256k1_ctx, &sig, msghash32, seckey, secp256k1_nonce_function_rfc6979, extra_entropy);
     }
-    secp256k1_ecdsa_signature_serialize_der(secp256k1_ctx, vchSig, &nSigLen, &sig);
-    memcpy(output, vchSig, nSigLen);
-    free(vchSig);
+    secp256k1_ecdsa_signature_serialize_der(secp256k1_ctx, output, &nSigLen, &sig);
     return nSigLen;
 }
 
 int secp256k1_verify(const unsigned char *msghash32, const unsigned char *in_pubkey, const unsigned char *signature, const size_t signature_length) {
+    /* Uses the static context like secp256k1_schnorr_verify, since it also runs on crypto pool threads. */
     secp256k1_pubkey pubkey;
     secp256k1_ecdsa_signature sig;
-    if (!secp256k1_ec_pubkey_parse(secp256k1_ctx, &pubkey, in_pubkey, secp256k1_pubkey_get_length(*in_pubkey))) return 0;
+    if (!secp256k1_ec_pubkey_parse(secp256k1_context_static, &pubkey, in_pubkey, secp256k1_pubkey_get_length(*in_pubkey))) return 0;
     if (!ecdsa_signature_parse_der_lax(&sig, signature, signature_length)) return 0;
     /* libsecp256k1's ECDSA verification requires lower-S signatures, which have
         * not historically been enforced in Bitcoin, so normalize them first. */
-    secp256k1_ecdsa_signature_normalize(secp256k1_ctx, &sig, &sig);
+    secp256k1_ecdsa_signature_normalize(secp256k1_context_static, &sig, &sig);
 
-    return secp256k1_ecdsa_verify(secp256k1_ctx, &sig, msghash32, &pubkey);
+    return secp256k1_ecdsa_verify(secp256k1_context_static, &sig, msghash32, &pubkey);
 }
 
 int secp256k1_sign_compact(unsigned char *output, const unsigned char *msghash32, const unsigned char *seckey) {
@@ -279,7 +280,9 @@ int secp256k1_schnorr_sign(unsigned char *sig64, unsigned char *msg, size_t msgl
     return secp256k1_schnorrsig_sign(secp256k1_ctx, sig64, msg, msglen, pubkey, seckey);
 }
 int secp256k1_schnorr_verify(const unsigned char *sig64, const unsigned char *msg, size_t msglen, const unsigned char *pubkey) {
-  return secp256k1_schnorrsig_verify(secp256k1_ctx, sig64, msg, msglen, pubkey);
+  /* Verification needs no precomputed or randomized context, so it uses the static one: it is
+     also called from crypto pool threads while the JS thread may release secp256k1_ctx. */
+  return secp256k1_schnorrsig_verify(secp256k1_context_static, sig64, msg, msglen, pubkey);
 }
 
 void secp256k1_hash_pubkeys(unsigned char *out, const unsigned char *pubkeys, const size_t num_pubkey, size_t pubkey_size) {
@@ -310,3 +313,39 @@ int secp256k1_add_scalars(unsigned char *scalar_AB, const unsigned char *scalar_
     return secp256k1_schnorrsig_add_scalars(scalar_AB, scalar_A, scalar_B);
 }
 
+
+size_t secp256k1_multisig_session_size() {
+    return secp256k1_schnorrsig_session_size();
+}
+
+void secp256k1_multisig_session_clear(unsigned char *session) {
+    secp256k1_schnorrsig_session_clear((secp256k1_schnorrsig_session *) session);
+}
+
+int secp256k1_multisig_session_init(unsigned char *session, const unsigned char *pubkeys, size_t num_cosigners, const unsigned char *pubkey, const unsigned char *seckey) {
+    return secp256k1_schnorrsig_session_init((secp256k1_schnorrsig_session *) session, pubkeys, num_cosigners, PUBKEY_COMPRESSED_SIZE, pubkey, seckey);
+}
+
+int secp256k1_multisig_session_aggregate_pubkey(const unsigned char *session, unsigned char *aggregate_pubkey, size_t pubkey_size) {
+    return secp256k1_schnorrsig_session_aggregate_pubkey((const secp256k1_schnorrsig_session *) session, aggregate_pubkey, pubkey_size);
+}
+
+int secp256k1_multisig_session_create_commitment(unsigned char *session, unsigned char *k, unsigned char *r, size_t cmt_len, const unsigned char *randomness) {
+    return secp256k1_schnorrsig_session_create_commitment(secp256k1_ctx, (secp256k1_schnorrsig_session *) session, k, r, cmt_len, randomness);
+}
+
+int secp256k1_multisig_session_aggregate_commitments(unsigned char *session, unsigned char *aggregate_commitment, const unsigned char *commitments, const size_t num_commitments, size_t cmt_len) {
+    return secp256k1_schnorrsig_session_aggregate_commitments((secp256k1_schnorrsig_session *) session, aggregate_commitment, commitments, num_commitments, cmt_len);
+}
+
+int secp256k1_multisig_session_set_commitment(unsigned char *session, const unsigned char *k, const unsigned char *aggregate_commitment, size_t cmt_len) {
+    return secp256k1_schnorrsig_session_set_commitment((secp256k1_schnorrsig_session *) session, k, aggregate_commitment, cmt_len);
+}
+
+int secp256k1_multisig_session_partial_sign(unsigned char *session, unsigned char *partial_signature, const unsigned char *msg, size_t msglen) {
+    return secp256k1_schnorrsig_session_partial_sign((secp256k1_schnorrsig_session *) session, partial_signature, msg, msglen);
+}
+
+int secp256k1_multisig_session_combine(unsigned char *session, unsigned char *sig64, const unsigned char *partial_signatures, const size_t num_signatures) {
+    return secp256k1_schnorrsig_session_combine((secp256k1_schnorrsig_session *) session, sig64, partial_signatures, num_signatures);
+}
@@ -7,15 +7,15 @@
 #include "secp256k1/include/secp256k1_recovery.h"
 #include "secp256k1/include/schnorr_sig.h"
 #include "util.h"
-static secp256k1_context *secp256k1_ctx = NULL;
-const unsigned int PUBKEY_SIZE            = 65;
-const unsigned int PUBKEY_COMPRESSED_SIZE = 33;
-const unsigned int SIGNATURE_SIZE = 72;
+static const unsigned int PUBKEY_SIZE            = 65;
+static const unsigned int PUBKEY_COMPRESSED_SIZE = 33;
+static const unsigned int SIGNATURE_SIZE = 72;
 
 void secp256k1_ctx_init(unsigned char *randomize);
 void secp256k1_ctx_release();
 int secp256k1_seckey_verify(const unsigned char *seckey);
 void secp256k1_pubkey_create(unsigned char *output, size_t outputlen, const unsigned char *seckey);
+int secp256k1_pubkey_create_batch(unsigned char *output, size_t outputlen, const unsigned char *seckeys, size_t num_keys);
 int secp256k1_pubkey_verify(const unsigned char *pubkey);
 int secp256k1_pubkey_compress(unsigned char *out_pubkey, const unsigned char *in_pubkey);
 int secp256k1_pubkey_decompress(unsigned char *out_pubkey, const unsigned char *in_pubkey);
@@ -40,4 +40,14 @@ int secp256k1_create_commitment(unsigned char *k, unsigned char *r, size_t cmt_l
 int secp256k1_aggregate_commitments(unsigned char *aggregate_commitment, const unsigned char *commitments, const size_t num_commitments, size_t cmt_len);
 int secp256k1_add_scalars(unsigned char *scalar_AB, const unsigned char *scalar_A, const unsigned char *scalar_B);
 
+size_t secp256k1_multisig_session_size();
+void secp256k1_multisig_session_clear(unsigned char *session);
+int secp256k1_multisig_session_init(unsigned char *session, const unsigned char *pubkeys, size_t num_cosigners, const unsigned char *pubkey, const unsigned char *seckey);
+int secp256k1_multisig_session_aggregate_pubkey(const unsigned char *session, unsigned char *aggregate_pubkey, size_t pubkey_size);
+int secp256k1_multisig_session_create_commitment(unsigned char *session, unsigned char *k, unsigned char *r, size_t cmt_len, const unsigned char *randomness);
+int secp256k1_multisig_session_aggregate_commitments(unsigned char *session, unsigned char *aggregate_commitment, const unsigned char *commitments, const size_t num_commitments, size_t cmt_len);
+int secp256k1_multisig_session_set_commitment(unsigned char *session, const unsigned char *k, const unsigned char *aggregate_commitment, size_t cmt_len);
+int secp256k1_multisig_session_partial_sign(unsigned char *session, unsigned char *partial_signature, const unsigned char *msg, size_t msglen);
+int secp256k1_multisig_session_combine(unsigned char *session, unsigned char *sig64, const unsigned char *partial_signatures, const size_t num_signatures);
+
 #endif // _SECP256K1_NATIVE_H
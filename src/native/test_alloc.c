@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "secp256k1_native.h"
+
+// Checks that the secp256k1 signing and verification paths do not touch the heap
+// once the context has been created. Linked with -Wl,--wrap for the allocator
+// functions (see `make test-alloc`), so every heap allocation is counted below.
+
+static size_t allocations = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size) {
+    allocations++;
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+
+static int failures = 0;
+
+static void check(const char *name, size_t before, int ok) {
+    size_t count = allocations - before;
+    if (!ok || count != 0) {
+        printf("%-32s FAILED (%s, %zu allocations)\n", name, ok ? "ok" : "wrong result", count);
+        failures++;
+    } else {
+        printf("%-32s ok\n", name);
+    }
+}
+
+int main() {
+    unsigned char randomize[32] = {0};
+    unsigned char seckeys[2 * 32];
+    unsigned char pubkeys[2 * PUBKEY_COMPRESSED_SIZE];
+    unsigned char pubkey[PUBKEY_SIZE];
+    unsigned char compressed[PUBKEY_COMPRESSED_SIZE];
+    unsigned char msghash32[32];
+    unsigned char sig[SIGNATURE_SIZE];
+    unsigned char sig64[64];
+    unsigned char hash[32];
+    size_t before;
+    int siglen;
+
+    memset(seckeys, 0x42, 32);
+    memset(seckeys + 32, 0x24, 32);
+    memset(msghash32, 0x17, sizeof(msghash32));
+
+    secp256k1_ctx_init(randomize);
+
+    before = allocations;
+    secp256k1_pubkey_create(pubkey, PUBKEY_SIZE, seckeys);
+    check("pubkey_create", before, 1);
+
+    before = allocations;
+    check("pubkey_create_batch", before, secp256k1_pubkey_create_batch(pubkeys, PUBKEY_COMPRESSED_SIZE, seckeys, 2));
+
+    before = allocations;
+    check("pubkey_compress", before, secp256k1_pubkey_compress(compressed, pubkey)
+        && memcmp(compressed, pubkeys, PUBKEY_COMPRESSED_SIZE) == 0);
+
+    before = allocations;
+    memset(pubkey, 0, sizeof(pubkey));
+    check("pubkey_decompress", before, secp256k1_pubkey_decompress(pubkey, compressed) && pubkey[0] == 4);
+
+    before = allocations;
+    siglen = secp256k1_sign(sig, msghash32, seckeys);
+    check("sign", before, siglen > 0);
+
+    before = allocations;
+    check("verify", before, secp256k1_verify(msghash32, pubkey, sig, siglen));
+
+    before = allocations;
+    check("sign_compact", before, secp256k1_sign_compact(sig64, msghash32, seckeys));
+
+    before = allocations;
+    check("sign_compact_verify", before, secp256k1_sign_compact_verify(msghash32, pubkey, sig64));
+
+    before = allocations;
+    check("schnorr_sign", before, secp256k1_schnorr_sign(sig64, msghash32, 32, compressed, seckeys));
+    memset(seckeys, 0x42, 32);
+
+    before = allocations;
+    check("schnorr_verify", before, secp256k1_schnorr_verify(sig64, msghash32, 32, compressed));
+
+    before = allocations;
+    secp256k1_hash_pubkeys(hash, pubkeys, 2, PUBKEY_COMPRESSED_SIZE);
+    check("hash_pubkeys", before, 1);
+
+    secp256k1_ctx_release();
+
+    if (failures) {
+        printf("%d heap allocation checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <string.h>
+#include "ed25519/ed25519.h"
+
+// Checks ed25519 key derivation, signing and verification against the RFC 8032
+// test vectors (also used in Signature.spec.js), and that delinearized multisignatures
+// verify as single signatures. `make test-ed25519` runs it for both field arithmetic backends.
+
+struct test_vector {
+    const char *priv;
+    const char *pub;
+    const char *sig;
+    const char *msg;
+};
+
+static const struct test_vector vectors[] = {
+    {
+        "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+        "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+        "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b",
+        ""
+    }, {
+        "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+        "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+        "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00",
+        "72"
+    }, {
+        "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+        "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+        "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a",
+        "af82"
+    }, {
+        "833fe62409237b9d62ec77587520911e9a759cec1d19755b7da901b96dca3d42",
+        "ec172b93ad5e563bf4932c70e1245034c35467ef2efd4d64ebf819683467e2bf",
+        "dc2a4459e7369633a52b1bf277839a00201009a3efbf3ecb69bea2186c26b58909351fc9ac90b3ecfdfbc7c66431e0303dca179c138ac17ad9bef1177331a704",
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f"
+    }
+};
+
+static size_t from_hex(unsigned char *out, const char *hex) {
+    size_t len = strlen(hex) / 2;
+    for (size_t i = 0; i < len; ++i) {
+        sscanf(hex + 2 * i, "%2hhx", &out[i]);
+    }
+    return len;
+}
+
+#define MAX_SIGNERS 40
+
+static int check_multisig(size_t num_signers) {
+    unsigned char private_keys[MAX_SIGNERS * 32], public_keys[MAX_SIGNERS * 32];
+    unsigned char secrets[MAX_SIGNERS * 32], commitments[MAX_SIGNERS * 32];
+    unsigned char delinearized_keys[MAX_SIGNERS * 32];
+    unsigned char public_keys_hash[64], aggregate_public_key[32], expected_public_key[32];
+    unsigned char randomness[32], partial_signature[32], partial_signature_precomputed[32];
+    unsigned char signature[64] = {0};
+    const unsigned char message[] = "delinearized multisig";
+    ed25519_signing_key *key;
+    int failures = 0;
+
+    for (size_t i = 0; i < num_signers; ++i) {
+        memset(private_keys + i * 32, (int) (i + 1), 32);
+        ed25519_public_key_derive(public_keys + i * 32, private_keys + i * 32);
+        memset(randomness, (int) (0x80 + i), 32);
+        ed25519_create_commitment(secrets + i * 32, commitments + i * 32, randomness);
+    }
+
+    ed25519_hash_public_keys(public_keys_hash, public_keys, num_signers);
+    ed25519_aggregate_delinearized_public_keys(aggregate_public_key, public_keys_hash, public_keys, num_signers);
+
+    // The aggregate key must equal the sum of the individually delinearized keys.
+    for (size_t i = 0; i < num_signers; ++i) {
+        ed25519_delinearize_public_key(delinearized_keys + i * 32, public_keys_hash, public_keys + i * 32);
+    }
+    ed25519_aggregate_commitments(expected_public_key, delinearized_keys, num_signers);
+    if (memcmp(aggregate_public_key, expected_public_key, 32) != 0) {
+        printf("%zu signers: wrong aggregate public key\n", num_signers);
+        failures++;
+    }
+
+    ed25519_aggregate_commitments(signature, commitments, num_signers);
+    for (size_t i = 0; i < num_signers; ++i) {
+        ed25519_delinearized_partial_sign(partial_signature, message, sizeof(message), signature, secrets + i * 32,
+            public_keys, num_signers, public_keys + i * 32, private_keys + i * 32);
+        ed25519_delinearized_partial_sign_precomputed(partial_signature_precomputed, message, sizeof(message), signature,
+            secrets + i * 32, public_keys_hash, aggregate_public_key, public_keys + i * 32, private_keys + i * 32);
+        if (memcmp(partial_signature, partial_signature_precomputed, 32) != 0) {
+            printf("%zu signers: partial signatures differ\n", num_signers);
+            failures++;
+        }
+        key = ed25519_signing_key_create(private_keys + i * 32);
+        ed25519_signing_key_delinearized_partial_sign(partial_signature_precomputed, message, sizeof(message), signature,
+            secrets + i * 32, public_keys_hash, aggregate_public_key, key);
+        ed25519_signing_key_destroy(key);
+        if (memcmp(partial_signature, partial_signature_precomputed, 32) != 0) {
+            printf("%zu signers: signing key partial signature differs\n", num_signers);
+            failures++;
+        }
+        ed25519_add_scalars(signature + 32, signature + 32, partial_signature);
+    }
+
+    if (!ed25519_verify(signature, message, sizeof(message), aggregate_public_key)) {
+        printf("%zu signers: multisignature rejected\n", num_signers);
+        failures++;
+    }
+    return failures;
+}
+
+int main() {
+    unsigned char priv[32], pub[32], sig[64], msg[64];
+    unsigned char computed_pub[32], computed_sig[64];
+    ed25519_signing_key *key;
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); ++i) {
+        size_t msg_len;
+        from_hex(priv, vectors[i].priv);
+        from_hex(pub, vectors[i].pub);
+        from_hex(sig, vectors[i].sig);
+        msg_len = from_hex(msg, vectors[i].msg);
+
+        ed25519_public_key_derive(computed_pub, priv);
+        ed25519_sign(computed_sig, msg, msg_len, pub, priv);
+        if (memcmp(computed_pub, pub, 32) != 0) {
+            printf("vector %zu: wrong public key\n", i);
+            failures++;
+        }
+        if (memcmp(computed_sig, sig, 64) != 0) {
+            printf("vector %zu: wrong signature\n", i);
+            failures++;
+        }
+
+        key = ed25519_signing_key_create(priv);
+        ed25519_signing_key_public_key(computed_pub, key);
+        ed25519_signing_key_sign(computed_sig, msg, msg_len, key);
+        ed25519_signing_key_destroy(key);
+        if (memcmp(computed_pub, pub, 32) != 0 || memcmp(computed_sig, sig, 64) != 0) {
+            printf("vector %zu: wrong signing key result\n", i);
+            failures++;
+        }
+        if (!ed25519_verify(sig, msg, msg_len, pub)) {
+            printf("vector %zu: valid signature rejected\n", i);
+            failures++;
+        }
+        sig[i % 64] ^= 1;
+        if (ed25519_verify(sig, msg, msg_len, pub)) {
+            printf("vector %zu: invalid signature accepted\n", i);
+            failures++;
+        }
+    }
+
+    for (size_t n = 1; n <= MAX_SIGNERS; n += 3) {
+        failures += check_multisig(n);
+    }
+
+    if (failures) {
+        printf("%d ed25519 test vector checks failed\n", failures);
+        return 1;
+    }
+    printf("ed25519 test vectors and multisignatures ok\n");
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <stdio.h>
+#include <string.h>
+#include "secp256k1/secp256k1.c"
+
+// Differential test for secp256k1_schnorrsig_verify. Every case is checked against
+// the previous implementation below, which converted the result to affine
+// coordinates before comparing x and the parity of y. Run with `make test-schnorr-verify`.
+
+#define ITERATIONS 2000
+
+static int schnorrsig_verify_reference(const unsigned char *sig64, const unsigned char *msg, size_t msglen, const unsigned char *pubkey) {
+    secp256k1_scalar s;
+    secp256k1_scalar e;
+    secp256k1_gej rj;
+    secp256k1_ge pk;
+    secp256k1_gej pkj;
+    secp256k1_fe rx;
+    secp256k1_ge r;
+    unsigned char buf[32];
+    int overflow;
+
+    if (!secp256k1_fe_set_b32(&rx, &sig64[0])) {
+        return 0;
+    }
+    secp256k1_scalar_set_b32(&s, &sig64[32], &overflow);
+    if (overflow) {
+        return 0;
+    }
+    if (!secp256k1_eckey_pubkey_parse(&pk, pubkey, 33u)) {
+        return 0;
+    }
+    secp256k1_fe_normalize_var(&pk.x);
+    secp256k1_fe_normalize_var(&pk.y);
+    secp256k1_fe_get_b32(buf, &pk.x);
+    secp256k1_schnorrsig_challenge(&e, &sig64[0], msg, msglen, buf);
+    if (!secp256k1_fe_is_odd(&pk.y)) {
+        secp256k1_scalar_negate(&e, &e);
+    }
+    secp256k1_gej_set_ge(&pkj, &pk);
+    secp256k1_ecmult(&rj, &pkj, &e, &s);
+    secp256k1_ge_set_gej_var(&r, &rj);
+    if (secp256k1_ge_is_infinity(&r)) {
+        return 0;
+    }
+    secp256k1_fe_normalize_var(&r.y);
+    return !secp256k1_fe_is_odd(&r.y) && secp256k1_fe_equal_var(&rx, &r.x);
+}
+
+static uint64_t rng_state = 0x853c49e6748fea9bULL;
+
+static void random_bytes(unsigned char *out, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 7;
+        rng_state ^= rng_state << 17;
+        out[i] = (unsigned char) rng_state;
+    }
+}
+
+static void random_scalar(secp256k1_scalar *r) {
+    unsigned char buf[32];
+    int overflow;
+    do {
+        random_bytes(buf, sizeof(buf));
+        secp256k1_scalar_set_b32(r, buf, &overflow);
+    } while (overflow || secp256k1_scalar_is_zero(r));
+}
+
+static void point_mul_g(const secp256k1_context *ctx, secp256k1_ge *r, const secp256k1_scalar *k) {
+    secp256k1_gej rj;
+    secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &rj, k);
+    secp256k1_ge_set_gej(r, &rj);
+    secp256k1_fe_normalize_var(&r->x);
+    secp256k1_fe_normalize_var(&r->y);
+}
+
+/* Signs with an explicit nonce. If flip_r is set, the nonce is negated the wrong way
+ * round, which yields a signature whose point has the right x but an odd y. */
+static void sign_with_nonce(const secp256k1_context *ctx, unsigned char *sig64, const unsigned char *msg, size_t msglen,
+                            unsigned char *pubkey, const secp256k1_scalar *x, const secp256k1_scalar *k, int flip_r) {
+    secp256k1_ge p, r;
+    secp256k1_scalar sk = *x, nonce = *k, e;
+    size_t len = 33;
+
+    point_mul_g(ctx, &p, &sk);
+    secp256k1_eckey_pubkey_serialize(&p, pubkey, &len, 1);
+    if (secp256k1_fe_is_odd(&p.y)) {
+        secp256k1_scalar_negate(&sk, &sk);
+    }
+    point_mul_g(ctx, &r, &nonce);
+    if (secp256k1_fe_is_odd(&r.y) != flip_r) {
+        secp256k1_scalar_negate(&nonce, &nonce);
+    }
+    secp256k1_fe_get_b32(sig64, &r.x);
+    secp256k1_schnorrsig_challenge(&e, sig64, msg, msglen, &pubkey[1]);
+    secp256k1_scalar_mul(&e, &e, &sk);
+    secp256k1_scalar_add(&e, &e, &nonce);
+    secp256k1_scalar_get_b32(&sig64[32], &e);
+}
+
+static int failures = 0;
+static int accepted = 0;
+
+static void check(const secp256k1_context *ctx, const char *name, const unsigned char *sig64, const unsigned char *msg, size_t msglen, const unsigned char *pubkey) {
+    int expected = schnorrsig_verify_reference(sig64, msg, msglen, pubkey);
+    int actual = secp256k1_schnorrsig_verify(ctx, sig64, msg, msglen, pubkey);
+    accepted += actual;
+    if (expected != actual) {
+        printf("%s: expected %d, got %d\n", name, expected, actual);
+        failures++;
+    }
+}
+
+int main() {
+    unsigned char randomize[32] = {0};
+    unsigned char msg[64];
+    unsigned char pubkey[33], other_pubkey[33];
+    unsigned char sig64[64], tampered[64];
+    secp256k1_scalar x, k, other;
+    secp256k1_context *ctx = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    int cases = 0;
+
+    if (!secp256k1_context_randomize(ctx, randomize)) return 1;
+
+    for (int i = 0; i < ITERATIONS; ++i) {
+        size_t msglen = i % sizeof(msg);
+        random_bytes(msg, msglen);
+        random_scalar(&x);
+        random_scalar(&k);
+        random_scalar(&other);
+
+        sign_with_nonce(ctx, sig64, msg, msglen, pubkey, &x, &k, 0);
+        check(ctx, "valid", sig64, msg, msglen, pubkey);
+
+        sign_with_nonce(ctx, tampered, msg, msglen, pubkey, &x, &k, 1);
+        check(ctx, "odd R", tampered, msg, msglen, pubkey);
+
+        memcpy(tampered, sig64, 64);
+        tampered[i % 64] ^= 1 << (i % 8);
+        check(ctx, "flipped signature bit", tampered, msg, msglen, pubkey);
+
+        if (msglen > 0) {
+            msg[i % msglen] ^= 0x80;
+            check(ctx, "flipped message bit", sig64, msg, msglen, pubkey);
+            msg[i % msglen] ^= 0x80;
+        }
+
+        sign_with_nonce(ctx, tampered, msg, msglen, other_pubkey, &other, &k, 0);
+        check(ctx, "other key", sig64, msg, msglen, other_pubkey);
+
+        memcpy(tampered, pubkey, 33);
+        tampered[0] ^= 1;
+        check(ctx, "negated key", sig64, msg, msglen, tampered);
+
+        random_bytes(tampered, 64);
+        check(ctx, "random signature", tampered, msg, msglen, pubkey);
+
+        memcpy(tampered, sig64, 64);
+        memset(&tampered[32], 0xff, 32);
+        check(ctx, "overflowing s", tampered, msg, msglen, pubkey);
+
+        memcpy(tampered, sig64, 64);
+        memset(tampered, 0xff, 32);
+        check(ctx, "R.x >= p", tampered, msg, msglen, pubkey);
+        cases += 9;
+    }
+
+    secp256k1_context_destroy(ctx);
+
+    printf("%d cases, %d accepted, %d mismatches\n", cases, accepted, failures);
+    if (failures || accepted < ITERATIONS) {
+        return 1;
+    }
+    return 0;
+}
@@ -110,6 +110,30 @@ describe('AccountsProof', () => {
         }
     });
 
+    it('must be able to correctly return an account after an unserialized proof has been verified', () => {
+        for (const nodes of testNodesArray) {
+            const accountsProof1 = new AccountsProof(nodes);
+            const accountsProof2 = AccountsProof.unserialize(accountsProof1.serialize());
+            const address = TestUtils.raw2address(prefixesArray.shift());
+
+            expect(accountsProof2.verify()).toBe(true);
+            expect(accountsProof2.root().equals(accountsProof1.root())).toBe(true);
+            expect(accountsProof2.getAccount(address).equals(accountsArray.shift())).toBe(true);
+        }
+    });
+
+    it('is verified natively and returns the hashes of its nodes (Node.js)', () => {
+        if (!PlatformUtils.isNodeJs()) return;
+        const hashSize = Hash.getSize(Hash.Algorithm.BLAKE2B);
+        for (const nodes of testNodesArray) {
+            const hashes = new Uint8Array(nodes.length * hashSize);
+            expect(!!NodeNative.node_accounts_proof_verify(new AccountsProof(nodes).serialize(), hashes)).toBe(true);
+            nodes.forEach((node, i) => {
+                expect(new Hash(hashes.subarray(i * hashSize, (i + 1) * hashSize)).equals(node.hash())).toBe(true);
+            });
+        }
+    });
+
     it('must not verify successfully neither return an account if it contains a tainted AccountTreeNode', () => {
         for (const nodes of testNodesArray) {
             const node = nodes[0]; // get the first node
@@ -40,4 +40,41 @@ describe('AccountsTreeChunk', () => {
             expect(chunk2.verify()).toBeTruthy();
         })().then(done, done.fail);
     });
+
+    it('does not verify with a modified proof', (done) => {
+        (async () => {
+            const accountsTree = await AccountsTree.createVolatile();
+            await accountsTree.put(Address.unserialize(BufferUtils.fromBase64(Dummy.address1)), new BasicAccount(1));
+            await accountsTree.put(Address.unserialize(BufferUtils.fromBase64(Dummy.address2)), new BasicAccount(2));
+            await accountsTree.put(Address.unserialize(BufferUtils.fromBase64(Dummy.address3)), new BasicAccount(3));
+
+            const serialized = (await accountsTree.getChunk('', 100)).serialize();
+            expect(AccountsTreeChunk.unserialize(new SerialBuffer(serialized)).verify()).toBeTruthy();
+
+            // The chunk ends with the hash of the last child of the root node.
+            serialized[serialized.length - 1] ^= 1;
+            expect(AccountsTreeChunk.unserialize(new SerialBuffer(serialized)).verify()).toBeFalsy();
+        })().then(done, done.fail);
+    });
+
+    it('is verified natively and returns the hashes of its proof (Node.js)', (done) => {
+        if (!PlatformUtils.isNodeJs()) {
+            done();
+            return;
+        }
+        (async () => {
+            const accountsTree = await AccountsTree.createVolatile();
+            await accountsTree.put(Address.unserialize(BufferUtils.fromBase64(Dummy.address1)), new BasicAccount(1));
+            await accountsTree.put(Address.unserialize(BufferUtils.fromBase64(Dummy.address2)), new BasicAccount(2));
+            await accountsTree.put(Address.unserialize(BufferUtils.fromBase64(Dummy.address3)), new BasicAccount(3));
+
+            const chunk = await accountsTree.getChunk('', 100);
+            const hashSize = Hash.getSize(Hash.Algorithm.BLAKE2B);
+            const hashes = new Uint8Array(chunk.proof.length * hashSize);
+            expect(!!NodeNative.node_accounts_tree_chunk_verify(chunk.serialize(), hashes)).toBe(true);
+            chunk.proof.nodes.forEach((node, i) => {
+                expect(new Hash(hashes.subarray(i * hashSize, (i + 1) * hashSize)).equals(node.hash())).toBe(true);
+            });
+        })().then(done, done.fail);
+    });
 });
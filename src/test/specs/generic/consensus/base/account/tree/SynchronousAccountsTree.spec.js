@@ -913,5 +913,54 @@ describe('SynchronousAccountsTree', () => {
                 tree.abort();
             })().then(done, done.fail);
         });
+
+        it(`computes the same root hash as the asynchronous AccountsTree (${  treeBuilder.type  })`, (done) => {
+            (async function () {
+                const batched = await treeBuilder.builder();
+                const single = await treeBuilder.builder();
+                // AccountsTree.put is the plain JavaScript implementation on every platform.
+                const reference = await AccountsTree.createVolatile();
+
+                const addresses = [];
+                for (let i = 0; i < 200; i++) {
+                    addresses.push(Address.fromHash(Hash.blake2b(new Uint8Array([i]))));
+                }
+                // Addresses sharing ever longer prefixes with the first one split its branch at every nibble.
+                for (let i = 0; i < Address.SERIALIZED_SIZE * 2; i++) {
+                    const raw = addresses[0].serialize();
+                    raw[i >> 1] ^= i % 2 === 0 ? 0x10 : 0x01;
+                    addresses.push(new Address(raw));
+                }
+
+                for (let round = 0; round < 3; round++) {
+                    for (let i = 0; i < addresses.length; i++) {
+                        // Remove every fifth account after the first round, some are put again in the next round.
+                        const account = round > 0 && (i + round) % 5 === 0 ? Account.INITIAL : new BasicAccount(round * 1000 + i + 1);
+                        batched.putBatch(addresses[i], account);
+                        single.putSync(addresses[i], account);
+                        await reference.put(addresses[i], account);
+                    }
+                    batched.finalizeBatch();
+
+                    const root = await reference.root();
+                    expect(batched.rootSync().equals(root)).toBe(true);
+                    expect(single.rootSync().equals(root)).toBe(true);
+                    for (let i = 0; i < addresses.length; i++) {
+                        const expected = await reference.get(addresses[i]);
+                        for (const tree of [batched, single]) {
+                            const actual = tree.getSync(addresses[i], false);
+                            if (expected) {
+                                expect(expected.equals(actual)).toBe(true);
+                            } else {
+                                expect(actual).toBeNull();
+                            }
+                        }
+                    }
+                }
+
+                batched.abort();
+                single.abort();
+            })().then(done, done.fail);
+        });
     });
 });
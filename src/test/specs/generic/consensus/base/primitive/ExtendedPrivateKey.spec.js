@@ -103,4 +103,15 @@ describe('ExtendedPrivateKey', () => {
             }
         }
     });
+
+    it('derives the same addresses in a batch as one by one', () => {
+        const masterKey = ExtendedPrivateKey.generateMasterKey(BufferUtils.fromHex('000102030405060708090a0b0c0d0e0f'));
+        const accountKey = masterKey.derivePath('m/44\'/242\'/0\'');
+        const count = PublicKey.DERIVE_BATCH_SIZE + 3;
+        const addresses = accountKey.deriveAddresses(5, count);
+        expect(addresses.length).toBe(count);
+        for (const i of [0, 1, PublicKey.DERIVE_BATCH_SIZE - 1, PublicKey.DERIVE_BATCH_SIZE, count - 1]) {
+            expect(addresses[i].equals(accountKey.derive(5 + i).toAddress())).toBe(true);
+        }
+    });
 });
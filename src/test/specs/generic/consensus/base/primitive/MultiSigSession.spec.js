@@ -0,0 +1,82 @@
+describe('MultiSigSession', () => {
+
+    it('creates the same partial signatures as PartialSignature.create', (done) => {
+        (async function () {
+            const message = BufferUtils.fromAscii('to be authenticated');
+            const keyPairs = [KeyPair.generate(), KeyPair.generate(), KeyPair.generate()];
+            const pubKeys = keyPairs.map(keyPair => keyPair.publicKey);
+            const sessions = keyPairs.map(keyPair => new MultiSigSession(keyPair.privateKey, keyPair.publicKey, pubKeys));
+
+            expect(sessions[0].aggregatePublicKey.equals(PublicKey._delinearizeAndAggregatePublicKeys(pubKeys))).toBe(true);
+
+            const pairs = sessions.map(() => CommitmentPair.generate());
+            const aggCommitment = Commitment.sum(pairs.map(pair => pair.commitment));
+            const partialSignatures = [];
+            for (let i = 0; i < sessions.length; ++i) {
+                sessions[i].setCommitment(pairs[i].secret, aggCommitment);
+                const partialSignature = sessions[i].partiallySign(message);
+                const expected = PartialSignature.create(keyPairs[i].privateKey, pubKeys[i], pubKeys, pairs[i].secret, aggCommitment, message);
+                expect(partialSignature.equals(expected)).toBe(true);
+                partialSignatures.push(partialSignature);
+            }
+
+            const signature = sessions[0].combine(partialSignatures);
+            expect(signature.equals(Signature.fromPartialSignatures(aggCommitment, partialSignatures))).toBe(true);
+            expect(signature.verify(sessions[0].aggregatePublicKey, message)).toBe(true);
+            sessions.forEach(session => session.destroy());
+        })().then(done, done.fail);
+    });
+
+    it('can sign several messages with fresh commitments', (done) => {
+        (async function () {
+            const keyPairs = [KeyPair.generate(), KeyPair.generate()];
+            const pubKeys = keyPairs.map(keyPair => keyPair.publicKey);
+            const sessions = keyPairs.map(keyPair => new MultiSigSession(keyPair.privateKey, keyPair.publicKey, pubKeys));
+
+            for (let round = 0; round < 3; ++round) {
+                const message = BufferUtils.fromAscii(`message ${round}`);
+                const commitments = sessions.map(session => session.createCommitment());
+                const partialSignatures = sessions.map(session => {
+                    session.aggregateCommitments(commitments);
+                    return session.partiallySign(message);
+                });
+                const signature = sessions[1].combine(partialSignatures);
+                expect(signature.verify(sessions[1].aggregatePublicKey, message)).toBe(true);
+            }
+            sessions.forEach(session => session.destroy());
+        })().then(done, done.fail);
+    });
+
+    it('refuses to reuse a commitment', (done) => {
+        (async function () {
+            const keyPair = KeyPair.generate();
+            const session = new MultiSigSession(keyPair.privateKey, keyPair.publicKey, [keyPair.publicKey]);
+            const commitment = session.createCommitment();
+            session.aggregateCommitments([commitment]);
+            session.partiallySign(BufferUtils.fromAscii('first'));
+            expect(() => session.partiallySign(BufferUtils.fromAscii('second'))).toThrow();
+
+            session.destroy();
+            expect(() => session.createCommitment()).toThrow();
+        })().then(done, done.fail);
+    });
+
+    it('keeps the session in a native handle that checks buffer sizes (Node.js)', () => {
+        if (!PlatformUtils.isNodeJs()) return;
+        const keyPair = KeyPair.generate();
+        const session = new MultiSigSession(keyPair.privateKey, keyPair.publicKey, [keyPair.publicKey]);
+        expect(session._session instanceof Uint8Array).toBe(false);
+
+        const handle = session._session;
+        expect(() => handle.partialSign(new Uint8Array(32), new Uint8Array(4))).toThrowError(RangeError);
+        expect(() => handle.createCommitment(new Uint8Array(Commitment.SIZE), new Uint8Array(16))).toThrowError(RangeError);
+        expect(() => handle.aggregateCommitments(new Uint8Array(Commitment.SIZE), new Uint8Array(Commitment.SIZE), 2)).toThrowError(RangeError);
+        expect(() => handle.setCommitment(new Uint8Array(16), new Uint8Array(Commitment.SIZE))).toThrowError(RangeError);
+        expect(() => handle.combine(new Uint8Array(Signature.SIZE), new Uint8Array(PartialSignature.SIZE), 2)).toThrowError(RangeError);
+        const compressed = keyPair.publicKey.compress();
+        expect(() => new NodeNative.Secp256k1MultiSigSession(compressed, 2, compressed, keyPair.privateKey.serialize())).toThrowError(RangeError);
+
+        session.destroy();
+        expect(() => handle.aggregatePublicKey(new Uint8Array(PublicKey.SIZE))).toThrow();
+    });
+});
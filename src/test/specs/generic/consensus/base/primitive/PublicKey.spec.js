@@ -41,6 +41,17 @@ describe('PublicKey', () => {
         })().then(done, done.fail);
     });
 
+    it('correctly derives public keys in a batch', (done) => {
+        (async function () {
+            for (const testCase of Dummy.partialSignatureTestVectors) {
+                const pubKeys = PublicKey._publicKeysDeriveBatch(testCase.privKeys);
+                for (let i = 0; i < testCase.pubKeys.length; ++i) {
+                    expect(BufferUtils.equals(pubKeys.subarray(i * PublicKey.SIZE, (i + 1) * PublicKey.SIZE), testCase.pubKeys[i])).toBe(true);
+                }
+            }
+        })().then(done, done.fail);
+    });
+
     it('correctly computes public keys hash', (done) => {
         (async function () {
             for (const testCase of Dummy.partialSignatureTestVectors) {
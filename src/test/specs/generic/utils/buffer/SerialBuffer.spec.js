@@ -89,6 +89,24 @@ describe('SerialBuffer', () => {
 
     });
     
+    it('can writeUint128 and readUint128 around 2^53', () => {
+        const value1 = new BigNumber(2).pow(53).minus(1);
+        const value2 = new BigNumber(2).pow(53);
+        const value3 = new BigNumber(2).pow(53).plus(1);
+
+        const buffer = new SerialBuffer(48);
+        buffer.writeUint128(value1);
+        buffer.writeUint128(value2);
+        buffer.writeUint128(value3);
+
+        expect(BufferUtils.toHex(buffer)).toEqual('0000000000000000001fffffffffffff'
+            + '00000000000000000020000000000000'
+            + '00000000000000000020000000000001');
+        expect(buffer.readUint128().eq(value1)).toBe(true);
+        expect(buffer.readUint128().eq(value2)).toBe(true);
+        expect(buffer.readUint128().eq(value3)).toBe(true);
+    });
+
     it('can writeVarUint and readVarUint', () => {
         const value1 = Number.MAX_SAFE_INTEGER;
         const value2 = 42;
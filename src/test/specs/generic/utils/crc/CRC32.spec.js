@@ -14,4 +14,14 @@ describe('CRC32', () => {
         expect(CRC32.compute(new Uint8Array([84, 104, 101, 32, 113, 117, 105, 99, 107, 32, 98, 114, 111, 119, 110, 32, 102, 111, 120, 32, 106, 117, 109, 112, 115, 32, 111, 118, 101, 114, 32, 116, 104, 101, 32, 108, 97, 122, 121, 32, 100, 111, 103]))).toBe(parseInt('414fa339', 16));
     });
 
+    it('should calculate correct CRC values for long inputs and views', ()  => {
+        const buf = new Uint8Array(5000);
+        for (let i = 0; i < buf.length; ++i) buf[i] = (i * 31 + 7) & 0xFF;
+
+        for (const length of [63, 64, 65, 127, 128, 1000, 4093]) {
+            const view = buf.subarray(3, 3 + length);
+            expect(CRC32.compute(view)).toBe(CRC32._computeJs(new Uint8Array(view)));
+        }
+    });
+
 });
@@ -0,0 +1,58 @@
+describe('CryptoJobList', () => {
+    const data = BufferUtils.fromAscii('Krypton job list test data');
+
+    function createInput() {
+        const keyPair = KeyPair.generate();
+        const signature = Signature.create(keyPair.privateKey, keyPair.publicKey, data);
+        const publicKey = keyPair.publicKey.compress();
+
+        const input = new Uint8Array(data.length + Signature.SIZE + publicKey.length);
+        input.set(data, 0);
+        input.set(signature.serialize(), data.length);
+        input.set(publicKey, data.length + Signature.SIZE);
+        return input;
+    }
+
+    function addJobs(list) {
+        return {
+            blake2b: list.hash(Hash.Algorithm.BLAKE2B, 0, data.length),
+            sha256: list.hash(Hash.Algorithm.SHA256, 0, data.length),
+            sha512: list.hash(Hash.Algorithm.SHA512, 0, 5),
+            valid: list.verifySchnorr(0, data.length, data.length, data.length + Signature.SIZE),
+            invalid: list.verifySchnorr(0, data.length - 1, data.length, data.length + Signature.SIZE)
+        };
+    }
+
+    function checkResults(list, jobs) {
+        expect(list.getHash(jobs.blake2b).equals(Hash.blake2b(data))).toBe(true);
+        expect(list.getHash(jobs.sha256).equals(Hash.sha256(data))).toBe(true);
+        expect(list.getHash(jobs.sha512).equals(Hash.sha512(data.subarray(0, 5)))).toBe(true);
+        expect(list.isValid(jobs.valid)).toBe(true);
+        expect(list.isValid(jobs.invalid)).toBe(false);
+        expect(list.allValid()).toBe(false);
+    }
+
+    it('runs hash and verification jobs', () => {
+        const list = new CryptoJobList(createInput(), 2);
+        const jobs = addJobs(list);
+        expect(list.length).toBe(5);
+        list.run();
+        checkResults(list, jobs);
+    });
+
+    it('executes jobs asynchronously', (done) => {
+        (async () => {
+            const list = new CryptoJobList(createInput());
+            const jobs = addJobs(list);
+            await list.execute();
+            checkResults(list, jobs);
+        })().then(done, done.fail);
+    });
+
+    it('cannot add jobs after running', () => {
+        const list = new CryptoJobList(createInput());
+        list.hash(Hash.Algorithm.SHA256, 0, 4);
+        list.run();
+        expect(() => list.hash(Hash.Algorithm.SHA256, 0, 4)).toThrow();
+    });
+});
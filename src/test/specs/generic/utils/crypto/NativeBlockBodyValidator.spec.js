@@ -0,0 +1,112 @@
+describe('NativeBlockBodyValidator', () => {
+    if (!PlatformUtils.isNodeJs()) return;
+
+    const minerAddress = Address.unserialize(BufferUtils.fromBase64(Dummy.address1));
+    let users, orderedTxs;
+
+    beforeAll(() => {
+        users = TestBlockchain.getUsers(3);
+        const tx1 = TestBlockchain.createTransaction(users[0].publicKey, users[1].address, 2000, 1, users[0].privateKey);
+        const tx2 = TestBlockchain.createTransaction(users[1].publicKey, users[2].address, 1000, 1, users[1].privateKey);
+        const tx3 = TestBlockchain.createTransaction(users[2].publicKey, users[0].address, 3000, 2, users[2].privateKey);
+        orderedTxs = [tx1, tx2, tx3].sort((a, b) => a.compareBlockOrder(b));
+    });
+
+    it('computes the transaction and body hashes', (done) => {
+        (async () => {
+            const expected = new BlockBody(minerAddress, orderedTxs, BufferUtils.fromAscii('Random'));
+            const body = BlockBody.unserialize(expected.serialize());
+            expect(await NativeBlockBodyValidator.prevalidate(body)).toBe(true);
+            expect(body._hash.equals(expected.hash())).toBe(true);
+            for (let i = 0; i < orderedTxs.length; i++) {
+                expect(body.transactions[i]._hash.equals(orderedTxs[i].hash())).toBe(true);
+            }
+            expect(body.verify()).toBe(true);
+        })().then(done, done.fail);
+    });
+
+    it('rejects invalid signatures', (done) => {
+        (async () => {
+            const signature = Signature.create(users[0].privateKey, users[0].publicKey, BufferUtils.fromAscii('other'));
+            const tx = TestBlockchain.createTransaction(users[0].publicKey, users[1].address, 2000, 1, undefined, signature);
+            const body = new BlockBody(minerAddress, [tx]);
+            expect(await NativeBlockBodyValidator.prevalidate(body)).toBe(false);
+        })().then(done, done.fail);
+    });
+
+    it('rejects out-of-order and duplicate transactions', (done) => {
+        (async () => {
+            const unordered = new BlockBody(minerAddress, [orderedTxs[1], orderedTxs[0], orderedTxs[2]]);
+            expect(await NativeBlockBodyValidator.prevalidate(unordered)).toBe(false);
+            const duplicate = new BlockBody(minerAddress, [orderedTxs[0], orderedTxs[1], orderedTxs[1], orderedTxs[2]]);
+            expect(await NativeBlockBodyValidator.prevalidate(duplicate)).toBe(false);
+        })().then(done, done.fail);
+    });
+
+    it('verifies extended transactions and forgets the result when the proof changes', (done) => {
+        (async () => {
+            const tx = new ExtendedTransaction(users[0].address, Account.Type.BASIC, users[1].address, Account.Type.BASIC,
+                1000, 1, Transaction.Flag.NONE, BufferUtils.fromAscii('Extended data'));
+            const signature = Signature.create(users[0].privateKey, users[0].publicKey, tx.serializeContent());
+            tx.proof = SignatureProof.singleSig(users[0].publicKey, signature).serialize();
+            const body = new BlockBody(minerAddress, [tx]);
+            expect(await NativeBlockBodyValidator.prevalidate(body)).toBe(true);
+            expect(tx._signatureProofValid).toBe(true);
+            expect(body.verify()).toBe(true);
+
+            const other = Signature.create(users[1].privateKey, users[1].publicKey, tx.serializeContent());
+            tx.proof = SignatureProof.singleSig(users[1].publicKey, other).serialize();
+            expect(tx._signatureProofValid).toBe(false);
+            expect(SignatureProof.verifyTransaction(tx)).toBe(false);
+            expect(await NativeBlockBodyValidator.prevalidate(new BlockBody(minerAddress, [tx]))).toBe(false);
+        })().then(done, done.fail);
+    });
+
+    it('verifies multisig proofs with a merkle path', (done) => {
+        (async () => {
+            const publicKeys = users.map((user) => user.publicKey);
+            const sender = Address.fromHash(MerkleTree.computeRoot(publicKeys));
+            const tx = new ExtendedTransaction(sender, Account.Type.BASIC, users[0].address, Account.Type.BASIC,
+                1000, 1, Transaction.Flag.NONE, new Uint8Array(0));
+            const signature = Signature.create(users[1].privateKey, users[1].publicKey, tx.serializeContent());
+            tx.proof = SignatureProof.multiSig(users[1].publicKey, publicKeys, signature).serialize();
+            expect(await NativeBlockBodyValidator.prevalidate(new BlockBody(minerAddress, [tx]))).toBe(true);
+            expect(tx._signatureProofValid).toBe(true);
+
+            // Signed by a key that is not part of the multisig address.
+            const outsider = TestBlockchain.getUsers(4)[3];
+            const forged = Signature.create(outsider.privateKey, outsider.publicKey, tx.serializeContent());
+            tx.proof = SignatureProof.multiSig(outsider.publicKey, [outsider.publicKey, ...publicKeys.slice(1)], forged).serialize();
+            expect(await NativeBlockBodyValidator.prevalidate(new BlockBody(minerAddress, [tx]))).toBe(false);
+        })().then(done, done.fail);
+    });
+
+    it('leaves the body hash to JS if there are pruned accounts', (done) => {
+        (async () => {
+            const prunedAccounts = [new PrunedAccount(Address.fromBase64(Dummy.address1), new VestingContract(0, Address.fromBase64(Dummy.address2)))];
+            const expected = new BlockBody(minerAddress, orderedTxs, new Uint8Array(0), prunedAccounts);
+            const body = BlockBody.unserialize(expected.serialize());
+            expect(await NativeBlockBodyValidator.prevalidate(body)).toBe(true);
+            expect(body._hash).toBeFalsy();
+            for (let i = 0; i < orderedTxs.length; i++) {
+                expect(body.transactions[i]._hash.equals(orderedTxs[i].hash())).toBe(true);
+            }
+            expect(body.hash().equals(expected.hash())).toBe(true);
+        })().then(done, done.fail);
+    });
+
+    it('hashes transactions with the derived fee if the serialized one is not canonical', (done) => {
+        (async () => {
+            const expected = new BlockBody(minerAddress, [orderedTxs[0]]);
+            const serialized = expected.serialize();
+            // Miner address, extra data length, transaction count, then format, sender, recipient and value.
+            const feeOffset = Address.SERIALIZED_SIZE + 1 + 2 + 1 + PublicKey.SIZE + Address.SERIALIZED_SIZE + 16;
+            serialized[feeOffset + 15] ^= 1;
+            const body = BlockBody.unserialize(serialized);
+            expect(BufferUtils.equals(body._serialized, expected.serialize())).toBe(false);
+            expect(await NativeBlockBodyValidator.prevalidate(body)).toBe(true);
+            expect(body.transactions[0]._hash.equals(orderedTxs[0].hash())).toBe(true);
+            expect(body._hash.equals(expected.hash())).toBe(true);
+        })().then(done, done.fail);
+    });
+});
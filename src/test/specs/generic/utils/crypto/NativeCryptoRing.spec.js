@@ -0,0 +1,68 @@
+describe('NativeCryptoRing', () => {
+    if (!PlatformUtils.isNodeJs()) return;
+
+    it('verifies signatures and hashes through the ring', (done) => {
+        (async () => {
+            const keyPair = KeyPair.generate();
+            const publicKey = keyPair.publicKey.compress();
+            const data = BufferUtils.fromAscii('Krypton crypto ring test');
+            const signature = Signature.create(keyPair.privateKey, keyPair.publicKey, data).serialize();
+
+            // Few slots and little data space, so that most requests have to wait in the backlog.
+            const ring = new NativeCryptoRing(4, 512);
+            try {
+                const verifications = [];
+                const hashes = [];
+                for (let i = 0; i < 50; ++i) {
+                    verifications.push(ring.verifySchnorr(signature, i % 5 === 0 ? data.subarray(1) : data, publicKey));
+                    hashes.push(ring.hash(Hash.Algorithm.SHA256, data.subarray(0, i % data.length)));
+                }
+                expect(ring.pending).toBe(100);
+
+                const valid = await Promise.all(verifications);
+                for (let i = 0; i < valid.length; ++i) {
+                    expect(valid[i]).toBe(i % 5 !== 0);
+                }
+                const digests = await Promise.all(hashes);
+                for (let i = 0; i < digests.length; ++i) {
+                    expect(BufferUtils.equals(digests[i], Hash.computeSha256(data.subarray(0, i % data.length)))).toBe(true);
+                }
+                expect(ring.pending).toBe(0);
+            } finally {
+                ring.close();
+            }
+        })().then(done, done.fail);
+    });
+
+    it('settles all requests when it is closed while busy', (done) => {
+        (async () => {
+            const input = new Uint8Array(4096);
+            const digest = Hash.computeSha512(input);
+            const ring = new NativeCryptoRing(4, 64 * 1024);
+            const requests = [];
+            // Only the first four requests get a slot, the others wait in the backlog.
+            for (let i = 0; i < 20; ++i) {
+                requests.push(ring.hash(Hash.Algorithm.SHA512, input).then((result) => result, (e) => e));
+            }
+            ring.close();
+            expect(ring.pending).toBe(0);
+            // A completion the consumer delivers after close() must not touch the settled requests.
+            ring._onComplete();
+
+            const results = await Promise.all(requests);
+            for (let i = 0; i < results.length; ++i) {
+                if (i < 4 && !(results[i] instanceof Error)) {
+                    expect(BufferUtils.equals(results[i], digest)).toBe(true);
+                } else {
+                    expect(results[i].message).toBe('Crypto ring closed');
+                }
+            }
+        })().then(done, done.fail);
+    });
+
+    it('rejects requests after it was closed', (done) => {
+        const ring = new NativeCryptoRing();
+        ring.close();
+        ring.hash(Hash.Algorithm.SHA256, new Uint8Array(4)).then(done.fail, done);
+    });
+});